@@ -0,0 +1,139 @@
+// ============================================================
+// 정확 일치 통계 (순수 로직, 고정 메모리, 샘플당 O(1))
+// ------------------------------------------------------------
+// 게시된 퍼센트 열에서 "원하는 값을 얼마나 정확히 잡는가" 를 센다.
+//  - 값별 샘플 수 (히스토그램, -100..100)
+//  - 값별 진입 횟수(hits) / 체류 시간 합 / 최장 체류
+//    체류 = 값이 바뀌거나 신호가 끊길 때까지. 시간은 샘플 타임스탬프 기준
+//  - 전이: 유효 → 유효 값 변화 횟수 + 변화 폭 분포 (1, 2, 3, 4, 5~9, 10+)
+//  - 안착 시간: 안착(한 값에 settleMs 이상 머묾) 상태에서 벗어난 순간부터
+//    다음 안착 값에 마지막으로 들어온 순간까지. 2의 거듭제곱 ms 구간 분포
+//    + 값별 안착 횟수
+// 신호 끊김(무효 샘플)은 진행 중인 체류를 닫고 안착 추적을 초기화한다.
+// 약 4.9kB (값별 24B × 201 + 분포). 타임스탬프는 uint32 µs (순환 안전, 샘플 간격 < 35분).
+// ============================================================
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+class AccuracyStats {
+public:
+  static const int16_t MIN_VALUE = -100;
+  static const int16_t MAX_VALUE = 100;
+  static const size_t VALUES = 201;
+  static const size_t STEP_BUCKETS = 6;     // |Δ| = 1, 2, 3, 4, 5~9, 10+
+  static const size_t SETTLE_BUCKETS = 12;  // < 16ms, < 32ms, … < 16384ms, 그 이상
+
+  explicit AccuracyStats(uint32_t settleMs = 250) : settleUs_(settleMs * 1000){ reset(); }
+
+  void reset(){
+    for (size_t i = 0; i < VALUES; ++i){
+      count_[i] = hits_[i] = maxDwellMs_[i] = settles_[i] = 0;
+      dwellUs_[i] = 0;
+    }
+    for (size_t i = 0; i < STEP_BUCKETS; ++i) stepHist_[i] = 0;
+    for (size_t i = 0; i < SETTLE_BUCKETS; ++i) settleHist_[i] = 0;
+    samples_ = invalid_ = transitions_ = 0;
+    inRun_ = false;
+    runSettled_ = false;
+    moving_ = false;
+  }
+
+  // 게시 샘플 하나 (valid 가 false 면 percent 무시)
+  void observe(int16_t percent, bool valid, uint32_t tUs){
+    samples_++;
+    if (!valid || percent < MIN_VALUE || percent > MAX_VALUE){
+      invalid_++;
+      if (inRun_) closeRun(tUs);
+      inRun_ = false;
+      moving_ = false;
+      return;
+    }
+
+    const size_t idx = (size_t)(percent - MIN_VALUE);
+    count_[idx]++;
+
+    if (inRun_ && percent == value_){
+      // 같은 값 유지: 안착 판정만
+      if (!runSettled_ && tUs - runStartUs_ >= settleUs_) settle();
+      return;
+    }
+
+    if (inRun_){
+      closeRun(tUs);
+      transitions_++;
+      const int32_t d = percent > value_ ? percent - value_ : value_ - percent;
+      stepHist_[d >= 10 ? 5 : d >= 5 ? 4 : d - 1]++;
+    }
+    inRun_ = true;
+    runSettled_ = false;
+    value_ = percent;
+    runStartUs_ = tUs;
+    hits_[idx]++;
+  }
+
+  // ---- 조회 ----
+  uint32_t samples() const { return samples_; }
+  uint32_t invalid() const { return invalid_; }
+  uint32_t transitions() const { return transitions_; }
+
+  uint32_t count(int16_t v) const { return inRange(v) ? count_[v - MIN_VALUE] : 0; }
+  uint32_t hits(int16_t v) const { return inRange(v) ? hits_[v - MIN_VALUE] : 0; }
+  uint32_t settles(int16_t v) const { return inRange(v) ? settles_[v - MIN_VALUE] : 0; }
+  uint32_t maxDwellMs(int16_t v) const { return inRange(v) ? maxDwellMs_[v - MIN_VALUE] : 0; }
+  // 닫힌 체류만 (진행 중인 것은 값이 바뀔 때 더해진다)
+  uint64_t dwellMs(int16_t v) const { return inRange(v) ? dwellUs_[v - MIN_VALUE] / 1000 : 0; }
+
+  uint32_t stepHist(size_t i) const { return i < STEP_BUCKETS ? stepHist_[i] : 0; }
+  uint32_t settleHist(size_t i) const { return i < SETTLE_BUCKETS ? settleHist_[i] : 0; }
+  // settleHist(i) 의 상한 [ms] (마지막 구간은 그 이상 전부)
+  static uint32_t settleBucketLimitMs(size_t i){ return 16u << i; }
+
+  bool current(int16_t& v) const { v = value_; return inRun_; }
+
+  static bool inRange(int16_t v){ return v >= MIN_VALUE && v <= MAX_VALUE; }
+
+private:
+  void closeRun(uint32_t tUs){
+    const size_t idx = (size_t)(value_ - MIN_VALUE);
+    const uint32_t us = tUs - runStartUs_;
+    dwellUs_[idx] += us;
+    if (us / 1000 > maxDwellMs_[idx]) maxDwellMs_[idx] = us / 1000;
+    if (runSettled_){
+      // 안착 값에서 벗어남 → 다음 안착까지 시간을 잰다
+      moving_ = true;
+      moveStartUs_ = tUs;
+    }
+  }
+
+  void settle(){
+    runSettled_ = true;
+    settles_[value_ - MIN_VALUE]++;
+    if (!moving_) return;
+    moving_ = false;
+    const uint32_t ms = (runStartUs_ - moveStartUs_) / 1000;
+    size_t b = 0;
+    while (b + 1 < SETTLE_BUCKETS && ms >= settleBucketLimitMs(b)) b++;
+    settleHist_[b]++;
+  }
+
+  uint32_t settleUs_;
+
+  uint32_t count_[VALUES];
+  uint32_t hits_[VALUES];
+  uint64_t dwellUs_[VALUES];
+  uint32_t maxDwellMs_[VALUES];
+  uint32_t settles_[VALUES];
+  uint32_t stepHist_[STEP_BUCKETS];
+  uint32_t settleHist_[SETTLE_BUCKETS];
+
+  uint32_t samples_, invalid_, transitions_;
+
+  bool inRun_ = false;
+  bool runSettled_ = false;
+  bool moving_ = false;
+  int16_t value_ = 0;
+  uint32_t runStartUs_ = 0;
+  uint32_t moveStartUs_ = 0;
+};
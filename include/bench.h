@@ -0,0 +1,71 @@
+// ============================================================
+// 마이크로 벤치마크 하니스
+// ------------------------------------------------------------
+// 타깃: DWT 사이클 카운터 [cycles], 호스트: steady_clock [ns]
+// 측정: opsPerRound 회 묶음을 rounds 번 → 1회당 최소 / 중앙값 / 최대
+//  - 최소값이 가장 재현성 좋음 (인터럽트 / 선점 잡음 제외)
+//  - "baseline"(빈 함수) 항목을 같이 돌려 루프 비용을 빼서 볼 것
+// 출력: Serial 로 JSON 한 줄씩 (설정 1줄 + 결과 n줄 + 종료 1줄)
+// ============================================================
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct BenchResult {
+  const char* name;
+  uint32_t opsPerRound;
+  uint32_t rounds;
+  float minPerOp;
+  float medianPerOp;
+  float maxPerOp;
+};
+
+// 빌드 설정 기록용 (결과 비교 시 같은 설정끼리)
+struct BenchParam {
+  const char* key;
+  long value;
+};
+
+void benchBegin();
+uint32_t benchNow();               // 32비트 순환, 한 묶음은 순환 주기보다 짧게
+const char* benchUnit();
+
+void benchConfig(const BenchParam* params, size_t n);
+void benchReport(const BenchResult& r);
+void benchFinish();                // 호스트: 프로세스 종료, 타깃: 출력만
+
+// 결과를 여기로 흘려 최적화 제거를 막는다
+extern volatile uint32_t gBenchSink;
+
+template <typename T>
+inline void benchKeep(T v){ gBenchSink = gBenchSink + (uint32_t)v; }
+
+static const uint32_t BENCH_MAX_ROUNDS = 64;
+
+template <typename Fn>
+BenchResult benchRun(const char* name, uint32_t opsPerRound, uint32_t rounds, Fn fn){
+  if (rounds > BENCH_MAX_ROUNDS) rounds = BENCH_MAX_ROUNDS;
+  if (!rounds) rounds = 1;
+  if (!opsPerRound) opsPerRound = 1;
+
+  float perOp[BENCH_MAX_ROUNDS];
+  for (uint32_t r = 0; r < rounds; ++r){
+    const uint32_t t0 = benchNow();
+    for (uint32_t i = 0; i < opsPerRound; ++i) fn(i);
+    const uint32_t dt = benchNow() - t0;
+    perOp[r] = (float)dt / (float)opsPerRound;
+  }
+
+  // 삽입 정렬 (rounds ≤ 64)
+  for (uint32_t i = 1; i < rounds; ++i){
+    const float v = perOp[i];
+    uint32_t j = i;
+    while (j > 0 && perOp[j - 1] > v){ perOp[j] = perOp[j - 1]; j--; }
+    perOp[j] = v;
+  }
+
+  BenchResult res = { name, opsPerRound, rounds, perOp[0], perOp[rounds / 2], perOp[rounds - 1] };
+  benchReport(res);
+  return res;
+}
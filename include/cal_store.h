@@ -0,0 +1,71 @@
+// ============================================================
+// 보정값 영구 저장 정책
+// ------------------------------------------------------------
+// 플래시 수명을 위해 다음을 모두 만족할 때만 저장한다.
+//  - 마지막 저장값과 MinDeltaUs 이상 차이
+//  - 값이 SettleMs 동안 변하지 않음 (스틱 스윕 도중에는 안 씀)
+//  - 마지막 쓰기 후 IntervalMs 경과
+//  - 부팅당 최대 MaxWrites 회
+// ============================================================
+#pragma once
+
+#include <stdint.h>
+
+struct CalRecord {
+  uint16_t magic;
+  uint16_t version;
+  uint16_t minUs;
+  uint16_t maxUs;
+
+  static const uint16_t MAGIC = 0xCA1B;
+  static const uint16_t VERSION = 1;
+
+  bool valid() const {
+    return magic == MAGIC && version == VERSION && minUs < maxUs;
+  }
+};
+
+template <uint16_t MinDeltaUs = 2, uint32_t SettleMs = 5000,
+          uint32_t IntervalMs = 60000, uint16_t MaxWrites = 32>
+class CalSaver {
+public:
+  // 부팅 시 불러온 값 (없으면 호출 안 함)
+  void loaded(uint16_t minUs, uint16_t maxUs){
+    savedMin_ = minUs; savedMax_ = maxUs; haveSaved_ = true;
+  }
+
+  // 주기적으로 호출. 지금 저장해야 하면 true (저장 성공 시 committed 호출)
+  bool poll(uint16_t minUs, uint16_t maxUs, uint32_t nowMs){
+    if (minUs >= maxUs) return false;
+
+    if (minUs != lastMin_ || maxUs != lastMax_){
+      lastMin_ = minUs; lastMax_ = maxUs;
+      changedMs_ = nowMs;
+      return false;
+    }
+    if (nowMs - changedMs_ < SettleMs) return false;
+    if (writes_ >= MaxWrites) return false;
+    if (writes_ && nowMs - writtenMs_ < IntervalMs) return false;
+    if (haveSaved_ && absDiff(minUs, savedMin_) < MinDeltaUs &&
+                      absDiff(maxUs, savedMax_) < MinDeltaUs) return false;
+    return true;
+  }
+
+  void committed(uint16_t minUs, uint16_t maxUs, uint32_t nowMs){
+    savedMin_ = minUs; savedMax_ = maxUs; haveSaved_ = true;
+    writtenMs_ = nowMs;
+    writes_++;
+  }
+
+  uint16_t writes() const { return writes_; }
+
+private:
+  static uint16_t absDiff(uint16_t a, uint16_t b){ return a > b ? a - b : b - a; }
+
+  uint16_t lastMin_ = 0, lastMax_ = 0;
+  uint32_t changedMs_ = 0;
+  uint16_t savedMin_ = 0, savedMax_ = 0;
+  bool haveSaved_ = false;
+  uint32_t writtenMs_ = 0;
+  uint16_t writes_ = 0;
+};
@@ -0,0 +1,125 @@
+// ============================================================
+// 컴파일 타임 필터 파이프라인
+// ------------------------------------------------------------
+// 예) Pipeline<Median<5>, Ema<Q15(0.1)>>
+//  - 각 단계는 uint16_t push(uint16_t) / void reset() 만 가지면 된다
+//  - 상속/가상 함수 없음 → 전부 인라인, 런타임 오버헤드 0
+//  - 출력 0 은 "아직 값 없음" (다음 단계로 그대로 전달)
+// ============================================================
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "pulse_filter.h"
+#include "sliding_median.h"
+
+// 0.0~1.0 → Q15 정수 (템플릿 인자용)
+constexpr uint16_t Q15(double x){
+  return (uint16_t)(x * 32768.0 + 0.5);
+}
+
+// ------------------------------------------------------------
+// 파이프라인: 앞 단계 출력을 다음 단계 입력으로
+// ------------------------------------------------------------
+template <typename... Stages> class Pipeline;
+
+template <>
+class Pipeline<> {
+public:
+  uint16_t push(uint16_t v){ return v; }
+  void reset(){}
+};
+
+template <typename Head, typename... Tail>
+class Pipeline<Head, Tail...> {
+public:
+  uint16_t push(uint16_t v){ return tail_.push(head_.push(v)); }
+  void reset(){ head_.reset(); tail_.reset(); }
+
+  Head& head(){ return head_; }
+  Pipeline<Tail...>& tail(){ return tail_; }
+
+private:
+  Head head_;
+  Pipeline<Tail...> tail_;
+};
+
+// ------------------------------------------------------------
+// Median<N>: 최근 N 샘플의 중앙값 (인덱스 이중 힙, O(log N))
+// ------------------------------------------------------------
+template <size_t N>
+using Median = SlidingMedian<N>;
+
+// ------------------------------------------------------------
+// Ema<AlphaQ15>: 지수 이동 평균. 내부 상태는 Q16 (µs 이하 보존)
+// ------------------------------------------------------------
+template <uint16_t AlphaQ15>
+class Ema {
+  static_assert(AlphaQ15 > 0 && AlphaQ15 <= 32768, "Ema alpha must be in (0, 1]");
+
+public:
+  uint16_t push(uint16_t v){
+    if (!v) return value();
+    const int32_t x = (int32_t)v << 16;
+    if (!primed_){
+      y_ = x;
+      primed_ = true;
+    } else {
+      y_ += (int32_t)(((int64_t)(x - y_) * AlphaQ15) >> 15);
+    }
+    return value();
+  }
+
+  uint16_t value() const {
+    return primed_ ? (uint16_t)((y_ + 0x8000) >> 16) : 0;
+  }
+
+  void reset(){ primed_ = false; y_ = 0; }
+
+private:
+  int32_t y_ = 0;
+  bool primed_ = false;
+};
+
+// ------------------------------------------------------------
+// OneEuro: 1€ 필터 (Casiez 2012). 속도가 빠르면 컷오프를 올려 지연을 줄인다.
+//  MinCutoffMilliHz : 최소 컷오프 [mHz]
+//  BetaMicro        : 속도 계수 x1e-6 [1/µs]
+//  RateHz           : 샘플(프레임) 주기 [Hz]
+// Cortex-M7 FPU 가 있으므로 float 사용
+// ------------------------------------------------------------
+template <uint32_t MinCutoffMilliHz = 1000, uint32_t BetaMicro = 5000,
+          uint32_t RateHz = 50, uint32_t DCutoffMilliHz = 1000>
+class OneEuro {
+public:
+  uint16_t push(uint16_t v){
+    if (!v) return value();
+    const float x = (float)v;
+    if (!primed_){
+      x_ = x; dx_ = 0.0f; primed_ = true;
+      return value();
+    }
+    const float dx = (x - x_) * (float)RateHz;
+    dx_ += alpha(DCutoffMilliHz * 1e-3f) * (dx - dx_);
+    const float cutoff = MinCutoffMilliHz * 1e-3f + BetaMicro * 1e-6f * (dx_ < 0 ? -dx_ : dx_);
+    x_ += alpha(cutoff) * (x - x_);
+    return value();
+  }
+
+  uint16_t value() const {
+    return primed_ ? (uint16_t)(x_ + 0.5f) : 0;
+  }
+
+  void reset(){ primed_ = false; }
+
+private:
+  static float alpha(float cutoffHz){
+    const float tau = 1.0f / (6.2831853f * cutoffHz);
+    const float te = 1.0f / (float)RateHz;
+    return 1.0f / (1.0f + tau / te);
+  }
+
+  float x_ = 0.0f;
+  float dx_ = 0.0f;
+  bool primed_ = false;
+};
@@ -0,0 +1,30 @@
+// ============================================================
+// 하드웨어 추상화 계층 (HAL)
+// ------------------------------------------------------------
+// main.cpp 가 쓰는 보드 기능은 이 헤더 하나로 들어온다.
+//  - 타깃(ARDUINO): Arduino 코어 + mbed OS 그대로
+//  - 호스트(env:native): hal_native.h 가 같은 이름의 부분집합을 제공
+//    (가상 시계, std::thread, 핀 주입, 표준 출력 Serial)
+// 범위: 시간, GPIO/핀 인터럽트, 임계 구역, 스레드/이벤트/뮤텍스,
+//       Ticker, Serial (비차단 쓰기 포함), 워치독
+// ============================================================
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#include "mbed.h"
+#include "rtos.h"
+#else
+#include "hal_native.h"
+#endif
+
+// 워치독 (호스트에선 아무 것도 안 함)
+void halWatchdogBegin(uint32_t timeoutMs);
+void halWatchdogKick();
+
+// USB CDC 비차단 쓰기: 지금 바로 보낼 수 있는 만큼만 보내고 즉시 반환.
+// 반환 = 보낸 바이트 (0 = 미연결 / 호스트가 못 받는 중 → 나중에 재시도)
+size_t halSerialWriteSome(const uint8_t* buf, size_t len);
@@ -0,0 +1,207 @@
+// ============================================================
+// 호스트 HAL (env:native)
+// ------------------------------------------------------------
+// Arduino / mbed OS 중 main.cpp 가 쓰는 부분만 같은 이름으로 흉내낸다.
+//  - 시계: 기본은 실시간(steady_clock). halClockManual(true) 이면
+//    halClockAdvanceUs 로만 흐르는 가상 시계 → 결정적 테스트
+//  - 인터럽트: 전역 재귀 락 하나. ISR(핀 주입, Ticker)은 이 락을 잡고 실행,
+//    임계 구역 / noInterrupts 도 같은 락 → 타깃과 같은 배타 관계
+//  - 스레드: std::thread, 대기는 모두 가상 시계 기준
+// 직접 include 하지 말고 hal.h 를 쓸 것.
+// ============================================================
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// ------------------------------------------------------------
+// 시간 / 핀 / 인터럽트 (Arduino API 부분집합)
+// ------------------------------------------------------------
+
+typedef uint8_t pin_size_t;
+
+enum : uint8_t { LOW = 0, HIGH = 1 };
+enum : uint8_t { INPUT = 0, OUTPUT = 1, INPUT_PULLUP = 2 };
+enum : uint8_t { CHANGE = 1, FALLING = 2, RISING = 3 };
+
+enum : pin_size_t {
+  D0, D1, D2, D3, D4, D5, D6, D7, D8, D9, D10, D11, D12, D13, D14,
+  LEDR, LEDG, LEDB,
+  HAL_PIN_COUNT
+};
+
+#ifndef IRAM_ATTR
+#define IRAM_ATTR
+#endif
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+void pinMode(pin_size_t pin, uint8_t mode);
+int digitalRead(pin_size_t pin);
+void digitalWrite(pin_size_t pin, uint8_t level);
+void attachInterrupt(pin_size_t pin, void (*isr)(), uint8_t mode);
+void detachInterrupt(pin_size_t pin);
+
+void noInterrupts();
+void interrupts();
+void core_util_critical_section_enter();
+void core_util_critical_section_exit();
+
+// 스케치 진입점 (src/main.cpp)
+void setup();
+void loop();
+
+// ------------------------------------------------------------
+// Serial → 표준 출력 / 입력은 주입 큐
+// ------------------------------------------------------------
+
+class HalSerial {
+public:
+  void begin(unsigned long){}
+  explicit operator bool() const { return true; }
+
+  size_t print(const char* s);
+  size_t print(char c);
+  size_t print(int v);
+  size_t print(unsigned int v);
+  size_t print(long v);
+  size_t print(unsigned long v);
+  size_t print(double v, int digits = 2);
+
+  // 입력: halSerialInject 로 넣은 바이트 + (env:native main 이면) 표준 입력
+  int available();
+  int read();
+
+  template <typename T>
+  size_t println(T v){ const size_t n = print(v); return n + print("\n"); }
+  size_t println(){ return print("\n"); }
+};
+
+extern HalSerial Serial;
+
+// Serial 입력으로 바이트 주입 (셸 시험용)
+void halSerialInject(const char* data, size_t len);
+
+// halSerialWriteSome 출력을 표준 출력 대신 fn 으로 (셸 시험용, nullptr 이면 원래대로).
+// 호출 한 번 = 한 덩어리 (로그 한 줄 / 셸 응답 하나 / 텔레메트리 묶음)
+void halSerialTap(std::function<void(const uint8_t*, size_t)> fn);
+
+// ------------------------------------------------------------
+// mbed OS 부분집합
+// ------------------------------------------------------------
+
+// CMSIS-RTOS2 우선순위 (쓰는 것만)
+enum osPriority {
+  osPriorityLow = 8,
+  osPriorityBelowNormal = 16,
+  osPriorityNormal = 24,
+  osPriorityAboveNormal = 32,
+};
+
+namespace rtos {
+
+namespace Kernel {
+struct Clock {
+  typedef std::chrono::duration<uint32_t, std::milli> duration_u32;
+};
+constexpr Clock::duration_u32 wait_for_u32_forever{ 0xFFFFFFFFu };
+} // namespace Kernel
+
+class EventFlags {
+public:
+  uint32_t set(uint32_t flags);
+  uint32_t clear(uint32_t flags = 0x7FFFFFFFu);
+  uint32_t get() const;
+  uint32_t wait_any_for(uint32_t flags, Kernel::Clock::duration_u32 rel, bool clear = true);
+  uint32_t wait_any(uint32_t flags, bool clear = true){
+    return wait_any_for(flags, Kernel::wait_for_u32_forever, clear);
+  }
+
+private:
+  uint32_t flags_ = 0;
+};
+
+// 재귀 뮤텍스. 대기도 가상 시계 대기와 같은 경로 → halSettle 이 "뮤텍스 대기" 를 안다
+class Mutex {
+public:
+  void lock();
+  void unlock();
+  bool trylock();
+
+private:
+  std::thread::id owner_;
+  uint32_t depth_ = 0;
+};
+
+class Thread {
+public:
+  // 우선순위는 호스트 스케줄러에 맡긴다 (타깃과 같은 생성자 모양만)
+  explicit Thread(osPriority priority = osPriorityNormal){ (void)priority; }
+
+  template <typename F>
+  int start(F fn){
+    spawn(std::function<void()>(fn));
+    return 0;
+  }
+
+private:
+  static void spawn(std::function<void()> fn);
+};
+
+namespace ThisThread {
+void sleep_for(Kernel::Clock::duration_u32 rel);
+template <typename Rep, typename Period>
+void sleep_for(std::chrono::duration<Rep, Period> d){
+  sleep_for(std::chrono::duration_cast<Kernel::Clock::duration_u32>(d));
+}
+void yield();
+} // namespace ThisThread
+
+} // namespace rtos
+
+namespace mbed {
+
+// 주기 콜백. 모든 Ticker 는 "타이머 인터럽트" 스레드 하나가 처리
+class Ticker {
+public:
+  ~Ticker(){ detach(); }
+  void attach(std::function<void()> fn, std::chrono::microseconds period);
+  void detach();
+
+  // 내부용 (hal.cpp)
+  std::function<void()> fn_;
+  uint64_t periodUs_ = 0;
+  uint64_t nextUs_ = 0;
+  bool active_ = false;
+};
+
+} // namespace mbed
+
+// ------------------------------------------------------------
+// 호스트 전용 제어 (테스트 / 시뮬레이터)
+// ------------------------------------------------------------
+
+// true = 가상 시계 (halClockAdvanceUs 로만 진행), false = 실시간
+void halClockManual(bool manual);
+
+// 가상 시계 진행 (가상 시계 모드에서만). 도중에 만기되는 Ticker 와 태스크 대기를 각자 시각에
+// 순서대로 깨우고, 깨운 스레드가 다시 대기할 때까지 기다린 뒤 반환 (이산 사건 진행)
+void halClockAdvanceUs(uint64_t us);
+
+// 태스크 / Ticker 스레드가 모두 다음 사건(시각 / 플래그 / 뮤텍스)을 기다릴 때까지 대기.
+// 핀 주입 뒤 파이프라인이 다 돌았는지 확인할 때. 실시간 timeoutMs 안에 안 되면 false
+bool halSettle(uint32_t timeoutMs = 2000);
+
+// 64비트 현재 시각 [µs] (micros 는 32비트로 접힘)
+uint64_t halClockNowUs();
+
+// 외부에서 핀 레벨을 구동 (RC 수신기 역할). 에지가 맞으면 등록된 ISR 실행
+void halPinDrive(pin_size_t pin, uint8_t level);
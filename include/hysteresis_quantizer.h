@@ -0,0 +1,64 @@
+// ============================================================
+// 히스테리시스 양자화기 (매핑 → 게시 사이)
+// ------------------------------------------------------------
+// 평균 펄스가 구간 경계에 걸려 퍼센트가 이웃 값 사이를 오가는 것을 막는다.
+// 현재 값의 구간 [k·W, (k+1)·W) (단위: µs·201) 밖으로
+// 히스테리시스 폭(구간의 hQ8/256)만큼 더 나가야 새 값을 받아들인다.
+// 보정값이 없으면(W < 201) 그대로 통과.
+// ============================================================
+#pragma once
+
+#include <stdint.h>
+
+class HysteresisQuantizer {
+public:
+  static const int16_t NONE = 0x7FFF;
+
+  // 구간 폭 대비 히스테리시스 [Q8], 0 = 끔, 최대 128 (반 구간)
+  explicit HysteresisQuantizer(uint8_t hystQ8 = 0){ setHysteresis(hystQ8); }
+
+  void setHysteresis(uint8_t hystQ8){
+    hystQ8_ = hystQ8 > 128 ? 128 : hystQ8;
+  }
+
+  // us: 평균 펄스, candidate: LUT 결과, calMin/calMax: LUT 가 쓴 보정값
+  int16_t update(uint16_t us, int16_t candidate, uint16_t calMin, uint16_t calMax){
+    if (current_ == NONE || candidate == current_){
+      return accept(candidate);
+    }
+
+    const int32_t w = (int32_t)calMax - (int32_t)calMin + 1;
+    if (calMax < calMin || w < 201 || !hystQ8_) return accept(candidate);
+
+    const int32_t pos = ((int32_t)us - (int32_t)calMin) * 201;
+    const int32_t k = current_ + 100;
+    const int32_t margin = (w * hystQ8_) >> 8;
+
+    const bool leave = (candidate > current_) ? pos >= (k + 1) * w + margin
+                                              : pos <  k * w - margin;
+    if (!leave){
+      suppressed_++;
+      return current_;
+    }
+    return accept(candidate);
+  }
+
+  // 신호 끊김 등으로 기준을 버릴 때
+  void reset(){ current_ = NONE; }
+
+  int16_t current() const { return current_; }
+  uint32_t transitions() const { return transitions_; }
+  uint32_t suppressed() const { return suppressed_; }
+
+private:
+  int16_t accept(int16_t v){
+    if (current_ != NONE && v != current_) transitions_++;
+    current_ = v;
+    return v;
+  }
+
+  uint8_t hystQ8_ = 0;
+  int16_t current_ = NONE;
+  uint32_t transitions_ = 0;
+  uint32_t suppressed_ = 0;
+};
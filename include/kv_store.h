@@ -0,0 +1,19 @@
+// ============================================================
+// 키-값 저장소 (보정값 등 영구 저장)
+// ------------------------------------------------------------
+// 타깃: 내장 플래시 뱅크2 끝 2섹터에 TDBStore (로그 구조, 웨어 레벨링)
+// 호스트: KV_STORE_DIR 아래 키별 파일
+// 쓰기는 섹터 소거로 수 초까지 걸릴 수 있으므로 입력 / LED 태스크(osPriorityNormal)보다
+// 낮은 우선순위 태스크에서만 호출 (taskLogger, taskLogDrain).
+// ============================================================
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+bool kvInit();
+
+// 저장된 값 크기가 size 와 정확히 같을 때만 true
+bool kvGet(const char* key, void* buf, size_t size);
+
+bool kvSet(const char* key, const void* buf, size_t size);
@@ -0,0 +1,198 @@
+// ============================================================
+// LED 애니메이션 엔진 (순수 로직)
+// ------------------------------------------------------------
+// AnimSequence: (색, 유지 시간) 단계 목록. 예) "빨강 3번 빠르게, 쉬고, 초록 1번 길게"
+//   seq.flash(RED, 80, 80, 3).pause(400).hold(GREEN, 600);
+// LedAnimator: 트랙 여러 개를 해시 타이밍 휠 하나로 진행.
+//  - 단계 전환 = 휠 타이머 1개 → 트랙 수와 무관하게 틱당 O(1)
+//  - 다음 단계는 직전 만기 틱 기준으로 예약 → 누적 드리프트 없음
+//  - 출력은 활성 트랙 중 번호가 가장 큰 것 (뒤 트랙이 위에 덮임)
+// 시각은 호출자가 넘기는 ms → 호스트에선 가상 시계로 그대로 검증 가능.
+// 틱은 경과 시간으로 누적 → millis() 가 32비트 순환해도 계속 진행.
+// ============================================================
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "led_color.h"
+#include "timing_wheel.h"
+
+struct AnimStep {
+  Rgb color;
+  uint16_t ms;
+};
+
+template <size_t MaxSteps>
+struct AnimSequence {
+  static_assert(MaxSteps >= 1 && MaxSteps <= 255, "AnimSequence steps");
+
+  AnimStep steps[MaxSteps] = {};
+  uint8_t count = 0;
+  bool repeat = true;        // false = 마지막 단계 뒤 트랙 종료
+  bool truncated = false;    // 단계가 넘쳐 잘렸음
+
+  AnimSequence& clear(){
+    count = 0;
+    repeat = true;
+    truncated = false;
+    return *this;
+  }
+
+  // 같은 색이 이어지면 한 단계로 합친다 (끔 + 휴지 등)
+  AnimSequence& hold(Rgb c, uint16_t ms){
+    if (!ms) return *this;
+    if (count && steps[count - 1].color == c){
+      const uint32_t sum = (uint32_t)steps[count - 1].ms + ms;
+      steps[count - 1].ms = (uint16_t)(sum > 0xFFFF ? 0xFFFF : sum);
+    } else if (count < MaxSteps){
+      steps[count++] = AnimStep{ c, ms };
+    } else {
+      truncated = true;
+    }
+    return *this;
+  }
+
+  AnimSequence& pause(uint16_t ms){ return hold(Rgb{ 0, 0, 0 }, ms); }
+
+  AnimSequence& flash(Rgb c, uint16_t onMs, uint16_t offMs, uint8_t times = 1){
+    for (uint8_t i = 0; i < times; ++i) hold(c, onMs).pause(offMs);
+    return *this;
+  }
+
+  AnimSequence& once(){ repeat = false; return *this; }
+};
+
+template <size_t Tracks, size_t MaxSteps, size_t WheelSlots = 64>
+class LedAnimator {
+  static_assert(Tracks >= 1, "LedAnimator tracks");
+
+public:
+  typedef AnimSequence<MaxSteps> Sequence;
+  typedef void (*Output)(Rgb);
+
+  LedAnimator(uint16_t tickMs, Output out) : tickMs_(tickMs ? tickMs : 1), out_(out) {}
+
+  // 트랙에 시퀀스 적재 후 첫 단계부터 재생 (빈 시퀀스 = 정지)
+  void play(size_t track, const Sequence& seq, uint32_t nowMs){
+    if (track >= Tracks) return;
+    sync(nowMs);
+    cancel(track);
+    Track& t = tracks_[track];
+    t.seq = seq;
+    if (!t.seq.count){
+      refresh();
+      return;
+    }
+    enter(track, 0);
+  }
+
+  void stop(size_t track){
+    if (track >= Tracks) return;
+    cancel(track);
+    refresh();
+  }
+
+  // 주기 호출 (Ticker ISR 또는 가상 시계). 밀린 틱은 한꺼번에 따라잡는다
+  void tick(uint32_t nowMs){ wheel_.advance(tickAt(nowMs)); }
+
+  bool active(size_t track) const { return track < Tracks && tracks_[track].active; }
+
+  bool idle() const {
+    for (size_t i = 0; i < Tracks; ++i) if (tracks_[i].active) return false;
+    return true;
+  }
+
+  Rgb color() const { return shown_; }
+  uint8_t step(size_t track) const { return track < Tracks ? tracks_[track].step : 0; }
+  uint16_t tickMs() const { return tickMs_; }
+
+private:
+  struct Track {
+    Sequence seq;
+    uint8_t step = 0;
+    bool active = false;
+    typename TimingWheel<WheelSlots, Tracks>::Handle timer = TimingWheel<WheelSlots, Tracks>::INVALID;
+  };
+
+  // 휠이 비어 있으면 현재 시각으로 점프 (긴 휴지 뒤 따라잡기 루프 방지)
+  void sync(uint32_t nowMs){
+    const uint32_t nowTick = tickAt(nowMs);
+    if (!wheel_.active()) wheel_.reset(nowTick);
+    else wheel_.advance(nowTick);
+  }
+
+  // ms → 휠 틱. nowMs / tickMs_ 는 millis() 순환(49.7일)에서 0 으로 되돌아가 휠이 멈추므로
+  // 직전 호출 이후 경과 ms 만 누적 (나머지는 다음으로 이월). 과거 시각은 무시
+  uint32_t tickAt(uint32_t nowMs){
+    if (!clockPrimed_){
+      clockPrimed_ = true;
+      lastMs_ = nowMs;
+      tick_ = nowMs / tickMs_;
+      carryMs_ = nowMs % tickMs_;
+    } else if ((int32_t)(nowMs - lastMs_) > 0){
+      const uint32_t elapsed = (nowMs - lastMs_) + carryMs_;
+      lastMs_ = nowMs;
+      tick_ += elapsed / tickMs_;
+      carryMs_ = elapsed % tickMs_;
+    }
+    return tick_;
+  }
+
+  void cancel(size_t track){
+    Track& t = tracks_[track];
+    wheel_.cancel(t.timer);
+    t.timer = TimingWheel<WheelSlots, Tracks>::INVALID;
+    t.active = false;
+  }
+
+  void enter(size_t track, uint8_t step){
+    Track& t = tracks_[track];
+    t.step = step;
+    t.active = true;
+    const uint32_t ticks = ((uint32_t)t.seq.steps[step].ms + tickMs_ / 2) / tickMs_;
+    t.timer = wheel_.schedule(ticks ? ticks : 1, &LedAnimator::onExpire, this, (uint32_t)track);
+    refresh();
+  }
+
+  static void onExpire(void* ctx, uint32_t track){
+    LedAnimator* self = static_cast<LedAnimator*>(ctx);
+    Track& t = self->tracks_[track];
+    t.timer = TimingWheel<WheelSlots, Tracks>::INVALID;
+    uint8_t next = (uint8_t)(t.step + 1);
+    if (next >= t.seq.count){
+      if (!t.seq.repeat){
+        t.active = false;
+        self->refresh();
+        return;
+      }
+      next = 0;
+    }
+    self->enter(track, next);
+  }
+
+  void refresh(){
+    Rgb c = { 0, 0, 0 };
+    for (size_t i = Tracks; i-- > 0; ){
+      if (tracks_[i].active){
+        c = tracks_[i].seq.steps[tracks_[i].step].color;
+        break;
+      }
+    }
+    if (c != shown_ || !primed_){
+      shown_ = c;
+      primed_ = true;
+      if (out_) out_(c);
+    }
+  }
+
+  Track tracks_[Tracks];
+  TimingWheel<WheelSlots, Tracks> wheel_;
+  uint16_t tickMs_;
+  bool clockPrimed_ = false;
+  uint32_t lastMs_ = 0;
+  uint32_t tick_ = 0;
+  uint32_t carryMs_ = 0;
+  Output out_;
+  Rgb shown_ = { 0, 0, 0 };
+  bool primed_ = false;
+};
@@ -0,0 +1,75 @@
+// ============================================================
+// LED 색 / 감마 (순수 로직)
+// ------------------------------------------------------------
+// Rgb: 8비트 선형 밝기 (사람 눈 기준). 출력 듀티는 감마 LUT 로 변환.
+// GammaTable<Bits, GammaTenths>: 컴파일 타임 생성 (C++14 constexpr)
+//   duty(i) = round((2^Bits - 1) * (i/255)^(GammaTenths/10))
+// ============================================================
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct Rgb {
+  uint8_t r, g, b;
+
+  constexpr bool operator==(const Rgb& o) const { return r == o.r && g == o.g && b == o.b; }
+  constexpr bool operator!=(const Rgb& o) const { return !(*this == o); }
+};
+
+namespace led_color {
+
+// x^(1/10), 0 <= x <= 1 (뉴턴 반복)
+constexpr double root10(double x){
+  if (x <= 0.0) return 0.0;
+  double r = 1.0;
+  for (int i = 0; i < 60; ++i){
+    double r9 = 1.0;
+    for (int k = 0; k < 9; ++k) r9 *= r;
+    r -= (r9 * r - x) / (10.0 * r9);
+  }
+  return r;
+}
+
+// x^(tenths/10)
+constexpr double powTenths(double x, uint32_t tenths){
+  double y = 1.0;
+  for (uint32_t i = 0; i < tenths / 10; ++i) y *= x;
+  const double r = root10(x);
+  for (uint32_t i = 0; i < tenths % 10; ++i) y *= r;
+  return y;
+}
+
+} // namespace led_color
+
+template <uint8_t Bits, uint32_t GammaTenths = 22>
+struct GammaTable {
+  static_assert(Bits >= 8 && Bits <= 16, "GammaTable bits");
+  static const uint32_t MAX = (1u << Bits) - 1;
+
+  uint16_t duty[256];
+
+  constexpr GammaTable() : duty(){
+    for (int i = 0; i < 256; ++i){
+      duty[i] = (uint16_t)(MAX * led_color::powTenths(i / 255.0, GammaTenths) + 0.5);
+    }
+  }
+
+  constexpr uint16_t operator[](uint8_t i) const { return duty[i]; }
+};
+
+// h: 0~359, s/v: 0~255
+constexpr Rgb hsvToRgb(uint16_t h, uint8_t s, uint8_t v){
+  h %= 360;
+  const uint8_t region = (uint8_t)(h / 60);
+  const uint16_t rem = (uint16_t)((h % 60) * 255 / 60);
+  const uint8_t p = (uint8_t)((v * (255 - s)) / 255);
+  const uint8_t q = (uint8_t)((v * (255 - (s * rem) / 255)) / 255);
+  const uint8_t t = (uint8_t)((v * (255 - (s * (255 - rem)) / 255)) / 255);
+  return region == 0 ? Rgb{ v, t, p } :
+         region == 1 ? Rgb{ q, v, p } :
+         region == 2 ? Rgb{ p, v, t } :
+         region == 3 ? Rgb{ p, q, v } :
+         region == 4 ? Rgb{ t, p, v } :
+                       Rgb{ v, p, q };
+}
@@ -0,0 +1,37 @@
+// ============================================================
+// RGB LED PWM 드라이버 (Portenta H7)
+// ------------------------------------------------------------
+// 내장 LED 핀(PK5/PK6/PK7)은 타이머 채널에 연결되어 있지 않으므로
+// TIM7 업데이트 이벤트가 DMA 로 GPIOK->BSRR 에 슬롯 워드를 써서 PWM 을 만든다.
+//  - 10비트(1024 슬롯) x 200Hz, 설정 후 밝기 유지에 CPU 사용 0
+//  - 버퍼는 전이 지점(슬롯 0 = 켜기, 슬롯 duty = 끄기)만 값이 있고
+//    나머지는 0(BSRR 무동작) → 색 변경은 워드 몇 개만 고치는 O(1)
+//  - 시작 실패 시 디지털 on/off 로 대체
+//  - 호스트(env:native)에서는 색만 기억 (ledCurrentRgb)
+// ============================================================
+#pragma once
+
+#include <stdint.h>
+#include "led_color.h"
+
+#ifndef LED_PWM_BITS
+#define LED_PWM_BITS 10
+#endif
+
+#ifndef LED_PWM_HZ
+#define LED_PWM_HZ 200
+#endif
+
+bool ledPwmBegin();
+
+// 감마 보정 후 출력 (태스크 컨텍스트 / 인터럽트 모두 가능)
+void ledSetRgb(Rgb c);
+
+static inline void ledSetHsv(uint16_t h, uint8_t s, uint8_t v){
+  ledSetRgb(hsvToRgb(h, s, v));
+}
+
+bool ledPwmActive();
+
+// 마지막으로 출력한 색 (감마 전). 호스트 테스트가 LED 상태 확인에 사용
+Rgb ledCurrentRgb();
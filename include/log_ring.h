@@ -0,0 +1,90 @@
+// ============================================================
+// 락 없는 다중 생산자 / 단일 소비자 로그 링 (지연 포맷)
+// ------------------------------------------------------------
+// 생산자는 포맷 번호 + 정수 인자만 복사한다 (문자열 포맷 / Serial 없음).
+// 포맷과 전송은 저우선 소비자 태스크가 나중에.
+//  - 태스크 / ISR 어디서든 push 가능, 상수 시간 (기다리지 않음)
+//  - 슬롯마다 순번(seq): 생산자는 head 를 CAS 로 예약 → 기록 → seq 로 게시
+//    (경쟁은 CAS 재시도뿐. 단일 코어에서 ISR 은 많아야 한 번 재시도)
+//  - 가득 차면 새 항목을 버리고 drops 증가 (기존 항목 보존)
+//  - 예약 후 게시 전에 선점된 생산자가 있으면 소비자는 그 슬롯에서 잠시 멈춘다
+//    (순서 보존. 생산자는 영향 없음)
+// N 은 2의 거듭제곱.
+// ============================================================
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+static const size_t LOG_MAX_ARGS = 6;
+
+struct LogRecord {
+  uint32_t tMs;                   // 기록 시각 (millis)
+  uint16_t id;                    // 포맷 번호
+  uint16_t argc;
+  int32_t args[LOG_MAX_ARGS];
+};
+
+template <size_t N>
+class LogRing {
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "LogRing size must be a power of two");
+
+public:
+  LogRing(){
+    for (size_t i = 0; i < N; ++i) cells_[i].seq.store((uint32_t)i, std::memory_order_relaxed);
+  }
+
+  // 생산자 (여럿, ISR 포함)
+  bool push(uint16_t id, uint32_t tMs, const int32_t* args, size_t argc){
+    uint32_t pos = head_.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true){
+      cell = &cells_[pos & (N - 1)];
+      const int32_t diff = (int32_t)(cell->seq.load(std::memory_order_acquire) - pos);
+      if (diff == 0){
+        if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+      } else if (diff < 0){
+        // 한 바퀴 전 항목이 아직 안 빠짐 → 가득 참
+        drops_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      } else {
+        pos = head_.load(std::memory_order_relaxed);
+      }
+    }
+
+    if (argc > LOG_MAX_ARGS) argc = LOG_MAX_ARGS;
+    cell->rec.tMs = tMs;
+    cell->rec.id = id;
+    cell->rec.argc = (uint16_t)argc;
+    for (size_t i = 0; i < argc; ++i) cell->rec.args[i] = args[i];
+    cell->seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // 소비자 전용
+  bool pop(LogRecord& out){
+    Cell& cell = cells_[tail_ & (N - 1)];
+    if (cell.seq.load(std::memory_order_acquire) != tail_ + 1) return false;
+    out = cell.rec;
+    cell.seq.store(tail_ + N, std::memory_order_release);
+    tail_++;
+    return true;
+  }
+
+  static constexpr size_t capacity(){ return N; }
+
+  // 가득 차서 버린 항목 수 (누적)
+  uint32_t drops() const { return drops_.load(std::memory_order_relaxed); }
+
+private:
+  struct Cell {
+    std::atomic<uint32_t> seq;
+    LogRecord rec;
+  };
+
+  Cell cells_[N];
+  std::atomic<uint32_t> head_{0};
+  uint32_t tail_ = 0;
+  std::atomic<uint32_t> drops_{0};
+};
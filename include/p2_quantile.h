@@ -0,0 +1,98 @@
+// ============================================================
+// P² 스트리밍 분위수 추정 (Jain & Chlamtac 1985)
+// ------------------------------------------------------------
+// 마커 5개(최소, p/2, p, (1+p)/2, 최대)의 높이와 위치만 유지.
+//  - 메모리 고정, 샘플당 O(1) (비교 몇 번 + 포물선 보간 최대 3회)
+//  - agingWindow > 0 이면 유효 샘플 수를 그 값으로 묶어 두어
+//    오래된 샘플의 비중이 지수적으로 줄고, 양 끝 극값도 서서히 안쪽으로 수렴
+// ============================================================
+#pragma once
+
+#include <stdint.h>
+
+class P2Quantile {
+public:
+  explicit P2Quantile(float p = 0.5f, uint32_t agingWindow = 0)
+    : p_(p), window_((float)agingWindow) { reset(); }
+
+  void reset(){
+    count_ = 0;
+    for (int i = 0; i < 5; ++i){ q_[i] = 0.0f; n_[i] = (float)i; }
+    ns_[0] = 0.0f; ns_[1] = 2.0f * p_; ns_[2] = 4.0f * p_; ns_[3] = 2.0f + 2.0f * p_; ns_[4] = 4.0f;
+    dns_[0] = 0.0f; dns_[1] = p_ / 2.0f; dns_[2] = p_; dns_[3] = (1.0f + p_) / 2.0f; dns_[4] = 1.0f;
+  }
+
+  void add(float x){
+    if (count_ < 5){
+      // 초기 5개는 정렬 삽입
+      int i = (int)count_;
+      while (i > 0 && q_[i - 1] > x){ q_[i] = q_[i - 1]; i--; }
+      q_[i] = x;
+      count_++;
+      return;
+    }
+    count_++;
+
+    int k;
+    if (x < q_[0]){ q_[0] = x; k = 0; }
+    else if (x >= q_[4]){ q_[4] = x; k = 3; }
+    else { k = 0; while (x >= q_[k + 1]) k++; }
+
+    for (int i = k + 1; i < 5; ++i) n_[i] += 1.0f;
+    for (int i = 0; i < 5; ++i) ns_[i] += dns_[i];
+
+    for (int i = 1; i <= 3; ++i){
+      const float d = ns_[i] - n_[i];
+      if ((d >= 1.0f && n_[i + 1] - n_[i] > 1.0f) || (d <= -1.0f && n_[i - 1] - n_[i] < -1.0f)){
+        const int s = d > 0 ? 1 : -1;
+        const float qp = parabolic(i, (float)s);
+        q_[i] = (q_[i - 1] < qp && qp < q_[i + 1]) ? qp : linear(i, s);
+        n_[i] += (float)s;
+      }
+    }
+
+    if (window_ > 0.0f && n_[4] > window_) age();
+  }
+
+  bool ready() const { return count_ >= 5; }
+
+  // 워밍업 중에는 지금까지 본 샘플의 근사 분위수
+  float value() const {
+    if (count_ >= 5) return q_[2];
+    if (count_ == 0) return 0.0f;
+    int i = (int)(p_ * (float)(count_ - 1) + 0.5f);
+    return q_[i];
+  }
+
+  float min() const { return q_[0]; }
+  float max() const { return count_ >= 5 ? q_[4] : q_[count_ ? count_ - 1 : 0]; }
+  uint32_t count() const { return count_; }
+
+private:
+  float parabolic(int i, float d) const {
+    return q_[i] + d / (n_[i + 1] - n_[i - 1]) *
+           ((n_[i] - n_[i - 1] + d) * (q_[i + 1] - q_[i]) / (n_[i + 1] - n_[i]) +
+            (n_[i + 1] - n_[i] - d) * (q_[i] - q_[i - 1]) / (n_[i] - n_[i - 1]));
+  }
+
+  float linear(int i, int d) const {
+    return q_[i] + (float)d * (q_[i + d] - q_[i]) / (n_[i + d] - n_[i]);
+  }
+
+  // 위치를 창 크기로 축소 → 새 샘플 한 개의 비중이 1/window 로 유지
+  void age(){
+    const float s = window_ / n_[4];
+    for (int i = 1; i < 5; ++i){ n_[i] *= s; ns_[i] *= s; }
+    // 극값도 같은 비율로 이웃 마커 쪽으로 당긴다
+    q_[0] += (q_[1] - q_[0]) * (1.0f - s);
+    q_[4] -= (q_[4] - q_[3]) * (1.0f - s);
+  }
+
+  float p_;
+  float window_;
+  uint32_t count_;
+  float q_[5];
+  float n_[5];
+  float ns_[5];
+  float dns_[5];
+};
@@ -0,0 +1,52 @@
+// ============================================================
+// 퍼센트 값 → 패턴 밀집 인덱스 (컴파일 타임 생성)
+// ------------------------------------------------------------
+// slot[value + 100] = 패턴 번호 + 1 (0 = 패턴 없음)
+// 패턴이 수백 개여도 조회는 배열 로드 한 번.
+// 패턴 타입은 int16_t value 멤버만 있으면 된다.
+// ============================================================
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct ValueIndex {
+  static const int16_t MIN = -100;
+  static const int16_t MAX = 100;
+  static const size_t SIZE = MAX - MIN + 1;
+
+  uint16_t slot[SIZE];
+
+  // 패턴 번호 또는 -1
+  constexpr int32_t find(int16_t value) const {
+    return (value < MIN || value > MAX) ? -1 : (int32_t)slot[value - MIN] - 1;
+  }
+};
+
+template <typename P, size_t N>
+constexpr bool valuesInRange(const P (&patterns)[N]){
+  for (size_t i = 0; i < N; ++i){
+    if (patterns[i].value < ValueIndex::MIN || patterns[i].value > ValueIndex::MAX) return false;
+  }
+  return true;
+}
+
+template <typename P, size_t N>
+constexpr bool valuesUnique(const P (&patterns)[N]){
+  for (size_t i = 0; i < N; ++i){
+    for (size_t j = i + 1; j < N; ++j){
+      if (patterns[i].value == patterns[j].value) return false;
+    }
+  }
+  return true;
+}
+
+template <typename P, size_t N>
+constexpr ValueIndex buildValueIndex(const P (&patterns)[N]){
+  static_assert(N < 0xFFFF, "too many patterns for ValueIndex");
+  ValueIndex idx{};
+  for (size_t i = 0; i < N; ++i){
+    idx.slot[patterns[i].value - ValueIndex::MIN] = (uint16_t)(i + 1);
+  }
+  return idx;
+}
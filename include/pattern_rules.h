@@ -0,0 +1,210 @@
+// ============================================================
+// 범위 / 복합 조건 LED 패턴 규칙
+// ------------------------------------------------------------
+// 규칙 = 값 범위 [lo, hi] + (선택) 체류 시간 + (선택) 변화율 범위
+//  예) { 99, 99, dwell 500ms }  → "99 에서 500ms 유지"
+//      { 20, 80, rate 50..1000%/s } → "20~80 구간을 빠르게 올라가는 중"
+//
+// 인덱스: 중심 구간 트리 (적재 시 1회 구성, 고정 배열, 동적 할당 없음)
+//  - 노드 = 중심값 + 그 값을 포함하는 규칙들 (lo 오름차순 / hi 내림차순 두 목록)
+//  - 중심은 남은 규칙 lo 의 중앙값 → 왼쪽(hi < 중심) / 오른쪽(lo > 중심) 이
+//    각각 절반 이하, 깊이 ≤ log2 n + 1
+//  - 조회: 뿌리에서 한 경로만 내려가며 각 노드 목록은 v 를 포함하는 동안만 훑음
+//  → O(log n + 겹치는 규칙 수). 넓은 규칙이 있어도 그 노드에서 한 번 볼 뿐.
+// 규칙은 런타임에 통째로 교체 가능 (적재 O(n log n), 한 노드에 많이 겹치면 O(m²) 정렬).
+// ============================================================
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct PatternRule {
+  int16_t lo;          // 값 범위 (양 끝 포함)
+  int16_t hi;
+  uint16_t dwellMs;    // 범위 안 연속 체류 ≥ dwellMs (0 = 조건 없음)
+  int16_t rateMin;     // 변화율 범위 [%/s] (rateMin > rateMax 면 조건 없음)
+  int16_t rateMax;
+  uint8_t color;       // 색 번호 (main.cpp 의 팔레트)
+  uint8_t priority;    // 여러 규칙이 맞으면 큰 값 우선, 같으면 좁은 범위
+  uint16_t periodMs;   // 점멸 주기
+};
+
+template <size_t Capacity>
+class PatternRuleSet {
+public:
+  // 변화율 규칙이 걸려 있을 때 재평가 간격
+  static const uint32_t RATE_RECHECK_MS = 50;
+
+  // 규칙 교체. 범위가 뒤집힌 규칙은 버린다. 반환: 적재된 개수
+  size_t load(const PatternRule* rules, size_t n){
+    count_ = 0;
+    for (size_t i = 0; i < n && count_ < Capacity; ++i){
+      if (rules[i].lo > rules[i].hi) continue;
+      // lo 기준 삽입 정렬 (적재 시 1회)
+      size_t j = count_++;
+      while (j > 0 && rules_[j - 1].lo > rules[i].lo){
+        rules_[j] = rules_[j - 1];
+        j--;
+      }
+      rules_[j] = rules[i];
+    }
+    for (size_t i = 0; i < count_; ++i){
+      byLo_[i] = (uint16_t)i;
+      enteredMs_[i] = 0;
+      seenSeq_[i] = 0;
+    }
+    nodeCount_ = 0;
+    build(0, count_);
+    seq_ = 1;
+    primed_ = false;
+    return count_;
+  }
+
+  // 변화율 EMA 시상수 [ms]. 가중치 = dt / (dt + τ) → 20ms 간격이면 1/4
+  static const uint32_t RATE_TAU_MS = 60;
+
+  // 게시 값 갱신 (값이 같아도 주기적으로 호출 → 체류 시간 진행).
+  // 호출 간격과 무관하게 같은 시상수: 값이 바뀔 때만 부르든(taskLed) 펄스마다 부르든(리플레이)
+  // 오래 멈췄다 움직이면 dt 가 커서 가중치 ≈ 1, 기울기 ≈ 0 → 옛 변화율이 남지 않는다
+  void observe(int16_t value, uint32_t nowMs){
+    if (primed_ && nowMs != lastMs_){
+      const uint32_t dt = nowMs - lastMs_;
+      const int64_t slopeQ8 = divRound((int64_t)(value - lastValue_) * 1000 * 256, dt);   // %/s × 256
+      const int64_t alphaQ16 = divRound((int64_t)dt << 16, (int64_t)dt + RATE_TAU_MS);
+      rateQ8_ += (int32_t)divRound((slopeQ8 - rateQ8_) * alphaQ16, 1 << 16);
+    }
+    if (!primed_) rateQ8_ = 0;
+    primed_ = true;
+    lastValue_ = value;
+    lastMs_ = nowMs;
+  }
+
+  // 현재 값에 맞는 최우선 규칙 (없으면 nullptr). observe 후 호출.
+  const PatternRule* match(int16_t value, uint32_t nowMs){
+    const uint32_t prevSeq = seq_++;
+    const PatternRule* best = nullptr;
+    recheckMs_ = 0;
+    visited_ = 0;
+
+    // 뿌리(0)에서 v 쪽 자식으로. 노드 목록은 v 를 포함하는 규칙까지만 (첫 불일치에서 중단)
+    for (int16_t n = nodeCount_ ? 0 : -1; n >= 0; ){
+      const Node& node = nodes_[n];
+      for (size_t k = node.begin; k < node.end; ++k){
+        visited_++;
+        const uint16_t i = value < node.center ? byLo_[k] : byHi_[k];
+        if (value < node.center ? rules_[i].lo > value : rules_[i].hi < value) break;
+        visit(i, prevSeq, nowMs, best);
+      }
+      if (value == node.center) break;
+      n = value < node.center ? node.left : node.right;
+    }
+    return best;
+  }
+
+  size_t size() const { return count_; }
+  const PatternRule& at(size_t i) const { return rules_[i]; }   // lo 순, i < size()
+  int32_t rate() const { return (int32_t)divRound(rateQ8_, 256); }   // %/s
+
+  // 값이 그대로여도 이 시간[ms] 뒤 다시 match 해야 결과가 바뀔 수 있음 (0 = 불필요)
+  uint32_t recheckMs() const { return recheckMs_; }
+
+  // 직전 match 가 들여다본 규칙 수 (겹치는 규칙 + 경로 노드당 최대 1)
+  size_t visited() const { return visited_; }
+
+private:
+  // 중심 c 를 포함하는 규칙 묶음. byLo_ / byHi_ 의 [begin, end) 구간
+  struct Node {
+    int16_t center;
+    uint16_t begin, end;
+    int16_t left, right;   // -1 = 없음
+  };
+
+  // 값을 포함하는 규칙 하나 처리 (체류 / 변화율 조건, 최우선 갱신)
+  void visit(uint16_t i, uint32_t prevSeq, uint32_t nowMs, const PatternRule*& best){
+    const PatternRule& r = rules_[i];
+
+    // 직전 조회 때 이 규칙 범위 밖이었으면 지금 막 진입한 것
+    if (seenSeq_[i] != prevSeq) enteredMs_[i] = nowMs;
+    seenSeq_[i] = seq_;
+
+    const bool rateRule = r.rateMin <= r.rateMax;
+    if (rateRule) wakeIn(RATE_RECHECK_MS);
+
+    const uint32_t dwelt = nowMs - enteredMs_[i];
+    if (r.dwellMs && dwelt < r.dwellMs){
+      wakeIn(r.dwellMs - dwelt);
+      return;
+    }
+    if (rateRule && (rate() < r.rateMin || rate() > r.rateMax)) return;
+    if (!best || better(r, *best)) best = &r;
+  }
+
+  // byLo_[a, b) (lo 순) 로 부분 트리 구성. 반환 = 노드 번호 (-1 = 빈 구간)
+  int16_t build(size_t a, size_t b){
+    if (a == b) return -1;
+    const int16_t n = (int16_t)nodeCount_++;
+    const int16_t center = rules_[byLo_[a + (b - a) / 2]].lo;
+
+    // 오른쪽 = lo > 중심 (lo 순이므로 꼬리)
+    size_t r = b;
+    while (r > a && rules_[byLo_[r - 1]].lo > center) r--;
+    // [a, r) 를 왼쪽(hi < 중심) / 중심 포함으로 안정 분할. byHi_[a..) 는 아직 빈 자리 → 임시로
+    size_t w = a, m = 0;
+    for (size_t k = a; k < r; ++k){
+      const uint16_t i = byLo_[k];
+      if (rules_[i].hi < center) byLo_[w++] = i;
+      else byHi_[a + m++] = i;
+    }
+    for (size_t k = 0; k < m; ++k) byLo_[w + k] = byHi_[a + k];
+    // 같은 규칙들을 hi 내림차순으로
+    for (size_t k = w; k < r; ++k){
+      const uint16_t i = byLo_[k];
+      size_t j = k;
+      while (j > w && rules_[byHi_[j - 1]].hi < rules_[i].hi){ byHi_[j] = byHi_[j - 1]; j--; }
+      byHi_[j] = i;
+    }
+
+    nodes_[n].center = center;
+    nodes_[n].begin = (uint16_t)w;
+    nodes_[n].end = (uint16_t)r;
+    const int16_t left = build(a, w);
+    const int16_t right = build(r, b);
+    nodes_[n].left = left;
+    nodes_[n].right = right;
+    return n;
+  }
+
+  // 반올림 나눗셈 (b > 0). 잘라내면 EMA 에 ±몇 %/s 가 영영 남는다
+  static int64_t divRound(int64_t a, int64_t b){
+    return a >= 0 ? (a + b / 2) / b : -((-a + b / 2) / b);
+  }
+
+  void wakeIn(uint32_t ms){
+    if (!ms) ms = 1;
+    if (!recheckMs_ || ms < recheckMs_) recheckMs_ = ms;
+  }
+
+  static bool better(const PatternRule& a, const PatternRule& b){
+    if (a.priority != b.priority) return a.priority > b.priority;
+    return (a.hi - a.lo) < (b.hi - b.lo);
+  }
+
+  static_assert(Capacity <= 0x7FFF, "PatternRuleSet index is 16-bit");
+
+  PatternRule rules_[Capacity];
+  Node nodes_[Capacity];     // 노드마다 규칙 1개 이상 → Capacity 개면 충분
+  uint16_t byLo_[Capacity];
+  uint16_t byHi_[Capacity];
+  size_t nodeCount_ = 0;
+  size_t visited_ = 0;
+  uint32_t enteredMs_[Capacity];
+  uint32_t seenSeq_[Capacity];
+  size_t count_ = 0;
+  uint32_t seq_ = 1;
+  uint32_t recheckMs_ = 0;
+
+  bool primed_ = false;
+  int16_t lastValue_ = 0;
+  uint32_t lastMs_ = 0;
+  int32_t rateQ8_ = 0;   // %/s × 256
+};
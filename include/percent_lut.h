@@ -0,0 +1,110 @@
+// ============================================================
+// µs → 퍼센트 룩업 테이블
+// ------------------------------------------------------------
+// [calMin, calMax] (양 끝 포함, W = calMax - calMin + 1 µs) 를
+// 201 구간(-100 ~ +100)으로 정확한 유리수 분할:
+//   bin(u) = floor((u - calMin) * 201 / W)
+// → 구간 폭은 floor(W/201) 또는 ceil(W/201), 차이 최대 1µs.
+// 바깥은 ±100 으로 포화. 보정값이 없으면(W < 201) 전부 0.
+//
+// 재구성은 나눗셈 없는 DDA 로 백 버퍼에 조금씩(step) 채우고,
+// 다 차면 앞뒤 버퍼를 바꾼다. 조회는 배열 로드 한 번.
+// ============================================================
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+template <uint16_t LoUs, uint16_t HiUs>
+class PercentLut {
+  static_assert(HiUs > LoUs, "PercentLut range");
+
+public:
+  static const size_t SIZE = (size_t)(HiUs - LoUs) + 1;
+  static const int32_t BINS = 201;
+
+  // 목표 보정값 지정. 진행 중인 재구성은 끝까지 마친 뒤 반영된다
+  void retarget(uint16_t calMin, uint16_t calMax){
+    targetMin_ = calMin;
+    targetMax_ = calMax;
+    if (!building_ && (calMin != frontMin_ || calMax != frontMax_ || !ready_)) begin();
+  }
+
+  // 백 버퍼를 최대 budget 칸 채운다. 교체가 일어나면 true
+  bool step(size_t budget){
+    if (!building_) return false;
+    int8_t* back = tables_[front_ ^ 1];
+    while (budget-- && cursor_ < SIZE){
+      const int32_t u = (int32_t)LoUs + (int32_t)cursor_;
+      int8_t v;
+      if (w_ < BINS)              v = 0;
+      else if (u < buildMin_)     v = -100;
+      else if (u > buildMax_)     v = 100;
+      else {
+        v = (int8_t)(bin_ - 100);
+        // 다음 µs 로 진행: acc += 201, acc >= W 마다 bin++
+        acc_ += BINS;
+        while (acc_ >= w_){ acc_ -= w_; bin_++; }
+      }
+      back[cursor_++] = v;
+    }
+    if (cursor_ < SIZE) return false;
+
+    front_ ^= 1;
+    frontMin_ = buildMin_;
+    frontMax_ = buildMax_;
+    ready_ = true;
+    building_ = false;
+    if (targetMin_ != frontMin_ || targetMax_ != frontMax_) begin();
+    return true;
+  }
+
+  // 즉시 전체 재구성 (부팅 시)
+  void rebuild(uint16_t calMin, uint16_t calMax){
+    retarget(calMin, calMax);
+    while (building_) step(SIZE);
+  }
+
+  int8_t lookup(uint16_t us) const {
+    if (us < LoUs) us = LoUs;
+    if (us > HiUs) us = HiUs;
+    return tables_[front_][us - LoUs];
+  }
+
+  bool ready() const { return ready_; }
+  // 앞 표가 실제 보정값(W ≥ 201)으로 만들어졌는가. ready() 는 전부 0 인 표도 포함
+  bool calibrated() const { return ready_ && frontMax_ >= frontMin_ && frontMax_ - frontMin_ + 1 >= BINS; }
+  bool building() const { return building_; }
+  uint16_t calMin() const { return frontMin_; }
+  uint16_t calMax() const { return frontMax_; }
+
+private:
+  void begin(){
+    buildMin_ = targetMin_;
+    buildMax_ = targetMax_;
+    w_ = (buildMax_ >= buildMin_) ? (int32_t)buildMax_ - buildMin_ + 1 : 0;
+    cursor_ = 0;
+    bin_ = 0;
+    acc_ = 0;
+    if (w_ >= BINS && buildMin_ < LoUs){
+      // 보정 하한이 표 범위 밖이면 시작 구간을 한 번만 계산
+      const int32_t off = (int32_t)LoUs - buildMin_;
+      bin_ = off * BINS / w_;
+      acc_ = off * BINS % w_;
+    }
+    building_ = true;
+  }
+
+  int8_t tables_[2][SIZE] = {};
+  uint8_t front_ = 0;
+  bool ready_ = false;
+  bool building_ = false;
+
+  uint16_t targetMin_ = 0, targetMax_ = 0;
+  uint16_t frontMin_ = 0, frontMax_ = 0;
+  uint16_t buildMin_ = 0, buildMax_ = 0;
+  int32_t w_ = 0;
+  size_t cursor_ = 0;
+  int32_t bin_ = 0;
+  int32_t acc_ = 0;
+};
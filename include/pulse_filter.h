@@ -0,0 +1,65 @@
+// ============================================================
+// 펄스 폭 필터
+// ------------------------------------------------------------
+// MovingAverage<N>: 누적합 + 유효 샘플 수를 유지하는 O(1) 이동 평균
+//  - N 은 최대 창. setWindow 로 런타임에 1..N 으로 줄일 수 있다
+//  - 0 은 "빈 칸" (기존 filterPulse 와 동일한 규칙)
+//  - 창이 가득 차고 N 이 2의 거듭제곱이면 나눗셈 대신 시프트
+// ============================================================
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace pulse_filter {
+
+constexpr bool isPow2(size_t n){ return n && !(n & (n - 1)); }
+
+constexpr uint8_t log2Floor(size_t n){ return n <= 1 ? 0 : 1 + log2Floor(n >> 1); }
+
+} // namespace pulse_filter
+
+template <size_t N>
+class MovingAverage {
+  static_assert(N >= 1 && N <= 0xFFFF, "MovingAverage window out of range");
+
+public:
+  static constexpr size_t WINDOW = N;
+
+  uint16_t push(uint16_t v){
+    const uint16_t old = buf_[idx_];
+    if (old){ sum_ -= old; count_--; }
+    buf_[idx_] = v;
+    if (v){ sum_ += v; count_++; }
+    if (++idx_ >= win_) idx_ = 0;
+    return value();
+  }
+
+  uint16_t value() const {
+    if (count_ == 0) return 0;
+    if (pulse_filter::isPow2(N) && count_ == N)
+      return (uint16_t)(sum_ >> pulse_filter::log2Floor(N));
+    return (uint16_t)(sum_ / count_);
+  }
+
+  void reset(){
+    for (size_t i = 0; i < N; ++i) buf_[i] = 0;
+    sum_ = 0; count_ = 0; idx_ = 0;
+  }
+
+  // 창 크기 변경 (1..N). 쌓인 샘플은 버린다
+  void setWindow(size_t n){
+    win_ = n < 1 ? 1 : (n > N ? N : n);
+    reset();
+  }
+
+  size_t window() const { return win_; }
+  size_t count() const { return count_; }
+
+private:
+  uint16_t buf_[N] = {};
+  uint32_t sum_ = 0;
+  size_t count_ = 0;
+  size_t idx_ = 0;
+  size_t win_ = N;
+};
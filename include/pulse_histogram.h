@@ -0,0 +1,128 @@
+// ============================================================
+// 1µs 펄스 폭 히스토그램 + 최빈값 (순수 로직, 고정 메모리, 펄스당 O(1))
+// ------------------------------------------------------------
+// LoUs..HiUs 1µs 칸마다 최근 Window 개 펄스의 빈도.
+//  - 창 감쇠: 링에 최근 Window 개 폭 보관 → 새 펄스 +1, 가장 오래된 펄스 -1
+//  - 최빈값: 빈도별 이중 연결 목록 (같은 빈도의 칸끼리) + 최대 빈도.
+//    빈도는 ±1 씩만 변하므로 목록 이동 / 최대 갱신 모두 O(1), 칸 재탐색 없음
+//  - 동률이면 기존 최빈값 유지 (동률 칸끼리 번갈아 바뀌지 않게)
+//  - 분위수: 32칸 블록 합 → 블록 훑기 + 블록 안 훑기 (조회 전용, 최대 ~76단계)
+// 파이프라인 단계로도 쓴다: push(us) → 최빈값 (0 = 값 없음, 범위 밖 입력은 무시).
+// 1401칸 / 창 64 기준 약 8.9kB.
+// ============================================================
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+template <uint16_t LoUs, uint16_t HiUs, size_t Window>
+class PulseHistogram {
+  static_assert(LoUs > 0 && LoUs <= HiUs && HiUs - LoUs < 0xFFFF, "PulseHistogram range");
+  static_assert(Window >= 1 && Window < 0xFFFF, "PulseHistogram window must be in [1, 65535)");
+
+public:
+  static const size_t BINS = (size_t)(HiUs - LoUs) + 1;
+  static const size_t BLOCK = 32;
+  static const size_t BLOCKS = (BINS + BLOCK - 1) / BLOCK;
+
+  PulseHistogram(){ reset(); }
+
+  void reset(){
+    for (size_t i = 0; i < BINS; ++i) count_[i] = 0;
+    for (size_t i = 0; i <= Window; ++i) head_[i] = NIL;
+    for (size_t i = 0; i < BLOCKS; ++i) block_[i] = 0;
+    n_ = pos_ = 0;
+    maxCount_ = 0;
+    mode_ = 0;
+  }
+
+  // 펄스 하나 → 현재 최빈값 [µs]
+  uint16_t push(uint16_t us){
+    if (!inRange(us)) return mode();
+    const uint16_t bin = (uint16_t)(us - LoUs);
+    const uint16_t old = ring_[pos_];
+    ring_[pos_] = bin;
+    pos_ = pos_ + 1 == Window ? 0 : pos_ + 1;
+    if (n_ == Window){
+      // 같은 칸이 나가고 들어옴 → 빈도 불변. dec 가 동률 칸에 최빈값을 넘기지 않게 건너뜀
+      if (old == bin) return mode();
+      dec(old);
+    } else {
+      n_++;
+    }
+    inc(bin);
+    return mode();
+  }
+
+  // ---- 조회 ----
+  size_t size() const { return n_; }
+  static constexpr size_t window(){ return Window; }
+
+  uint16_t mode() const { return n_ ? (uint16_t)(LoUs + mode_) : 0; }
+  uint16_t modeCount() const { return maxCount_; }
+  uint16_t count(uint16_t us) const { return inRange(us) ? count_[us - LoUs] : 0; }
+
+  // 하위 permille/1000 분위 폭 [µs] (그 폭 이하가 전체의 permille‰ 이상). 비었으면 0
+  uint16_t quantile(uint16_t permille) const {
+    if (!n_) return 0;
+    if (permille > 1000) permille = 1000;
+    size_t rank = ((size_t)permille * n_ + 999) / 1000;
+    if (!rank) rank = 1;
+    size_t b = 0;
+    while (rank > block_[b]){ rank -= block_[b]; b++; }
+    size_t i = b * BLOCK;
+    while (rank > count_[i]){ rank -= count_[i]; i++; }
+    return (uint16_t)(LoUs + i);
+  }
+
+  static bool inRange(uint16_t us){ return us >= LoUs && us <= HiUs; }
+
+private:
+  static const uint16_t NIL = 0xFFFF;
+
+  void link(uint16_t bin, uint16_t c){
+    prev_[bin] = NIL;
+    next_[bin] = head_[c];
+    if (head_[c] != NIL) prev_[head_[c]] = bin;
+    head_[c] = bin;
+  }
+
+  void unlink(uint16_t bin, uint16_t c){
+    if (prev_[bin] != NIL) next_[prev_[bin]] = next_[bin];
+    else head_[c] = next_[bin];
+    if (next_[bin] != NIL) prev_[next_[bin]] = prev_[bin];
+  }
+
+  void inc(uint16_t bin){
+    const uint16_t c = count_[bin];
+    if (c) unlink(bin, c);
+    count_[bin] = (uint16_t)(c + 1);
+    link(bin, (uint16_t)(c + 1));
+    block_[bin / BLOCK]++;
+    if (c + 1 > maxCount_) maxCount_ = (uint16_t)(c + 1);
+    // 최대 빈도를 단독으로 넘어선 칸만 최빈값을 뺏는다 (동률이면 유지)
+    if (n_ == 1 || count_[bin] > count_[mode_]) mode_ = bin;
+  }
+
+  void dec(uint16_t bin){
+    const uint16_t c = count_[bin];
+    unlink(bin, c);
+    count_[bin] = (uint16_t)(c - 1);
+    if (c > 1) link(bin, (uint16_t)(c - 1));
+    block_[bin / BLOCK]--;
+    // 빈도 c 목록이 비면 최대는 c-1 (이 칸이 방금 그리로 내려왔다)
+    if (c == maxCount_ && head_[c] == NIL) maxCount_--;
+    if (bin == mode_ && count_[bin] < maxCount_) mode_ = head_[maxCount_];
+  }
+
+  uint16_t count_[BINS];
+  uint16_t next_[BINS];
+  uint16_t prev_[BINS];
+  uint16_t head_[Window + 1];   // head_[c] = 빈도 c 인 칸 목록 (c ≥ 1)
+  uint16_t block_[BLOCKS];
+  uint16_t ring_[Window];       // 창 안의 칸 번호 (오래된 것부터 pos_)
+
+  size_t n_, pos_;
+  uint16_t maxCount_;
+  uint16_t mode_;               // 칸 번호
+};
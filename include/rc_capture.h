@@ -0,0 +1,157 @@
+// ============================================================
+// RC 입력 캡처 디코더 (순수 로직, 하드웨어 의존 없음)
+// ------------------------------------------------------------
+// 타이머 입력 캡처가 양 에지에서 래치한 16비트 카운터 값을
+// DMA 링에서 읽어 펄스 폭으로 변환한다.
+//  - 16비트 캡처 값은 드레인 시점 카운터 기준으로 32비트 틱으로 확장
+//    (드레인 간격 < 2^16 틱이면 모호성 없음) → 긴 LOW 구간도 정확
+//  - 에지 극성은 캡처 값에 없으므로 위상(HIGH/LOW)을 추적
+//  - 위상이 어긋나면(에지 유실) 연속 불일치로 감지해 스스로 복구
+// 호스트에서 합성 에지 스트림으로 그대로 돌릴 수 있다.
+// ============================================================
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct RcPulse {
+  uint16_t us;         // 반올림된 펄스 폭 [µs] (거부된 구간은 65535 에서 포화)
+  uint16_t ticks;      // 원시 펄스 폭 [틱] (거부된 구간은 65535 에서 포화)
+  uint32_t fallTick;   // 하강 에지 시각 [확장 틱]
+  bool valid;          // false = 범위 밖이라 거부된 HIGH 구간 (트레이스용)
+};
+
+// ISR → 태스크로 넘기는 펄스 레코드
+struct PulseRecord {
+  uint32_t tUs;        // 하강 에지 시각 [µs, micros 기준]
+  uint16_t us;         // 펄스 폭 [µs]
+};
+
+class RcEdgeDecoder {
+public:
+  // 위상 불일치가 이 횟수만큼 연속되면 위상을 뒤집는다
+  static const uint8_t RESYNC_AFTER = 3;
+
+  RcEdgeDecoder() = default;
+
+  RcEdgeDecoder(uint32_t ticksPerUs, uint16_t minUs, uint16_t maxUs){
+    configure(ticksPerUs, minUs, maxUs);
+  }
+
+  void configure(uint32_t ticksPerUs, uint16_t minUs, uint16_t maxUs){
+    tpu_ = ticksPerUs ? ticksPerUs : 1;
+    minTicks_ = (uint32_t)minUs * tpu_;
+    maxTicks_ = (uint32_t)maxUs * tpu_;
+  }
+
+  // levelHigh: 다음 에지 직전의 핀 레벨 (다음 에지가 하강이면 true)
+  void reset(bool levelHigh){
+    high_ = levelHigh;
+    primed_ = false;
+    mismatch_ = 0;
+  }
+
+  // 캡처 오버런 등으로 위상을 잃었을 때 핀 레벨로 재동기화
+  void resync(bool levelHigh){
+    reset(levelHigh);
+    resyncs_++;
+  }
+
+  // 에지 하나 입력. 유효 펄스가 완성되면 out 을 채우고 true.
+  // 범위 밖 HIGH 구간도 out 에 valid = false 로 채우고 false (rejects() 증가로 구분)
+  bool push(uint32_t tick, RcPulse& out){
+    const bool wasHigh = high_;
+    high_ = !high_;
+
+    if (!primed_){
+      // 첫 에지는 기준점만 잡는다
+      primed_ = true;
+      lastTick_ = tick;
+      return false;
+    }
+
+    const uint32_t interval = tick - lastTick_;
+    lastTick_ = tick;
+
+    if (!wasHigh){
+      // 상승 에지: 직전 LOW 구간 길이를 위상 검사용으로 보관
+      lowTicks_ = interval;
+      return false;
+    }
+
+    // 하강 에지: 직전 HIGH 구간이 펄스
+    const uint32_t us = (interval + tpu_ / 2) / tpu_;
+    out.ticks = (uint16_t)(interval > 0xFFFF ? 0xFFFF : interval);
+    out.us = (uint16_t)(us > 0xFFFF ? 0xFFFF : us);
+    out.fallTick = tick;
+    out.valid = inWindow(interval);
+    if (out.valid){
+      mismatch_ = 0;
+      pulses_++;
+      return true;
+    }
+
+    rejects_++;
+    // HIGH 는 범위 밖인데 LOW 쪽이 펄스처럼 보이면 위상이 뒤집힌 것
+    if (inWindow(lowTicks_)){
+      if (++mismatch_ >= RESYNC_AFTER){
+        high_ = !high_;
+        mismatch_ = 0;
+        resyncs_++;
+      }
+    } else {
+      mismatch_ = 0;
+    }
+    return false;
+  }
+
+  // DMA 원형 링에서 tail..head 구간을 소비하고 펄스마다 onPulse(const RcPulse&) 호출.
+  // 거부된 HIGH 구간은 onReject(const RcPulse&) (valid = false).
+  // cntNow/extNow: 드레인 시점의 16비트 카운터와 그에 대응하는 확장 틱.
+  // 반환: 소비한 에지 수
+  template <typename Fn, typename Reject>
+  size_t drain(const volatile uint16_t* ring, size_t size, size_t& tail, size_t head,
+               uint16_t cntNow, uint32_t extNow, Fn&& onPulse, Reject&& onReject){
+    size_t n = 0;
+    RcPulse p;
+    while (tail != head){
+      const uint16_t cap = ring[tail];
+      const uint32_t rejects = rejects_;
+      if (push(extNow - (uint16_t)(cntNow - cap), p)) onPulse(p);
+      else if (rejects_ != rejects) onReject(p);
+      if (++tail >= size) tail = 0;
+      n++;
+    }
+    return n;
+  }
+
+  template <typename Fn>
+  size_t drain(const volatile uint16_t* ring, size_t size, size_t& tail, size_t head,
+               uint16_t cntNow, uint32_t extNow, Fn&& onPulse){
+    return drain(ring, size, tail, head, cntNow, extNow, onPulse, [](const RcPulse&){});
+  }
+
+  uint32_t ticksPerUs() const { return tpu_; }
+  uint32_t pulses()     const { return pulses_; }
+  uint32_t rejects()    const { return rejects_; }
+  uint32_t resyncs()    const { return resyncs_; }
+
+private:
+  bool inWindow(uint32_t ticks) const {
+    return ticks >= minTicks_ && ticks <= maxTicks_;
+  }
+
+  uint32_t tpu_ = 1;
+  uint32_t minTicks_ = 0;
+  uint32_t maxTicks_ = 0;
+
+  bool high_ = false;
+  bool primed_ = false;
+  uint8_t mismatch_ = 0;
+  uint32_t lastTick_ = 0;
+  uint32_t lowTicks_ = 0;
+
+  uint32_t pulses_ = 0;
+  uint32_t rejects_ = 0;
+  uint32_t resyncs_ = 0;
+};
@@ -0,0 +1,28 @@
+// ============================================================
+// RC 입력 캡처 백엔드 (Portenta H7: TIM1_CH1 + DMA)
+// ------------------------------------------------------------
+// D1(PK1) = TIM1_CH1. 양 에지를 하드웨어가 래치하고 DMA 가
+// 원형 링으로 옮긴다. 인터럽트 진입 지연은 폭에 섞이지 않는다.
+// 링은 카운터 반주기(CC2)/오버플로(UPDATE) 인터럽트에서 드레인.
+// 호스트(env:native)에서는 rcCaptureBegin 이 false → GPIO 인터럽트 경로 사용.
+// ============================================================
+#pragma once
+
+#include <stdint.h>
+#include "rc_capture.h"
+
+#ifndef RC_CAPTURE_TICK_HZ
+#define RC_CAPTURE_TICK_HZ 24000000UL   // 1/24 µs 분해능
+#endif
+
+#ifndef RC_CAPTURE_RING
+#define RC_CAPTURE_RING 64              // DMA 링 길이 (에지 수)
+#endif
+
+// 펄스 콜백: 인터럽트 컨텍스트에서 호출. tUs = 하강 에지 시각 (micros 기준)
+// 범위 밖으로 거부된 HIGH 구간도 pulse.valid = false 로 온다 (트레이스가 원시 에지를 남기도록)
+typedef void (*RcPulseHandler)(const RcPulse& pulse, uint32_t tUs);
+
+bool rcCaptureBegin(uint16_t minUs, uint16_t maxUs, RcPulseHandler onPulse);
+
+const RcEdgeDecoder& rcCaptureDecoder();
@@ -0,0 +1,182 @@
+// ============================================================
+// 합성 RC 신호 발생기 (순수 로직, 시드 고정 → 결정적)
+// ------------------------------------------------------------
+// 송신기 없이 onRcChange / 디코더 / 필터를 돌리기 위한 에지 시각 열.
+//  - 프레임율 50~400Hz, 프레임마다 목표 폭 지정 가능
+//  - 에지별 지터: 가우시안(σ) + 균등(±), 상승/하강 에지 독립
+//  - 드롭아웃: 확률 + 최대 연속 프레임 수 (버스트)
+//  - 런트 글리치: LOW 구간에 짧은 가짜 펄스
+//  - 클럭 드리프트: 수신기 시계가 ppm 만큼 빠름/느림 (모든 간격에 곱해짐)
+// 시각은 시작점 기준 ns (uint64). 같은 시드 + 설정이면 같은 열.
+// 프레임당 난수 몇 개 + 곱셈뿐 (할당 없음). 분포 / 재현성은 test/test_rc_signal_gen.
+// ============================================================
+#pragma once
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+struct RcSignalConfig {
+  uint16_t frameHz = 50;            // 50 ~ 400
+  float widthUs = 1500.0f;          // 목표 폭 (setWidthUs 로 프레임마다 변경 가능)
+  float jitterGaussUs = 0.0f;       // 에지당 가우시안 σ
+  float jitterUniformUs = 0.0f;     // 에지당 균등 ±
+  float dropoutProb = 0.0f;         // 프레임이 통째로 사라질 확률
+  uint16_t dropoutMaxFrames = 1;    // 드롭아웃 한 번의 최대 연속 프레임 (1 ~ N 균등)
+  float runtProb = 0.0f;            // LOW 구간에 런트 펄스가 끼어들 확률
+  float runtMinUs = 2.0f;
+  float runtMaxUs = 60.0f;
+  float driftPpm = 0.0f;            // + = 수신기 시계가 느림 (간격이 길게 보임)
+};
+
+struct RcEdge {
+  uint64_t tNs;                     // 시작점 기준 시각
+  uint8_t level;                    // 에지 직후 레벨 (1 = 상승)
+};
+
+class RcSignalGen {
+public:
+  // 프레임 하나가 내는 최대 에지 수 (펄스 + 런트)
+  static const size_t MAX_EDGES = 4;
+
+  RcSignalGen(const RcSignalConfig& cfg, uint64_t seed){
+    configure(cfg);
+    reseed(seed);
+  }
+
+  void configure(const RcSignalConfig& cfg){
+    cfg_ = cfg;
+    if (cfg_.frameHz < 1) cfg_.frameHz = 1;
+    scale_ = 1.0 + (double)cfg_.driftPpm * 1e-6;
+    periodNs_ = 1e9 / cfg_.frameHz * scale_;
+    width_ = cfg_.widthUs;
+  }
+
+  void reseed(uint64_t seed){
+    // splitmix64 로 상태 확장 (시드 0 도 안전)
+    s_ = seed + 0x9E3779B97F4A7C15ull;
+    s_ = (s_ ^ (s_ >> 30)) * 0xBF58476D1CE4E5B9ull;
+    s_ = (s_ ^ (s_ >> 27)) * 0x94D049BB133111EBull;
+    s_ ^= s_ >> 31;
+    if (!s_) s_ = 1;
+    spare_ = false;
+    frame_ = 0;
+    lastNs_ = -1000.0;
+    dropLeft_ = 0;
+    frames_ = dropped_ = runts_ = 0;
+  }
+
+  // 다음 프레임부터 적용할 목표 폭 [µs]
+  void setWidthUs(float us){ width_ = us; }
+
+  // 프레임 하나 생성. out 에 시각순 에지 기록, 반환 = 에지 수 (0 = 드롭아웃)
+  size_t nextFrame(RcEdge* out){
+    const double t0 = (double)frame_++ * periodNs_;
+    frames_++;
+    lastWidthUs_ = width_;
+
+    if (dropLeft_ || (cfg_.dropoutProb > 0.0f && uniform() < cfg_.dropoutProb)){
+      if (!dropLeft_){
+        const uint32_t maxN = cfg_.dropoutMaxFrames ? cfg_.dropoutMaxFrames : 1;
+        dropLeft_ = 1 + (uint32_t)(uniform() * maxN);
+        if (dropLeft_ > maxN) dropLeft_ = maxN;
+      }
+      dropLeft_--;
+      dropped_++;
+      return 0;
+    }
+
+    double rise = t0 + edgeJitterNs();
+    double fall = t0 + (double)width_ * 1000.0 * scale_ + edgeJitterNs();
+    // 지터가 커도 에지 순서는 유지 (직전 에지 / 상승 에지보다 최소 1µs 뒤)
+    if (rise < lastNs_ + 1000.0) rise = lastNs_ + 1000.0;
+    if (fall < rise + 1000.0) fall = rise + 1000.0;
+    lastNs_ = fall;
+
+    size_t n = 0;
+    out[n++] = RcEdge{ (uint64_t)rise, 1 };
+    out[n++] = RcEdge{ (uint64_t)fall, 0 };
+
+    if (cfg_.runtProb > 0.0f && uniform() < cfg_.runtProb){
+      // LOW 구간 (하강 뒤 ~ 다음 상승 전) 안쪽 임의 위치
+      const double runtNs = ((double)cfg_.runtMinUs +
+                             (double)(cfg_.runtMaxUs - cfg_.runtMinUs) * uniform()) * 1000.0 * scale_;
+      const double gapNs = t0 + periodNs_ - fall - runtNs - 2000.0;
+      if (gapNs > 0.0){
+        const double at = fall + 1000.0 + gapNs * uniform();
+        out[n++] = RcEdge{ (uint64_t)at, 1 };
+        out[n++] = RcEdge{ (uint64_t)(at + runtNs), 0 };
+        lastNs_ = at + runtNs;
+        runts_++;
+      }
+    }
+    return n;
+  }
+
+  // frames 프레임을 돌며 에지마다 onEdge(const RcEdge&)
+  template <typename Fn>
+  void run(uint32_t frames, Fn onEdge){
+    RcEdge edges[MAX_EDGES];
+    for (uint32_t f = 0; f < frames; ++f){
+      const size_t n = nextFrame(edges);
+      for (size_t i = 0; i < n; ++i) onEdge(edges[i]);
+    }
+  }
+
+  // 마지막 프레임의 목표 폭 (정확도 비교 기준)
+  float lastWidthUs() const { return lastWidthUs_; }
+  uint64_t periodNs() const { return (uint64_t)periodNs_; }
+
+  uint32_t frames() const { return frames_; }
+  uint32_t dropped() const { return dropped_; }
+  uint32_t runts() const { return runts_; }
+
+private:
+  // xorshift64*
+  uint64_t next64(){
+    s_ ^= s_ >> 12;
+    s_ ^= s_ << 25;
+    s_ ^= s_ >> 27;
+    return s_ * 0x2545F4914F6CDD1Dull;
+  }
+
+  // [0, 1)
+  float uniform(){ return (float)(next64() >> 40) * (1.0f / 16777216.0f); }
+
+  // 표준 정규 (Marsaglia polar, 두 번째 값은 다음 호출에 재사용)
+  float gauss(){
+    if (spare_){ spare_ = false; return spareVal_; }
+    float u, v, s;
+    do {
+      u = 2.0f * uniform() - 1.0f;
+      v = 2.0f * uniform() - 1.0f;
+      s = u * u + v * v;
+    } while (s >= 1.0f || s == 0.0f);
+    const float m = sqrtf(-2.0f * logf(s) / s);
+    spareVal_ = v * m;
+    spare_ = true;
+    return u * m;
+  }
+
+  double edgeJitterNs(){
+    float j = 0.0f;
+    if (cfg_.jitterGaussUs > 0.0f) j += cfg_.jitterGaussUs * gauss();
+    if (cfg_.jitterUniformUs > 0.0f) j += cfg_.jitterUniformUs * (2.0f * uniform() - 1.0f);
+    return (double)j * 1000.0;
+  }
+
+  RcSignalConfig cfg_;
+  double scale_ = 1.0;
+  double periodNs_ = 0.0;
+  float width_ = 1500.0f;
+  float lastWidthUs_ = 0.0f;
+
+  uint64_t s_ = 1;
+  bool spare_ = false;
+  float spareVal_ = 0.0f;
+
+  uint64_t frame_ = 0;
+  double lastNs_ = -1000.0;
+  uint32_t dropLeft_ = 0;
+  uint32_t frames_ = 0, dropped_ = 0, runts_ = 0;
+};
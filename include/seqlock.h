@@ -0,0 +1,67 @@
+// ============================================================
+// 시퀀스 락 (단일 작성자, 다수 독자)
+// ------------------------------------------------------------
+// 작성자: 버전을 홀수로 → 본문 기록 → 짝수로. 절대 기다리지 않는다.
+// 독자: 버전 읽기 → 본문 복사 → 버전 재확인. 홀수였거나 바뀌었으면 재시도.
+//  - 인터럽트 금지 / 뮤텍스 없음, 독자는 작성자를 막지 않음
+//  - 본문은 워드 단위 relaxed 원자 변수 → 찢어진 복사는 버전 검사로 걸러짐
+//  - 독자가 작성자보다 우선순위가 높으면 재시도 상한(maxTries)을 두고 양보할 것
+// ============================================================
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <type_traits>
+
+template <typename T>
+class Seqlock {
+  static_assert(std::is_trivially_copyable<T>::value, "Seqlock payload must be trivially copyable");
+
+public:
+  Seqlock(){
+    const T init = T();
+    write(init);
+    version_.store(0, std::memory_order_relaxed);
+  }
+
+  // 작성자 전용
+  void write(const T& value){
+    uint32_t words[WORDS] = {};
+    memcpy(words, &value, sizeof(T));
+
+    const uint32_t v = version_.load(std::memory_order_relaxed);
+    version_.store(v + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < WORDS; ++i) data_[i].store(words[i], std::memory_order_relaxed);
+    version_.store(v + 2, std::memory_order_release);
+  }
+
+  // 일관된 복사본을 얻으면 true (out 갱신). maxTries 0 = 성공할 때까지
+  bool read(T& out, uint32_t maxTries = 0) const {
+    for (uint32_t n = 0; !maxTries || n < maxTries; ++n){
+      const uint32_t v1 = version_.load(std::memory_order_acquire);
+      if (v1 & 1u) continue;
+
+      uint32_t words[WORDS];
+      for (size_t i = 0; i < WORDS; ++i) words[i] = data_[i].load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+
+      if (version_.load(std::memory_order_relaxed) == v1){
+        memcpy(&out, words, sizeof(T));
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // 지금까지 완료된 쓰기 횟수
+  uint32_t writes() const { return version_.load(std::memory_order_acquire) / 2; }
+
+private:
+  static const size_t WORDS = (sizeof(T) + 3) / 4;
+
+  std::atomic<uint32_t> version_{0};
+  std::atomic<uint32_t> data_[WORDS];
+};
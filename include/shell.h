@@ -0,0 +1,168 @@
+// ============================================================
+// 줄 단위 명령 셸 (순수 로직, 동적 할당 없음)
+// ------------------------------------------------------------
+// 바이트를 하나씩 feed → 줄이 끝나면(\r 또는 \n) 제자리 토큰화 후 명령 실행.
+//  - 줄 버퍼 / argv 모두 고정 크기 멤버. 토큰은 줄 버퍼 안을 가리킨다
+//  - 명령 표는 constexpr 배열 (이름 중복은 shellNamesUnique 로 빌드 에러)
+//  - 출력은 ShellOut 고정 버퍼에 printf (넘치면 잘리고 표시)
+//  - "help" 는 내장: 표의 usage 를 모두 출력
+// 입출력 장치를 모르므로 호스트에서 바이트 열만으로 시험할 수 있다.
+// ============================================================
+#pragma once
+
+#include <errno.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 명령 응답 버퍼
+class ShellOut {
+public:
+  ShellOut(char* buf, size_t cap) : buf_(buf), cap_(cap){ clear(); }
+
+  void print(const char* fmt, ...) __attribute__((format(printf, 2, 3))){
+    if (len_ + 1 >= cap_){ truncated_ = true; return; }
+    va_list ap;
+    va_start(ap, fmt);
+    const int n = vsnprintf(buf_ + len_, cap_ - len_, fmt, ap);
+    va_end(ap);
+    if (n < 0) return;
+    if ((size_t)n >= cap_ - len_){
+      truncated_ = true;
+      len_ = cap_ - 1;
+    } else {
+      len_ += (size_t)n;
+    }
+  }
+
+  void clear(){ len_ = 0; truncated_ = false; if (cap_) buf_[0] = 0; }
+
+  const char* data() const { return buf_; }
+  size_t size() const { return len_; }
+  bool truncated() const { return truncated_; }
+
+private:
+  char* buf_;
+  size_t cap_;
+  size_t len_ = 0;
+  bool truncated_ = false;
+};
+
+// argv[0] = 명령 이름. false 를 반환하면 셸이 usage 를 출력
+typedef bool (*ShellHandler)(size_t argc, char* const* argv, ShellOut& out);
+
+struct ShellCommand {
+  const char* name;
+  uint8_t minArgs;       // 명령 이름 제외
+  uint8_t maxArgs;
+  ShellHandler fn;
+  const char* usage;
+};
+
+constexpr bool shellStrEq(const char* a, const char* b){
+  while (*a && *a == *b){ ++a; ++b; }
+  return *a == *b;
+}
+
+template <size_t N>
+constexpr bool shellNamesUnique(const ShellCommand (&table)[N]){
+  for (size_t i = 0; i < N; ++i){
+    if (shellStrEq(table[i].name, "help")) return false;
+    for (size_t j = i + 1; j < N; ++j){
+      if (shellStrEq(table[i].name, table[j].name)) return false;
+    }
+  }
+  return true;
+}
+
+// 10진 / 0x16진 정수. 숫자가 없거나, 뒤에 다른 글자가 붙거나, int32 를 넘으면 false.
+// long 이 32비트면 strtol 이 넘친 값을 LONG_MAX 로 잘라 주므로 ERANGE 를 따로 본다
+inline bool shellParseInt(const char* s, int32_t& out){
+  if (!s || !*s) return false;
+  char* end = nullptr;
+  errno = 0;
+  const long v = strtol(s, &end, 0);
+  if (end == s || *end || errno == ERANGE) return false;
+  if ((int64_t)v < INT32_MIN || (int64_t)v > INT32_MAX) return false;
+  out = (int32_t)v;
+  return true;
+}
+
+template <size_t LineMax = 96, size_t MaxArgs = 6>
+class Shell {
+public:
+  template <size_t N>
+  explicit Shell(const ShellCommand (&table)[N]) : table_(table), count_(N){}
+
+  // 한 바이트 입력. 줄을 실행했으면 true (응답은 out 에)
+  bool feed(char c, ShellOut& out){
+    if (c == '\r' || c == '\n'){
+      if (overflow_){
+        overflow_ = false;
+        len_ = 0;
+        errors_++;
+        out.print("error: line too long (max %u)\n", (unsigned)(LineMax - 1));
+        return true;
+      }
+      if (!len_) return false;             // 빈 줄 / CRLF 의 두 번째 글자
+      line_[len_] = 0;
+      len_ = 0;
+      execute(line_, out);
+      return true;
+    }
+    if (c == '\b' || c == 0x7F){
+      if (len_) len_--;
+      return false;
+    }
+    if (len_ + 1 >= LineMax){ overflow_ = true; return false; }
+    line_[len_++] = c;
+    return false;
+  }
+
+  // 한 줄 실행 (line 은 제자리에서 잘린다)
+  void execute(char* line, ShellOut& out){
+    char* argv[MaxArgs + 1];
+    size_t argc = 0;
+    bool tooMany = false;
+    for (char* p = line; *p; ){
+      while (*p == ' ' || *p == '\t') *p++ = 0;
+      if (!*p) break;
+      if (argc == MaxArgs + 1){ tooMany = true; break; }
+      argv[argc++] = p;
+      while (*p && *p != ' ' && *p != '\t') p++;
+    }
+    if (!argc) return;
+    executed_++;
+
+    if (!strcmp(argv[0], "help")){
+      for (size_t i = 0; i < count_; ++i) out.print("  %s\n", table_[i].usage);
+      return;
+    }
+    for (size_t i = 0; i < count_; ++i){
+      const ShellCommand& cmd = table_[i];
+      if (strcmp(argv[0], cmd.name)) continue;
+      const size_t n = argc - 1;
+      if (tooMany || n < cmd.minArgs || n > cmd.maxArgs || !cmd.fn(argc, argv, out)){
+        errors_++;
+        out.print("usage: %s\n", cmd.usage);
+      }
+      return;
+    }
+    errors_++;
+    out.print("error: unknown command '%s' (try help)\n", argv[0]);
+  }
+
+  uint32_t executed() const { return executed_; }
+  uint32_t errors() const { return errors_; }
+
+private:
+  const ShellCommand* table_;
+  size_t count_;
+  char line_[LineMax];
+  size_t len_ = 0;
+  bool overflow_ = false;
+  uint32_t executed_ = 0, errors_ = 0;
+};
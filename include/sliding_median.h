@@ -0,0 +1,154 @@
+// ============================================================
+// 슬라이딩 중앙값 / Hampel 이상치 제거
+// ------------------------------------------------------------
+// SlidingMedian<N>: 인덱스 이중 힙 (max-힙 | 중앙값 | min-힙)
+//  - 한 배열에 두 힙을 마주 보게 배치, 위치 0 이 중앙값
+//  - 창에서 빠지는 값의 힙 위치를 pos[] 로 알고 있으므로
+//    재정렬 없이 그 자리에 새 값을 넣고 위/아래로만 이동 → O(log N)
+// Hampel<N, KTenths, FloorUs>:
+//  |x - med| > max(K * 1.4826 * MAD, Floor) 이면 x 대신 med 출력.
+//  MAD 는 편차 |x - med| 의 슬라이딩 중앙값으로 근사 (역시 O(log N)).
+// ============================================================
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+template <size_t N>
+class SlidingMedian {
+  static_assert(N >= 3 && N <= 0x7FFF, "SlidingMedian window out of range");
+
+public:
+  SlidingMedian(){ reset(); }
+
+  uint16_t push(uint16_t v){
+    if (!v) return value();
+    insert(v);
+    return value();
+  }
+
+  // 짝수 개일 때는 가운데 두 값의 평균
+  uint16_t value() const {
+    if (!ct_) return 0;
+    uint16_t v = data_[heap(0)];
+    if ((ct_ & 1) == 0) v = (uint16_t)((v + data_[heap(-1)]) / 2);
+    return v;
+  }
+
+  void reset(){
+    ct_ = 0; idx_ = 0;
+    // 초기 배치: 중앙, max, min, max, min ...
+    for (int k = 0; k < (int)N; ++k){
+      pos_[k] = (int16_t)(((k + 1) / 2) * ((k & 1) ? -1 : 1));
+      heap(pos_[k]) = (int16_t)k;
+      data_[k] = 0;
+    }
+  }
+
+  size_t count() const { return ct_; }
+
+private:
+  // ct_ <= N 이므로 상한은 항상 성립. 명시해 두면 GCC 가 힙 인덱스 범위를 증명한다
+  int minCt() const { const int c = ((int)ct_ - 1) / 2; return c < (int)((N - 1) / 2) ? c : (int)((N - 1) / 2); }
+  int maxCt() const { const int c = (int)ct_ / 2; return c < (int)(N / 2) ? c : (int)(N / 2); }
+
+  int16_t& heap(int i){ return heap_[i + (int)(N / 2)]; }
+  int16_t heap(int i) const { return heap_[i + (int)(N / 2)]; }
+
+  bool less(int i, int j) const { return data_[heap(i)] < data_[heap(j)]; }
+
+  bool exchange(int i, int j){
+    const int16_t t = heap(i); heap(i) = heap(j); heap(j) = t;
+    pos_[heap(i)] = (int16_t)i;
+    pos_[heap(j)] = (int16_t)j;
+    return true;
+  }
+
+  // i 가 j 보다 작으면 교환
+  bool cmpExch(int i, int j){ return less(i, j) && exchange(i, j); }
+
+  void minSortDown(int i){
+    for (; i <= minCt(); i *= 2){
+      if (i > 1 && i < minCt() && less(i + 1, i)) ++i;
+      if (!cmpExch(i, i / 2)) break;
+    }
+  }
+
+  void maxSortDown(int i){
+    for (; i >= -maxCt(); i *= 2){
+      if (i < -1 && i > -maxCt() && less(i, i - 1)) --i;
+      if (!cmpExch(i / 2, i)) break;
+    }
+  }
+
+  // 중앙값 자리까지 올라가면 true
+  bool minSortUp(int i){
+    while (i > 0 && cmpExch(i, i / 2)) i /= 2;
+    return i == 0;
+  }
+
+  bool maxSortUp(int i){
+    while (i < 0 && cmpExch(i / 2, i)) i /= 2;
+    return i == 0;
+  }
+
+  void insert(uint16_t v){
+    const bool isNew = ct_ < N;
+    const int p = pos_[idx_];
+    const uint16_t old = data_[idx_];
+    data_[idx_] = v;
+    if (++idx_ >= N) idx_ = 0;
+    if (isNew) ct_++;
+
+    if (p > 0){
+      if (!isNew && old < v) minSortDown(p * 2);
+      else if (minSortUp(p)) maxSortDown(-1);
+    } else if (p < 0){
+      if (!isNew && v < old) maxSortDown(p * 2);
+      else if (maxSortUp(p)) minSortDown(1);
+    } else {
+      if (maxCt()) maxSortDown(-1);
+      if (minCt()) minSortDown(1);
+    }
+  }
+
+  uint16_t data_[N];
+  int16_t pos_[N];
+  int16_t heap_[N];
+  size_t ct_ = 0;
+  size_t idx_ = 0;
+};
+
+template <size_t N, uint16_t KTenths = 30, uint16_t FloorUs = 3>
+class Hampel {
+public:
+  uint16_t push(uint16_t v){
+    if (!v) return last_;
+    const uint16_t med = median_.push(v);
+    const uint16_t dev = (uint16_t)(v > med ? v - med : med - v);
+    // MAD 창에는 0 이 "빈 칸"이므로 +1 오프셋으로 저장
+    const uint16_t mad = (uint16_t)(mad_.push((uint16_t)(dev + 1)) - 1);
+
+    // K * 1.4826 * MAD  (1.4826 ≈ 759/512)
+    uint32_t limit = ((uint32_t)mad * 759u * KTenths) / (512u * 10u);
+    if (limit < FloorUs) limit = FloorUs;
+
+    if (median_.count() >= N / 2 + 1 && dev > limit){
+      rejects_++;
+      last_ = med;
+    } else {
+      last_ = v;
+    }
+    return last_;
+  }
+
+  void reset(){ median_.reset(); mad_.reset(); last_ = 0; }
+
+  uint32_t rejects() const { return rejects_; }
+
+private:
+  SlidingMedian<N> median_;
+  SlidingMedian<N> mad_;
+  uint16_t last_ = 0;
+  uint32_t rejects_ = 0;
+};
@@ -0,0 +1,58 @@
+// ============================================================
+// 대기 없는(wait-free) 단일 생산자 / 단일 소비자 링 버퍼
+// ------------------------------------------------------------
+// 생산자(ISR)와 소비자(태스크)가 서로를 막지 않는다.
+//  - 인덱스는 자유 증가 uint32 + 마스크 (N 은 2의 거듭제곱)
+//  - 가득 차면 새 항목을 버리고 overruns 증가 (기존 항목 보존)
+//  - 생산자: push 만, 소비자: pop/size 만 호출
+// ============================================================
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+template <typename T, size_t N>
+class SpscRing {
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscRing size must be a power of two");
+
+public:
+  // 생산자 전용
+  bool push(const T& item){
+    const uint32_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) >= N){
+      overruns_.store(overruns_.load(std::memory_order_relaxed) + 1,
+                      std::memory_order_relaxed);
+      return false;
+    }
+    buf_[head & (N - 1)] = item;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // 소비자 전용
+  bool pop(T& out){
+    const uint32_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail == head_.load(std::memory_order_acquire)) return false;
+    out = buf_[tail & (N - 1)];
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  size_t size() const {
+    return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+  }
+
+  bool empty() const { return size() == 0; }
+
+  static constexpr size_t capacity(){ return N; }
+
+  // 생산자가 버린 항목 수 (누적)
+  uint32_t overruns() const { return overruns_.load(std::memory_order_relaxed); }
+
+private:
+  T buf_[N];
+  std::atomic<uint32_t> head_{0};
+  std::atomic<uint32_t> tail_{0};
+  std::atomic<uint32_t> overruns_{0};
+};
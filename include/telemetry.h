@@ -0,0 +1,249 @@
+// ============================================================
+// 바이너리 텔레메트리 (순수 로직, 타깃 / 호스트 공용)
+// ------------------------------------------------------------
+// 처리한 샘플마다 패킷 하나. 텍스트 로그와 같은 USB CDC 로 섞여 나가도
+// 수신 측이 구분할 수 있도록 COBS 프레이밍 + CRC.
+//   프레임 = COBS(type | payload | crc16 LE) 0x00
+//   - COBS: 프레임 안에 0x00 이 없다 → 0x00 에서 언제든 재동기
+//   - CRC-16/CCITT-FALSE (0x1021, 초기값 0xFFFF), type + payload 대상
+//   - 송신 묶음마다 앞에 0x00 하나 → 사이에 끼어든 텍스트는 버려지는 프레임 1개
+// 샘플 패킷 21바이트 (500 샘플/s ≈ 10.5kB/s). seq 로 수신 측이 누락을 센다.
+// 타깃 send_nb 는 호출당 64바이트 패킷 하나 → 송신 태스크가 1ms 마다 이어 보내면 약 64kB/s.
+//
+// TelemetryTx: 더블 버퍼 송신 큐
+//   생산자(taskRcInput) 1 + 소비자(송신 태스크) 1, 락 없음.
+//   ctl_ = (채우는 버퍼 번호 << 31) | 확정 길이.
+//   생산자는 채우는 버퍼 끝에 인코딩 후 CAS 로 길이 확정,
+//   소비자는 이전 버퍼를 다 보낸 뒤에만 CAS 로 버퍼 교체 → 보내는 중인 버퍼엔 아무도 안 씀.
+//   자리가 없으면 (소비자가 밀림) 버리고 drops 증가. 생산자는 절대 기다리지 않는다.
+// TelemetryDecoder: 호스트용 스트림 복호기 (바이트 열 → 샘플 콜백 + 오류 통계)
+// ============================================================
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+
+enum : uint8_t {
+  TELEM_SAMPLE = 1,
+};
+
+// 와이어 형식 그대로 (리틀 엔디언, 패딩 없음)
+struct TelemetrySample {
+  uint32_t seq;        // 샘플 게시 번호 (빈 번호 = 누락)
+  uint32_t tMicros;    // 하강 에지 시각
+  uint16_t rawUs;
+  uint16_t avgUs;
+  int16_t percent;
+  uint16_t flags;      // SAMPLE_* (main.cpp)
+};
+static_assert(sizeof(TelemetrySample) == 16, "TelemetrySample must be packed");
+
+// type + 최대 payload + CRC
+static const size_t TELEM_MAX_PACKET = 1 + sizeof(TelemetrySample) + 2;
+// COBS 최악 오버헤드 (254바이트당 1) + 구분자
+static const size_t TELEM_MAX_FRAME = TELEM_MAX_PACKET + TELEM_MAX_PACKET / 254 + 1 + 1;
+
+// ------------------ CRC / COBS ------------------
+
+inline uint16_t telemCrc16(const uint8_t* p, size_t n, uint16_t crc = 0xFFFF){
+  // 니블 테이블 (16항목)
+  static const uint16_t T[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+  };
+  while (n--){
+    crc = (uint16_t)((crc << 4) ^ T[(crc >> 12) ^ (*p >> 4)]);
+    crc = (uint16_t)((crc << 4) ^ T[(crc >> 12) ^ (*p & 0x0F)]);
+    p++;
+  }
+  return crc;
+}
+
+// in[0..n) → out (구분자 제외). 반환 = 쓴 바이트 수 (최대 n + n/254 + 1)
+inline size_t cobsEncode(const uint8_t* in, size_t n, uint8_t* out){
+  size_t code = 0, o = 1;
+  uint8_t run = 1;
+  for (size_t i = 0; i < n; ++i){
+    if (in[i]){
+      out[o++] = in[i];
+      run++;
+    }
+    if (!in[i] || run == 0xFF){
+      out[code] = run;
+      code = o++;
+      run = 1;
+    }
+  }
+  out[code] = run;
+  return o;
+}
+
+// 프레임 (구분자 제외) → out. 형식 오류 / cap 초과면 0
+inline size_t cobsDecode(const uint8_t* in, size_t n, uint8_t* out, size_t cap){
+  size_t o = 0, i = 0;
+  while (i < n){
+    const uint8_t code = in[i++];
+    if (!code) return 0;
+    for (uint8_t k = 1; k < code; ++k){
+      if (i >= n || !in[i] || o >= cap) return 0;
+      out[o++] = in[i++];
+    }
+    if (code != 0xFF && i < n){
+      if (o >= cap) return 0;
+      out[o++] = 0;
+    }
+  }
+  return o;
+}
+
+// type + payload 를 CRC 붙여 COBS 프레임으로 (구분자 포함). 반환 = 프레임 길이
+inline size_t telemEncodeFrame(uint8_t type, const void* payload, size_t n, uint8_t* out){
+  uint8_t pkt[TELEM_MAX_PACKET];
+  if (n + 3 > sizeof(pkt)) return 0;
+  pkt[0] = type;
+  memcpy(pkt + 1, payload, n);
+  const uint16_t crc = telemCrc16(pkt, n + 1);
+  pkt[n + 1] = (uint8_t)crc;
+  pkt[n + 2] = (uint8_t)(crc >> 8);
+  const size_t len = cobsEncode(pkt, n + 3, out);
+  out[len] = 0;
+  return len + 1;
+}
+
+// ------------------ 송신 큐 (더블 버퍼) ------------------
+
+template <size_t Bytes>
+class TelemetryTx {
+  static_assert(Bytes >= 2 * TELEM_MAX_FRAME && Bytes < (1u << 31), "TelemetryTx buffer size");
+
+public:
+  // 생산자 전용. 자리가 없으면 false (drops 증가)
+  bool push(uint8_t type, const void* payload, size_t n){
+    uint8_t frame[TELEM_MAX_FRAME];
+    const size_t flen = telemEncodeFrame(type, payload, n, frame);
+    if (!flen) return false;
+
+    uint32_t ctl = ctl_.load(std::memory_order_acquire);
+    while (true){
+      const uint32_t idx = ctl >> 31;
+      const uint32_t len = ctl & LEN_MASK;
+      // 새 묶음은 구분자로 시작 (앞에 끼어든 텍스트를 끊어 줌)
+      const size_t lead = len ? 0 : 1;
+      if (len + lead + flen > Bytes){
+        drops_.store(drops_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return false;
+      }
+      uint8_t* dst = buf_[idx] + len;
+      if (lead) *dst++ = 0;
+      memcpy(dst, frame, flen);
+      const uint32_t next = (idx << 31) | (uint32_t)(len + lead + flen);
+      // 실패 = 그 사이 소비자가 버퍼를 바꿈 → 새 버퍼에 다시
+      if (ctl_.compare_exchange_weak(ctl, next, std::memory_order_acq_rel, std::memory_order_acquire)){
+        frames_.store(frames_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+  }
+
+  // 소비자 전용. write(const uint8_t*, size_t) → 지금 보낸 바이트 수 (0 = 엔드포인트 바쁨, 나중에 재시도)
+  // 보내던 묶음을 0 이 나올 때까지 이어 보내고, 다 보냈으면 다음 묶음 하나만 넘겨받는다 (호출당 최대 1개).
+  // 반환 = 아직 보낼 것이 남았는가. sending() 이면 묶음 중간 (끝날 때까지 다른 바이트를 섞지 말 것)
+  template <typename Write>
+  bool drain(Write write){
+    if (sendOff_ == sendLen_ && !takeBatch()) return false;
+    while (sendOff_ < sendLen_){
+      const size_t n = write(sendBuf_ + sendOff_, sendLen_ - sendOff_);
+      if (!n) return true;
+      sendOff_ += n;
+    }
+    bytes_ += sendLen_;
+    return (ctl_.load(std::memory_order_acquire) & LEN_MASK) != 0;
+  }
+
+  // 넘겨받은 묶음을 아직 다 못 보냄 (소비자 전용)
+  bool sending() const { return sendOff_ < sendLen_; }
+
+  // 확정됐지만 아직 안 보낸 바이트 (소비자 전용)
+  size_t pending() const { return (sendLen_ - sendOff_) + (ctl_.load(std::memory_order_acquire) & LEN_MASK); }
+
+  uint32_t frames() const { return frames_.load(std::memory_order_relaxed); }
+  uint32_t drops() const { return drops_.load(std::memory_order_relaxed); }
+  uint32_t bytesSent() const { return bytes_; }   // 소비자 전용
+
+private:
+  static const uint32_t IDX_BIT = 1u << 31;
+  static const uint32_t LEN_MASK = IDX_BIT - 1;
+
+  // 채우는 버퍼를 넘겨받음 (비었으면 false). 보내던 버퍼가 빈 뒤에만
+  bool takeBatch(){
+    uint32_t ctl = ctl_.load(std::memory_order_acquire);
+    do {
+      if (!(ctl & LEN_MASK)){ sendOff_ = sendLen_ = 0; return false; }
+    } while (!ctl_.compare_exchange_weak(ctl, (~ctl) & IDX_BIT,
+                                         std::memory_order_acq_rel, std::memory_order_acquire));
+    sendBuf_ = buf_[ctl >> 31];
+    sendLen_ = ctl & LEN_MASK;
+    sendOff_ = 0;
+    return true;
+  }
+
+  uint8_t buf_[2][Bytes];
+  std::atomic<uint32_t> ctl_{0};
+  std::atomic<uint32_t> frames_{0};
+  std::atomic<uint32_t> drops_{0};
+
+  const uint8_t* sendBuf_ = nullptr;
+  size_t sendLen_ = 0;
+  size_t sendOff_ = 0;
+  uint32_t bytes_ = 0;
+};
+
+// ------------------ 호스트 복호기 ------------------
+
+class TelemetryDecoder {
+public:
+  // onSample(const TelemetrySample&). 임의 단위로 잘라 넣어도 됨
+  template <typename Fn>
+  void feed(const uint8_t* p, size_t n, Fn onSample){
+    for (size_t i = 0; i < n; ++i){
+      const uint8_t b = p[i];
+      if (b){
+        if (len_ < sizeof(frame_)) frame_[len_] = b;
+        len_++;
+        continue;
+      }
+      if (len_) endFrame(onSample);
+      len_ = 0;
+    }
+  }
+
+  uint32_t samples() const { return samples_; }
+  uint32_t crcErrors() const { return crcErrors_; }
+  uint32_t badFrames() const { return badFrames_; }   // COBS 오류 / 길이 불일치 / 모르는 type (끼어든 텍스트 포함)
+  uint32_t lost() const { return lost_; }             // seq 빈 번호 합계 (송신 측 drops + 전송 손실)
+
+private:
+  template <typename Fn>
+  void endFrame(Fn& onSample){
+    uint8_t pkt[TELEM_MAX_PACKET];
+    const size_t n = len_ <= sizeof(frame_) ? cobsDecode(frame_, len_, pkt, sizeof(pkt)) : 0;
+    if (n < 3){ badFrames_++; return; }
+    const uint16_t crc = (uint16_t)(pkt[n - 2] | (pkt[n - 1] << 8));
+    if (telemCrc16(pkt, n - 2) != crc){ crcErrors_++; return; }
+    if (pkt[0] != TELEM_SAMPLE || n - 3 != sizeof(TelemetrySample)){ badFrames_++; return; }
+
+    TelemetrySample s;
+    memcpy(&s, pkt + 1, sizeof(s));
+    if (samples_ && s.seq - lastSeq_ > 1 && s.seq - lastSeq_ < 0x80000000u) lost_ += s.seq - lastSeq_ - 1;
+    lastSeq_ = s.seq;
+    samples_++;
+    onSample(s);
+  }
+
+  uint8_t frame_[TELEM_MAX_FRAME];
+  size_t len_ = 0;
+  uint32_t lastSeq_ = 0;
+  uint32_t samples_ = 0, crcErrors_ = 0, badFrames_ = 0, lost_ = 0;
+};
@@ -0,0 +1,138 @@
+// ============================================================
+// 해시 타이밍 휠 (Varghese & Lauck)
+// ------------------------------------------------------------
+// 슬롯 = 만기 틱 mod Slots, 한 바퀴 넘는 지연은 rounds 로 센다.
+//  - 등록 / 취소 O(1) (슬롯별 이중 연결 리스트, 고정 노드 풀)
+//  - 틱당 비용은 그 슬롯에 걸린 타이머 수뿐 → 동시 타이머가 많아도 O(1)
+//  - 시간원은 호출자가 넘기는 틱 값 (호스트에선 가상 시계)
+// ============================================================
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+template <size_t Slots, size_t MaxTimers>
+class TimingWheel {
+  static_assert(Slots >= 2 && (Slots & (Slots - 1)) == 0, "TimingWheel slots must be a power of two");
+  static_assert(MaxTimers >= 1 && MaxTimers < 0xFFFF, "TimingWheel capacity");
+
+public:
+  typedef void (*Handler)(void* ctx, uint32_t arg);
+  typedef uint32_t Handle;                       // (세대 << 16) | 노드 번호
+  static const Handle INVALID = 0xFFFFFFFFu;
+
+  TimingWheel(){ reset(0); }
+
+  void reset(uint32_t nowTick){
+    cur_ = nowTick;
+    for (size_t s = 0; s < Slots; ++s) head_[s] = NIL;
+    free_ = NIL;
+    for (size_t i = MaxTimers; i-- > 0; ){
+      nodes_[i].used = false;
+      nodes_[i].next = free_;
+      free_ = (uint16_t)i;
+    }
+    active_ = 0;
+  }
+
+  // delayTicks 틱 뒤 fn(ctx, arg) 호출 (최소 1틱)
+  Handle schedule(uint32_t delayTicks, Handler fn, void* ctx, uint32_t arg){
+    if (free_ == NIL || !fn) return INVALID;
+    if (!delayTicks) delayTicks = 1;
+
+    const uint16_t i = free_;
+    Node& n = nodes_[i];
+    free_ = n.next;
+
+    n.used = true;
+    n.gen++;
+    n.fn = fn;
+    n.ctx = ctx;
+    n.arg = arg;
+    n.rounds = (delayTicks - 1) / Slots;
+    n.slot = (uint16_t)((cur_ + delayTicks) & (Slots - 1));
+    link(i);
+    active_++;
+    return ((Handle)n.gen << 16) | i;
+  }
+
+  bool cancel(Handle h){
+    const uint16_t i = (uint16_t)(h & 0xFFFF);
+    if (h == INVALID || i >= MaxTimers) return false;
+    Node& n = nodes_[i];
+    if (!n.used || n.gen != (uint16_t)(h >> 16)) return false;
+    unlink(i);
+    release(i);
+    return true;
+  }
+
+  // nowTick 까지 한 틱씩 진행하며 만기 타이머 실행 (과거 시각은 무시)
+  void advance(uint32_t nowTick){
+    while ((int32_t)(nowTick - cur_) > 0){
+      cur_++;
+      const size_t s = cur_ & (Slots - 1);
+      uint16_t i = head_[s];
+      while (i != NIL){
+        Node& n = nodes_[i];
+        const uint16_t next = n.next;       // 핸들러가 새 타이머를 머리에 넣어도 안전
+        if (n.rounds){
+          n.rounds--;
+        } else {
+          unlink(i);
+          const Handler fn = n.fn;
+          void* const ctx = n.ctx;
+          const uint32_t arg = n.arg;
+          release(i);
+          fn(ctx, arg);
+        }
+        i = next;
+      }
+    }
+  }
+
+  uint32_t now() const { return cur_; }
+  size_t active() const { return active_; }
+
+private:
+  static const uint16_t NIL = 0xFFFF;
+
+  struct Node {
+    uint16_t next = NIL;
+    uint16_t prev = NIL;
+    uint16_t slot = 0;
+    uint16_t gen = 0;
+    uint32_t rounds = 0;
+    Handler fn = nullptr;
+    void* ctx = nullptr;
+    uint32_t arg = 0;
+    bool used = false;
+  };
+
+  void link(uint16_t i){
+    Node& n = nodes_[i];
+    n.prev = NIL;
+    n.next = head_[n.slot];
+    if (n.next != NIL) nodes_[n.next].prev = i;
+    head_[n.slot] = i;
+  }
+
+  void unlink(uint16_t i){
+    Node& n = nodes_[i];
+    if (n.prev != NIL) nodes_[n.prev].next = n.next;
+    else head_[n.slot] = n.next;
+    if (n.next != NIL) nodes_[n.next].prev = n.prev;
+  }
+
+  void release(uint16_t i){
+    nodes_[i].used = false;
+    nodes_[i].next = free_;
+    free_ = i;
+    active_--;
+  }
+
+  Node nodes_[MaxTimers];
+  uint16_t head_[Slots];
+  uint16_t free_ = NIL;
+  uint32_t cur_ = 0;
+  size_t active_ = 0;
+};
@@ -0,0 +1,120 @@
+// ============================================================
+// RC 에지 트레이스 (순수 로직)
+// ------------------------------------------------------------
+// 현장에서 에지 시각을 압축 기록 → 호스트에서 그대로 재생.
+// 청크 단위 (헤더 + 가변 길이 데이터), 청크마다 독립 복호 가능
+// → 중간 청크가 유실돼도 나머지는 재생된다.
+//   에지 1개 = varint((Δt_us << 1) | level)   (50Hz RC 기준 평균 약 2.5바이트)
+// 헤더에 청크 번호 / 기준 시각 / 그 시점 보정값을 함께 싣는다 (seq 0 = 부팅 직후).
+// 전송: 바이너리 그대로, 또는 Serial 로 "#T <hex>" 한 줄에 청크 하나.
+// ============================================================
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+static const uint32_t TRACE_MAGIC = 0x52544352;   // 파일 바이트 "RCTR" (리틀 엔디언)
+static const uint16_t TRACE_VERSION = 1;
+static const size_t TRACE_CHUNK_DATA = 232;
+
+struct TraceChunkHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t bytes;       // 데이터 길이
+  uint32_t seq;         // 청크 번호 (0 = 부팅 직후)
+  uint32_t startUs;     // 첫 델타의 기준 시각 [µs, micros]
+  uint16_t calMin;      // 청크 시작 시 보정값
+  uint16_t calMax;
+};
+
+struct TraceChunk {
+  TraceChunkHeader h;
+  uint8_t data[TRACE_CHUNK_DATA];
+
+  size_t wireSize() const { return sizeof(TraceChunkHeader) + h.bytes; }
+};
+
+// 청크 하나를 채우는 인코더
+class TraceWriter {
+public:
+  void begin(uint32_t seq, uint32_t startUs, uint16_t calMin, uint16_t calMax){
+    chunk_.h.magic = TRACE_MAGIC;
+    chunk_.h.version = TRACE_VERSION;
+    chunk_.h.bytes = 0;
+    chunk_.h.seq = seq;
+    chunk_.h.startUs = startUs;
+    chunk_.h.calMin = calMin;
+    chunk_.h.calMax = calMax;
+    lastUs_ = startUs;
+  }
+
+  // 공간이 없으면 false (호출자가 청크를 내보내고 begin 후 재시도)
+  bool add(uint32_t tUs, bool high){
+    if (!hasRoom(1)) return false;
+    uint32_t delta = tUs - lastUs_;
+    if (delta > 0x7FFFFFFFu) delta = 0x7FFFFFFFu;   // 35분 넘는 공백은 잘림
+    lastUs_ = tUs;
+    uint32_t v = (delta << 1) | (high ? 1u : 0u);
+    uint8_t* p = chunk_.data + chunk_.h.bytes;
+    while (v >= 0x80){ *p++ = (uint8_t)(v | 0x80); v >>= 7; }
+    *p++ = (uint8_t)v;
+    chunk_.h.bytes = (uint16_t)(p - chunk_.data);
+    return true;
+  }
+
+  // 에지 edges 개를 더 넣을 자리가 있는가 (에지당 최대 5바이트)
+  bool hasRoom(size_t edges) const { return chunk_.h.bytes + edges * 5 <= TRACE_CHUNK_DATA; }
+  bool empty() const { return chunk_.h.bytes == 0; }
+  const TraceChunk& chunk() const { return chunk_; }
+
+private:
+  TraceChunk chunk_ = {};
+  uint32_t lastUs_ = 0;
+};
+
+// 청크 하나 (헤더 + 데이터) 복호. onEdge(uint32_t tUs, bool high). 형식 오류면 false
+template <typename Fn>
+bool traceDecodeChunk(const uint8_t* buf, size_t len, TraceChunkHeader& h, Fn onEdge){
+  if (len < sizeof(TraceChunkHeader)) return false;
+  memcpy(&h, buf, sizeof(h));
+  if (h.magic != TRACE_MAGIC || h.version != TRACE_VERSION) return false;
+  if (h.bytes > TRACE_CHUNK_DATA || sizeof(h) + h.bytes > len) return false;
+
+  const uint8_t* p = buf + sizeof(h);
+  const uint8_t* end = p + h.bytes;
+  uint32_t t = h.startUs;
+  while (p < end){
+    uint32_t v = 0;
+    int shift = 0;
+    uint8_t b;
+    do {
+      if (p >= end || shift > 28) return false;
+      b = *p++;
+      v |= (uint32_t)(b & 0x7F) << shift;
+      shift += 7;
+    } while (b & 0x80);
+    t += v >> 1;
+    onEdge(t, (v & 1u) != 0);
+  }
+  return true;
+}
+
+// "#T <hex>" 한 줄 → 바이트. 반환 = 바이트 수 (형식이 아니면 0)
+inline size_t traceParseHexLine(const char* line, uint8_t* out, size_t cap){
+  if (line[0] != '#' || line[1] != 'T' || line[2] != ' ') return 0;
+  size_t n = 0;
+  for (const char* s = line + 3; s[0] && s[1] && n < cap; s += 2){
+    uint8_t v = 0;
+    for (int k = 0; k < 2; ++k){
+      const char c = s[k];
+      v = (uint8_t)(v << 4);
+      if (c >= '0' && c <= '9') v |= (uint8_t)(c - '0');
+      else if (c >= 'a' && c <= 'f') v |= (uint8_t)(c - 'a' + 10);
+      else if (c >= 'A' && c <= 'F') v |= (uint8_t)(c - 'A' + 10);
+      else return n;
+    }
+    out[n++] = v;
+  }
+  return n;
+}
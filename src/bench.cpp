@@ -0,0 +1,83 @@
+// ============================================================
+// 마이크로 벤치마크 하니스 구현 (타이머 + JSON 출력)
+// ============================================================
+
+#include "hal.h"
+#include "bench.h"
+
+volatile uint32_t gBenchSink = 0;
+
+#if defined(ARDUINO)
+
+void benchBegin(){
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->LAR = 0xC5ACCE55;             // M7: DWT 쓰기 잠금 해제
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+uint32_t benchNow(){
+  return DWT->CYCCNT;
+}
+
+const char* benchUnit(){
+  return "cycles";
+}
+
+#else  // 호스트
+
+#include <stdlib.h>
+#include <chrono>
+
+void benchBegin(){}
+
+uint32_t benchNow(){
+  using namespace std::chrono;
+  return (uint32_t)duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+const char* benchUnit(){
+  return "ns";
+}
+
+#endif
+
+void benchConfig(const BenchParam* params, size_t n){
+  Serial.print("{\"bench_config\":{\"unit\":\"");
+  Serial.print(benchUnit());
+  Serial.print("\"");
+  for (size_t i = 0; i < n; ++i){
+    Serial.print(",\"");
+    Serial.print(params[i].key);
+    Serial.print("\":");
+    Serial.print(params[i].value);
+  }
+  Serial.println("}}");
+}
+
+void benchReport(const BenchResult& r){
+  Serial.print("{\"bench\":\"");
+  Serial.print(r.name);
+  Serial.print("\",\"unit\":\"");
+  Serial.print(benchUnit());
+  Serial.print("\",\"ops\":");
+  Serial.print((unsigned long)r.opsPerRound);
+  Serial.print(",\"rounds\":");
+  Serial.print((unsigned long)r.rounds);
+  Serial.print(",\"min\":");
+  Serial.print(r.minPerOp, 2);
+  Serial.print(",\"median\":");
+  Serial.print(r.medianPerOp, 2);
+  Serial.print(",\"max\":");
+  Serial.print(r.maxPerOp, 2);
+  Serial.println("}");
+}
+
+void benchFinish(){
+  Serial.print("{\"bench_done\":true,\"sink\":");
+  Serial.print((unsigned long)gBenchSink);
+  Serial.println("}");
+#if !defined(ARDUINO)
+  exit(0);
+#endif
+}
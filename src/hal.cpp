@@ -0,0 +1,492 @@
+// ============================================================
+// HAL 구현
+// ------------------------------------------------------------
+// 타깃: 워치독(IWDG1), USB CDC 비차단 쓰기. 나머지는 Arduino 코어 / mbed OS 가 제공
+// 호스트: hal_native.h 전체 (가상 시계, 핀 주입, Ticker 스레드, main)
+// ============================================================
+
+#include "hal.h"
+
+#if defined(ARDUINO)
+
+void halWatchdogBegin(uint32_t timeoutMs){
+  IWDG1->KR = 0x5555;
+  IWDG1->PR = 4;
+  IWDG1->RLR = (timeoutMs * 32);
+  IWDG1->KR = 0xCCCC;
+}
+
+void halWatchdogKick(){
+  IWDG1->KR = 0xAAAA;
+}
+
+size_t halSerialWriteSome(const uint8_t* buf, size_t len){
+  if (!Serial || !len) return 0;
+  // USBCDC::send_nb: 엔드포인트가 바쁘면 0, 아니면 패킷 하나만큼 보내고 바로 반환
+  uint32_t sent = 0;
+  Serial.send_nb(const_cast<uint8_t*>(buf), (uint32_t)len, &sent, true);
+  return sent;
+}
+
+#else  // 호스트
+
+#include <stdio.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+
+namespace {
+
+using namespace std::chrono;
+
+const uint64_t FOREVER_US = ~0ull;
+
+// 프로세스 종료 시 분리된 스레드가 쓰고 있을 수 있으므로 소멸시키지 않는다
+std::mutex& waitLock(){ static std::mutex* m = new std::mutex; return *m; }
+std::condition_variable& waitCv(){ static std::condition_variable* c = new std::condition_variable; return *c; }
+std::recursive_mutex& irqLock(){ static std::recursive_mutex* m = new std::recursive_mutex; return *m; }
+std::vector<mbed::Ticker*>& tickers(){ static std::vector<mbed::Ticker*>* v = new std::vector<mbed::Ticker*>; return *v; }
+
+const steady_clock::time_point sEpoch = steady_clock::now();
+std::atomic<bool> sManual{ false };
+std::atomic<uint64_t> sVirtualUs{ 0 };
+
+uint64_t realUs(){
+  return (uint64_t)duration_cast<microseconds>(steady_clock::now() - sEpoch).count();
+}
+
+uint64_t nowUs(){
+  return sManual.load() ? sVirtualUs.load() : realUs();
+}
+
+// 가상 시계 진행과 Ticker 처리의 동기화 (waitLock 보호)
+uint64_t sTimerDoneUs = 0;
+uint32_t sTickerGen = 0;
+bool sTimerThread = false;
+
+// 작업 스레드(태스크 / Ticker) 대기 목록 (waitLock 보호) → halSettle / halClockAdvanceUs
+struct Parked {
+  std::function<bool()> ready;
+  uint64_t deadlineUs;
+};
+std::vector<Parked*> sParked;
+uint32_t sWorkers = 0;
+thread_local bool tWorker = false;
+
+// pred 가 참이 되거나 deadline 이 지날 때까지 대기 (lk = waitLock 보유)
+template <typename Pred>
+bool waitUntil(std::unique_lock<std::mutex>& lk, uint64_t deadlineUs, Pred pred){
+  if (pred()) return true;
+  if (nowUs() >= deadlineUs) return false;
+
+  Parked me{ [&]{ return pred(); }, deadlineUs };
+  if (tWorker){
+    sParked.push_back(&me);
+    waitCv().notify_all();
+  }
+  bool ok = true;
+  while (!pred()){
+    const uint64_t now = nowUs();
+    if (now >= deadlineUs){ ok = false; break; }
+    if (!sManual.load() && deadlineUs != FOREVER_US){
+      waitCv().wait_for(lk, microseconds(deadlineUs - now));
+    } else if (!sManual.load()){
+      waitCv().wait(lk);
+    } else {
+      // 가상 시계: 시각은 halClockAdvanceUs 가 알려 준다. 모드 전환 대비로 짧게 재확인
+      waitCv().wait_for(lk, milliseconds(50));
+    }
+  }
+  if (tWorker) sParked.erase(std::find(sParked.begin(), sParked.end(), &me));
+  return ok;
+}
+
+// 모든 작업 스레드가 아직 오지 않은 사건을 기다리는 중인가 (lk 보유)
+bool workersIdle(){
+  const uint64_t now = nowUs();
+  for (Parked* p : sParked){
+    if (p->ready() || p->deadlineUs <= now) return false;
+  }
+  return sParked.size() >= sWorkers;
+}
+
+bool waitIdle(std::unique_lock<std::mutex>& lk, uint32_t timeoutMs){
+  const steady_clock::time_point until = steady_clock::now() + milliseconds(timeoutMs);
+  while (!workersIdle()){
+    if (steady_clock::now() >= until) return false;
+    waitCv().wait_for(lk, milliseconds(1));
+  }
+  return true;
+}
+
+// 대기 중인 작업 스레드 중 가장 이른 기한 (없으면 FOREVER_US)
+uint64_t nextWorkerDeadline(){
+  uint64_t next = FOREVER_US;
+  for (Parked* p : sParked) if (p->deadlineUs < next) next = p->deadlineUs;
+  return next;
+}
+
+uint64_t deadlineAfter(uint64_t relUs){
+  return relUs >= FOREVER_US - nowUs() ? FOREVER_US : nowUs() + relUs;
+}
+
+// ------------------ 핀 ------------------
+
+struct PinState {
+  uint8_t level = LOW;
+  uint8_t mode = INPUT;
+  uint8_t irqMode = 0;
+  void (*isr)() = nullptr;
+};
+PinState sPins[HAL_PIN_COUNT];
+
+// ------------------ Ticker 스레드 ------------------
+
+void timerThread(){
+  tWorker = true;
+  std::unique_lock<std::mutex> lk(waitLock());
+  while (true){
+    uint64_t next = FOREVER_US;
+    mbed::Ticker* due = nullptr;
+    for (mbed::Ticker* t : tickers()){
+      if (t->active_ && t->nextUs_ < next){ next = t->nextUs_; due = t; }
+    }
+
+    const uint64_t now = nowUs();
+    if (due && next <= now){
+      due->nextUs_ += due->periodUs_;
+      lk.unlock();
+      {
+        // ISR 문맥: 인터럽트 락을 잡고 실행. 그 사이 detach 됐으면 건너뜀
+        // (detach 도 인터럽트 락을 잡으므로 실행 중에는 active_ 가 바뀌지 않음)
+        std::lock_guard<std::recursive_mutex> irq(irqLock());
+        std::function<void()> fn;
+        {
+          std::lock_guard<std::mutex> g(waitLock());
+          if (due->active_) fn = due->fn_;
+        }
+        if (fn) fn();
+      }
+      lk.lock();
+      continue;
+    }
+
+    // 만기된 것이 없다 → 가상 시계 진행자에게 여기까지 처리했다고 알림
+    sTimerDoneUs = now;
+    waitCv().notify_all();
+
+    const uint32_t gen = sTickerGen;
+    waitUntil(lk, next, [&]{ return sTickerGen != gen; });
+  }
+}
+
+void ensureTimerThread(){
+  // waitLock 보유 상태에서 호출
+  if (sTimerThread) return;
+  sTimerThread = true;
+  sWorkers++;
+  std::thread(timerThread).detach();
+}
+
+} // namespace
+
+// ------------------ 시간 ------------------
+
+uint32_t millis(){ return (uint32_t)(nowUs() / 1000); }
+uint32_t micros(){ return (uint32_t)nowUs(); }
+
+void delay(uint32_t ms){ rtos::ThisThread::sleep_for(rtos::Kernel::Clock::duration_u32(ms)); }
+
+void delayMicroseconds(uint32_t us){
+  std::unique_lock<std::mutex> lk(waitLock());
+  waitUntil(lk, nowUs() + us, []{ return false; });
+}
+
+void yield(){ std::this_thread::yield(); }
+
+// ------------------ 핀 / 인터럽트 ------------------
+
+void pinMode(pin_size_t pin, uint8_t mode){
+  if (pin < HAL_PIN_COUNT) sPins[pin].mode = mode;
+}
+
+int digitalRead(pin_size_t pin){
+  std::lock_guard<std::recursive_mutex> irq(irqLock());
+  return pin < HAL_PIN_COUNT ? sPins[pin].level : (int)LOW;
+}
+
+void digitalWrite(pin_size_t pin, uint8_t level){
+  std::lock_guard<std::recursive_mutex> irq(irqLock());
+  if (pin < HAL_PIN_COUNT) sPins[pin].level = level ? HIGH : LOW;
+}
+
+void attachInterrupt(pin_size_t pin, void (*isr)(), uint8_t mode){
+  std::lock_guard<std::recursive_mutex> irq(irqLock());
+  if (pin >= HAL_PIN_COUNT) return;
+  sPins[pin].isr = isr;
+  sPins[pin].irqMode = mode;
+}
+
+void detachInterrupt(pin_size_t pin){
+  std::lock_guard<std::recursive_mutex> irq(irqLock());
+  if (pin < HAL_PIN_COUNT) sPins[pin].isr = nullptr;
+}
+
+void noInterrupts(){ irqLock().lock(); }
+void interrupts(){ irqLock().unlock(); }
+void core_util_critical_section_enter(){ irqLock().lock(); }
+void core_util_critical_section_exit(){ irqLock().unlock(); }
+
+void halPinDrive(pin_size_t pin, uint8_t level){
+  std::lock_guard<std::recursive_mutex> irq(irqLock());
+  if (pin >= HAL_PIN_COUNT) return;
+  PinState& p = sPins[pin];
+  level = level ? HIGH : LOW;
+  if (p.level == level) return;
+  p.level = level;
+  const bool fire = p.isr && (p.irqMode == CHANGE ||
+                              (p.irqMode == RISING && level == HIGH) ||
+                              (p.irqMode == FALLING && level == LOW));
+  if (fire) p.isr();
+}
+
+// ------------------ 시계 제어 ------------------
+
+void halClockManual(bool manual){
+  std::lock_guard<std::mutex> g(waitLock());
+  if (manual && !sManual.load()) sVirtualUs.store(realUs());
+  sManual.store(manual);
+  waitCv().notify_all();
+}
+
+void halClockAdvanceUs(uint64_t us){
+  if (!sManual.load()) return;
+  const uint64_t target = halClockNowUs() + us;
+  std::unique_lock<std::mutex> lk(waitLock());
+  waitIdle(lk, 2000);
+  while (sVirtualUs.load() < target){
+    // 다음 Ticker 만기 / 태스크 기한까지만 한 걸음씩 → 깨어난 쪽이 자기 시각을 본다
+    uint64_t step = target;
+    for (mbed::Ticker* t : tickers()){
+      if (t->active_ && t->nextUs_ > sVirtualUs.load() && t->nextUs_ < step) step = t->nextUs_;
+    }
+    const uint64_t task = nextWorkerDeadline();
+    if (task > sVirtualUs.load() && task < step) step = task;
+    sVirtualUs.store(step);
+    sTickerGen++;
+    waitCv().notify_all();
+    if (sTimerThread) waitUntil(lk, FOREVER_US, [&]{ return sTimerDoneUs >= step; });
+    waitIdle(lk, 2000);
+  }
+}
+
+bool halSettle(uint32_t timeoutMs){
+  std::unique_lock<std::mutex> lk(waitLock());
+  return waitIdle(lk, timeoutMs);
+}
+
+uint64_t halClockNowUs(){ return nowUs(); }
+
+// ------------------ Serial ------------------
+
+HalSerial Serial;
+
+size_t HalSerial::print(const char* s){ return (size_t)printf("%s", s); }
+size_t HalSerial::print(char c){ return (size_t)printf("%c", c); }
+size_t HalSerial::print(int v){ return (size_t)printf("%d", v); }
+size_t HalSerial::print(unsigned int v){ return (size_t)printf("%u", v); }
+size_t HalSerial::print(long v){ return (size_t)printf("%ld", v); }
+size_t HalSerial::print(unsigned long v){ return (size_t)printf("%lu", v); }
+size_t HalSerial::print(double v, int digits){ return (size_t)printf("%.*f", digits, v); }
+
+namespace {
+
+std::mutex& inputLock(){ static std::mutex* m = new std::mutex; return *m; }
+std::deque<uint8_t>& inputQueue(){ static std::deque<uint8_t>* q = new std::deque<uint8_t>; return *q; }
+} // namespace
+
+void halSerialInject(const char* data, size_t len){
+  std::lock_guard<std::mutex> g(inputLock());
+  inputQueue().insert(inputQueue().end(), data, data + len);
+}
+
+int HalSerial::available(){
+  std::lock_guard<std::mutex> g(inputLock());
+  return (int)inputQueue().size();
+}
+
+int HalSerial::read(){
+  std::lock_guard<std::mutex> g(inputLock());
+  if (inputQueue().empty()) return -1;
+  const uint8_t b = inputQueue().front();
+  inputQueue().pop_front();
+  return b;
+}
+
+namespace {
+std::mutex& tapLock(){ static std::mutex* m = new std::mutex; return *m; }
+std::function<void(const uint8_t*, size_t)>& tapFn(){
+  static auto* f = new std::function<void(const uint8_t*, size_t)>;
+  return *f;
+}
+} // namespace
+
+void halSerialTap(std::function<void(const uint8_t*, size_t)> fn){
+  std::lock_guard<std::mutex> g(tapLock());
+  tapFn() = fn;
+}
+
+size_t halSerialWriteSome(const uint8_t* buf, size_t len){
+  {
+    std::lock_guard<std::mutex> g(tapLock());
+    if (tapFn()){
+      tapFn()(buf, len);
+      return len;
+    }
+  }
+  const size_t n = fwrite(buf, 1, len, stdout);
+  fflush(stdout);
+  return n;
+}
+
+// ------------------ rtos ------------------
+
+namespace rtos {
+
+uint32_t EventFlags::set(uint32_t flags){
+  std::lock_guard<std::mutex> g(waitLock());
+  flags_ |= flags;
+  waitCv().notify_all();
+  return flags_;
+}
+
+uint32_t EventFlags::clear(uint32_t flags){
+  std::lock_guard<std::mutex> g(waitLock());
+  const uint32_t old = flags_;
+  flags_ &= ~flags;
+  return old;
+}
+
+uint32_t EventFlags::get() const {
+  std::lock_guard<std::mutex> g(waitLock());
+  return flags_;
+}
+
+uint32_t EventFlags::wait_any_for(uint32_t flags, Kernel::Clock::duration_u32 rel, bool clear){
+  std::unique_lock<std::mutex> lk(waitLock());
+  const uint64_t deadline = rel == Kernel::wait_for_u32_forever
+                          ? FOREVER_US : deadlineAfter((uint64_t)rel.count() * 1000);
+  waitUntil(lk, deadline, [&]{ return (flags_ & flags) != 0; });
+  const uint32_t got = flags_;
+  if (clear) flags_ &= ~flags;
+  return got;
+}
+
+void Mutex::lock(){
+  std::unique_lock<std::mutex> lk(waitLock());
+  const std::thread::id me = std::this_thread::get_id();
+  waitUntil(lk, FOREVER_US, [&]{ return depth_ == 0 || owner_ == me; });
+  owner_ = me;
+  depth_++;
+}
+
+bool Mutex::trylock(){
+  std::lock_guard<std::mutex> g(waitLock());
+  const std::thread::id me = std::this_thread::get_id();
+  if (depth_ && owner_ != me) return false;
+  owner_ = me;
+  depth_++;
+  return true;
+}
+
+void Mutex::unlock(){
+  std::lock_guard<std::mutex> g(waitLock());
+  if (depth_ && --depth_ == 0){
+    owner_ = std::thread::id();
+    waitCv().notify_all();
+  }
+}
+
+void Thread::spawn(std::function<void()> fn){
+  {
+    std::lock_guard<std::mutex> g(waitLock());
+    sWorkers++;
+  }
+  std::thread([fn]{
+    tWorker = true;
+    fn();
+    std::lock_guard<std::mutex> g(waitLock());
+    sWorkers--;
+    waitCv().notify_all();
+  }).detach();
+}
+
+namespace ThisThread {
+
+void sleep_for(Kernel::Clock::duration_u32 rel){
+  std::unique_lock<std::mutex> lk(waitLock());
+  waitUntil(lk, deadlineAfter((uint64_t)rel.count() * 1000), []{ return false; });
+}
+
+void yield(){ std::this_thread::yield(); }
+
+} // namespace ThisThread
+
+} // namespace rtos
+
+// ------------------ Ticker ------------------
+
+namespace mbed {
+
+void Ticker::attach(std::function<void()> fn, std::chrono::microseconds period){
+  detach();
+  std::lock_guard<std::recursive_mutex> irq(irqLock());
+  std::lock_guard<std::mutex> g(waitLock());
+  fn_ = fn;
+  periodUs_ = period.count() > 0 ? (uint64_t)period.count() : 1;
+  nextUs_ = nowUs() + periodUs_;
+  active_ = true;
+  bool known = false;
+  for (Ticker* t : tickers()) known |= (t == this);
+  if (!known) tickers().push_back(this);
+  sTickerGen++;
+  ensureTimerThread();
+  waitCv().notify_all();
+}
+
+void Ticker::detach(){
+  // 인터럽트 락 → 실행 중인 콜백이 끝난 뒤 해제 (타깃과 같은 보장)
+  std::lock_guard<std::recursive_mutex> irq(irqLock());
+  std::lock_guard<std::mutex> g(waitLock());
+  active_ = false;
+  sTickerGen++;
+  waitCv().notify_all();
+}
+
+} // namespace mbed
+
+// ------------------ 진입점 ------------------
+
+void halWatchdogBegin(uint32_t){}
+void halWatchdogKick(){}
+
+// 테스트 러너(PIO_UNIT_TESTING) 나 외부 하니스(HAL_NO_MAIN)는 자체 main 사용
+#if !defined(PIO_UNIT_TESTING) && !defined(HAL_NO_MAIN)
+int main(){
+  setvbuf(stdout, nullptr, _IOLBF, 0);   // 파이프로 받아도 줄 단위 출력
+  // 표준 입력 → Serial 입력 (셸). EOF 면 읽기만 끝난다
+  std::thread([]{
+    int c;
+    while ((c = getchar()) != EOF){
+      const char b = (char)c;
+      halSerialInject(&b, 1);
+    }
+  }).detach();
+  setup();
+  while (true) loop();
+}
+#endif
+
+#endif
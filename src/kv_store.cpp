@@ -0,0 +1,97 @@
+// ============================================================
+// 키-값 저장소 구현 (타깃: TDBStore / 호스트: 파일)
+// ============================================================
+
+#include "kv_store.h"
+
+#if defined(ARDUINO)
+
+#include <Arduino.h>
+#include "mbed.h"
+#include "FlashIAPBlockDevice.h"
+#include "TDBStore.h"
+
+// 뱅크2(0x0810_0000~) 끝 2섹터. 뱅크1 에서 코드가 실행되는 동안
+// 뱅크2 를 소거해도 명령어 인출이 멈추지 않는다 (워치독 안전).
+// M4 코어 이미지는 뱅크2 앞쪽에 올라가므로 768KB 이하면 겹치지 않는다.
+#ifndef KV_STORE_SECTORS
+#define KV_STORE_SECTORS 2
+#endif
+
+namespace {
+
+mbed::TDBStore* sStore = nullptr;
+
+} // namespace
+
+bool kvInit(){
+  if (sStore) return true;
+
+  mbed::FlashIAP flash;
+  if (flash.init() != 0) return false;
+  const uint32_t end = flash.get_flash_start() + flash.get_flash_size();
+  const uint32_t sector = flash.get_sector_size(end - 1);
+  flash.deinit();
+
+  const uint32_t size = sector * KV_STORE_SECTORS;
+  static mbed::FlashIAPBlockDevice bd(end - size, size);
+  static mbed::TDBStore store(&bd);
+  if (store.init() != MBED_SUCCESS) return false;
+
+  sStore = &store;
+  return true;
+}
+
+bool kvGet(const char* key, void* buf, size_t size){
+  if (!sStore) return false;
+  size_t actual = 0;
+  return sStore->get(key, buf, size, &actual) == MBED_SUCCESS && actual == size;
+}
+
+bool kvSet(const char* key, const void* buf, size_t size){
+  if (!sStore) return false;
+  return sStore->set(key, buf, size, 0) == MBED_SUCCESS;
+}
+
+#else  // 호스트: 파일 기반 대용품
+
+#include <stdio.h>
+#include <string>
+
+#ifndef KV_STORE_DIR
+#define KV_STORE_DIR "."
+#endif
+
+namespace {
+
+std::string kvPath(const char* key){
+  return std::string(KV_STORE_DIR) + "/kv_" + key + ".bin";
+}
+
+} // namespace
+
+bool kvInit(){
+  return true;
+}
+
+bool kvGet(const char* key, void* buf, size_t size){
+  FILE* f = fopen(kvPath(key).c_str(), "rb");
+  if (!f) return false;
+  const size_t n = fread(buf, 1, size, f);
+  const bool exact = (n == size) && fgetc(f) == EOF;
+  fclose(f);
+  return exact;
+}
+
+bool kvSet(const char* key, const void* buf, size_t size){
+  // 임시 파일에 쓰고 rename → 중간에 죽어도 이전 값 유지
+  const std::string path = kvPath(key);
+  const std::string tmp = path + ".tmp";
+  FILE* f = fopen(tmp.c_str(), "wb");
+  if (!f) return false;
+  const bool ok = fwrite(buf, 1, size, f) == size;
+  if (fclose(f) != 0 || !ok) return false;
+  return rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+#endif
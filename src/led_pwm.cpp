@@ -0,0 +1,166 @@
+// ============================================================
+// RGB LED PWM 구현 (TIM7 UPDATE → DMA1_Stream7 → GPIOK->BSRR)
+// ============================================================
+
+#include "hal.h"
+#include "led_pwm.h"
+
+namespace {
+
+// 마지막으로 요청된 색 (감마 전, 임계 구역 안에서만 접근)
+Rgb sLast = { 0, 0, 0 };
+
+} // namespace
+
+#if defined(ARDUINO)
+
+#ifndef LED_PWM_DMA_STREAM
+#define LED_PWM_DMA_STREAM   DMA1_Stream7
+#define LED_PWM_DMAMUX_CH    DMAMUX1_Channel7    // DMA1 스트림 n = DMAMUX 채널 n
+#define LED_PWM_DMA_CLR()    (DMA1->HIFCR = DMA_HIFCR_CTCIF7 | DMA_HIFCR_CHTIF7 | \
+                              DMA_HIFCR_CTEIF7 | DMA_HIFCR_CDMEIF7 | DMA_HIFCR_CFEIF7)
+#endif
+
+namespace {
+
+const uint32_t SLOTS = 1u << LED_PWM_BITS;
+static constexpr GammaTable<LED_PWM_BITS> GAMMA;
+
+// LEDR/LEDG/LEDB = PK5/PK6/PK7, 액티브 로우
+const uint32_t PIN_MASK[3] = { 1u << 5, 1u << 6, 1u << 7 };
+inline uint32_t onBits(int c){  return PIN_MASK[c] << 16; }   // BSRR 리셋 → LOW → 켜짐
+inline uint32_t offBits(int c){ return PIN_MASK[c]; }         // BSRR 셋 → HIGH → 꺼짐
+
+// DMA1 은 DTCM 에 접근할 수 없으므로 기본 .bss(AXI SRAM). 캐시 라인 정렬
+alignas(32) uint32_t sSlots[SLOTS];
+
+uint16_t sDuty[3] = { 0, 0, 0 };
+bool sActive = false;
+
+uint32_t slotWord(uint32_t s){
+  uint32_t w = 0;
+  for (int c = 0; c < 3; ++c){
+    if (s == 0) w |= sDuty[c] ? onBits(c) : offBits(c);
+    if (sDuty[c] && sDuty[c] == s) w |= offBits(c);
+  }
+  return w;
+}
+
+void writeSlot(uint32_t s){
+  sSlots[s] = slotWord(s);
+  // 해당 워드가 든 캐시 라인만 메모리로 내보낸다 (DMA 가 읽도록)
+  SCB_CleanDCache_by_Addr((uint32_t*)((uint32_t)&sSlots[s] & ~31u), 32);
+}
+
+uint32_t tim7ClockHz(){
+  const uint32_t pclk1 = HAL_RCC_GetPCLK1Freq();
+  return (RCC->D2CFGR & RCC_D2CFGR_D2PPRE1_2) ? pclk1 * 2 : pclk1;
+}
+
+void digitalFallback(Rgb c){
+  digitalWrite(LEDR, c.r ? LOW : HIGH);
+  digitalWrite(LEDG, c.g ? LOW : HIGH);
+  digitalWrite(LEDB, c.b ? LOW : HIGH);
+}
+
+} // namespace
+
+bool ledPwmBegin(){
+  const uint32_t rate = (uint32_t)LED_PWM_HZ * SLOTS;
+  const uint32_t timHz = tim7ClockHz();
+  if (timHz < rate) return false;
+
+  for (uint32_t s = 0; s < SLOTS; ++s) sSlots[s] = 0;
+  sDuty[0] = sDuty[1] = sDuty[2] = 0;
+  sSlots[0] = slotWord(0);
+  SCB_CleanDCache_by_Addr(sSlots, sizeof(sSlots));
+
+  __HAL_RCC_TIM7_CLK_ENABLE();
+  __HAL_RCC_DMA1_CLK_ENABLE();
+
+  // ---- DMA: sSlots → GPIOK->BSRR, 32bit, 원형 ----
+  LED_PWM_DMA_STREAM->CR &= ~DMA_SxCR_EN;
+  while (LED_PWM_DMA_STREAM->CR & DMA_SxCR_EN) {}
+  LED_PWM_DMA_CLR();
+  LED_PWM_DMAMUX_CH->CCR = DMA_REQUEST_TIM7_UP;
+  LED_PWM_DMA_STREAM->PAR  = (uint32_t)&GPIOK->BSRR;
+  LED_PWM_DMA_STREAM->M0AR = (uint32_t)sSlots;
+  LED_PWM_DMA_STREAM->NDTR = SLOTS;
+  LED_PWM_DMA_STREAM->FCR  = 0;
+  LED_PWM_DMA_STREAM->CR   = DMA_SxCR_PL_0 | DMA_SxCR_MSIZE_1 | DMA_SxCR_PSIZE_1 |
+                             DMA_SxCR_MINC | DMA_SxCR_CIRC | DMA_SxCR_DIR_0;
+  LED_PWM_DMA_STREAM->CR  |= DMA_SxCR_EN;
+
+  // ---- TIM7: 슬롯 주기마다 DMA 요청 ----
+  TIM7->CR1 = 0;
+  TIM7->PSC = 0;
+  TIM7->ARR = timHz / rate - 1;
+  TIM7->EGR = TIM_EGR_UG;
+  TIM7->SR = 0;
+  TIM7->DIER = TIM_DIER_UDE;
+  TIM7->CR1 = TIM_CR1_CEN;
+
+  sActive = true;
+  return true;
+}
+
+void ledSetRgb(Rgb c){
+  if (!sActive){
+    core_util_critical_section_enter();
+    sLast = c;
+    core_util_critical_section_exit();
+    digitalFallback(c);
+    return;
+  }
+
+  const uint16_t next[3] = { GAMMA[c.r], GAMMA[c.g], GAMMA[c.b] };
+
+  // 태스크와 Ticker 인터럽트가 함께 부를 수 있으므로 짧은 임계 구역
+  core_util_critical_section_enter();
+  sLast = c;
+  uint16_t prev[3];
+  for (int i = 0; i < 3; ++i){ prev[i] = sDuty[i]; sDuty[i] = next[i]; }
+
+  // 바뀐 전이 지점만 다시 쓴다: 슬롯 0, 이전/새 끄기 슬롯
+  writeSlot(0);
+  for (int i = 0; i < 3; ++i){
+    if (prev[i] == next[i]) continue;
+    if (prev[i]) writeSlot(prev[i]);
+    if (next[i]) writeSlot(next[i]);
+  }
+  core_util_critical_section_exit();
+}
+
+bool ledPwmActive(){
+  return sActive;
+}
+
+#else  // 호스트: 출력 대신 색만 기억
+
+namespace {
+bool sActive = false;
+} // namespace
+
+bool ledPwmBegin(){
+  sActive = true;
+  return true;
+}
+
+void ledSetRgb(Rgb c){
+  core_util_critical_section_enter();
+  sLast = c;
+  core_util_critical_section_exit();
+}
+
+bool ledPwmActive(){
+  return sActive;
+}
+
+#endif
+
+Rgb ledCurrentRgb(){
+  core_util_critical_section_enter();
+  const Rgb c = sLast;
+  core_util_critical_section_exit();
+  return c;
+}
@@ -9,11 +9,56 @@
 //  - 구간 매핑 적용: -100% ~ +100%를 200구간으로 나눠 매칭
 //  - 0% 값 → 주황색 표시
 //  - RC 타임아웃 처리 (신호 끊기면 LED 꺼짐)
+//  - 타이머 입력 캡처 + DMA 로 펄스 폭 측정 (ISR 지연 지터 제거)
+//  - ISR → 태스크 SPSC 링: 모든 펄스를 정확히 한 번씩 처리
+//  - 이벤트 플래그로 펄스 도착 즉시 태스크 기동 (2ms 폴링 제거)
+//  - 필터 파이프라인 컴파일 타임 선택 (RC_FILTER, platformio.ini 환경별)
+//  - Hampel 이상치 제거를 필터/보정 앞단에 배치 (글리치 1개로 min/max 안 벌어짐)
+//  - 보정값 플래시 저장 → 부팅 직후부터 올바른 퍼센트 (스윕 불필요)
+//  - 자동 보정: min/max 래치 대신 P² 스트리밍 분위수 (0.5% / 99.5%), 저장값은 넓히는 쪽으로만 갱신
+//  - 퍼센트 변환 LUT: 201구간 균등(폭 차 ≤1µs), 보정 변경 시에만 재구성
+//  - 히스테리시스 양자화: 구간 경계에서 퍼센트 깜빡임 억제
+//  - 패턴 조회: 컴파일 타임 밀집 인덱스 (값 + 100), 중복 값은 빌드 에러
+//  - 범위/체류/변화율 규칙 (런타임 적재, 중심 구간 트리 O(log n + 겹치는 규칙 수))
+//  - LED: 타이머 DMA PWM + 감마 LUT → 실제 혼합색 (주황 = 진짜 주황)
+//  - 점멸은 Ticker 인터럽트가 담당, taskLed 는 퍼센트가 바뀔 때만 깨어남
+//  - LED 애니메이션 엔진 (타이밍 휠): 다단계 시퀀스, 퍼센트 숫자 점멸 표시
+//  - 샘플 스냅샷 시퀀스 락 게시 (seq/원시/평균/퍼센트/시각/플래그, 센티넬 제거)
+//  - 보드 의존부를 HAL(hal.h) 뒤로 → env:native 에서 전체 파이프라인 실행
+//  - 핫패스 마이크로 벤치마크 (RC_BENCHMARK, 호스트 ns / 타깃 DWT 사이클, JSON)
+//  - 에지 트레이스 기록(RC_TRACE) + 호스트 고속 재생(RC_REPLAY), 같은 처리 체인
+//  - 샘플별 바이너리 텔레메트리 (RC_TELEMETRY, COBS + CRC, 더블 버퍼 비차단 송신)
+//  - 로그: 락 없는 MPSC 링에 포맷 번호 + 인자만, 저우선 태스크가 포맷 / 비차단 송신
+//  - Serial 명령 셸 (get/set/stats/reset-cal/dump/rule): 재플래시 없이 파라미터 변경, 샘플 사이 원자 적용
+//  - 정확 일치 통계 (값별 샘플/진입/체류, 전이 폭, 안착 시간 분포), 셸 acc 로 조회
+//  - 1µs 펄스 폭 히스토그램 (창 감쇠, O(1) 최빈값 / 분위수), 최빈값 필터 선택(RC_FILTER_MODE), 셸 pulse
 // ============================================================
 
-#include <Arduino.h>
-#include "mbed.h"
-#include "rtos.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hal.h"
+#include "rc_capture_tim.h"
+#include "spsc_ring.h"
+#include "filter_pipeline.h"
+#include "kv_store.h"
+#include "cal_store.h"
+#include "p2_quantile.h"
+#include "percent_lut.h"
+#include "hysteresis_quantizer.h"
+#include "pattern_index.h"
+#include "pattern_rules.h"
+#include "led_pwm.h"
+#include "led_anim.h"
+#include "seqlock.h"
+#include "bench.h"
+#include "rc_signal_gen.h"
+#include "trace.h"
+#include "telemetry.h"
+#include "log_ring.h"
+#include "shell.h"
+#include "accuracy_stats.h"
+#include "pulse_histogram.h"
 
 #ifndef IRAM_ATTR
 #define IRAM_ATTR
@@ -23,28 +68,106 @@ using namespace std::chrono;
 using namespace std::chrono_literals;
 using namespace rtos;
 
+// 1 = TIM1 입력 캡처 + DMA (기본), 0 = 기존 GPIO 인터럽트 + micros()
+#ifndef RC_CAPTURE_TIMER
+#define RC_CAPTURE_TIMER 1
+#endif
+
+// 1 = 기존 2ms 폴링 (지연 비교용), 0 = ISR 이벤트 플래그로 기동 (기본)
+#ifndef RC_WAKE_POLLING
+#define RC_WAKE_POLLING 0
+#endif
+
+// 1 = 태스크 대신 핫패스 마이크로 벤치마크만 실행 (env:*_bench)
+#ifndef RC_BENCHMARK
+#define RC_BENCHMARK 0
+#endif
+
+// 1 = 입력 핀의 모든 에지(거부된 펄스 / 글리치 포함)를 트레이스로 기록해 Serial 로 내보냄 ("#T <hex>")
+#ifndef RC_TRACE
+#define RC_TRACE 0
+#endif
+
+// 1 = 트레이스 파일을 최대 속도로 재생해 샘플별 결과 출력 (호스트 전용, env:native_replay)
+#ifndef RC_REPLAY
+#define RC_REPLAY 0
+#endif
+
+#if RC_REPLAY && defined(ARDUINO)
+#error "RC_REPLAY is host-only (env:native_replay)"
+#endif
+
+// 1 = 표준 입력(또는 RC_TELEMETRY_FILE)의 텔레메트리 스트림을 CSV 로 풀기 (호스트 전용)
+#ifndef RC_TELEMETRY_DECODE
+#define RC_TELEMETRY_DECODE 0
+#endif
+
+#if RC_TELEMETRY_DECODE && defined(ARDUINO)
+#error "RC_TELEMETRY_DECODE is host-only (env:native_telemetry_decode)"
+#endif
+
 // ============================================================
-// -------------------- LED 제어 -------------------------------
+// -------------------- LED 제어 (DMA PWM) --------------------
 // ============================================================
 
-static inline void setRgb(bool rOn, bool gOn, bool bOn){
-  digitalWrite(LEDR, rOn ? LOW : HIGH);
-  digitalWrite(LEDG, gOn ? LOW : HIGH);
-  digitalWrite(LEDB, bOn ? LOW : HIGH);
-}
+// 선형 밝기 8비트, 감마 보정은 드라이버가 한다
+static constexpr Rgb RGB_OFF    = {   0,   0,   0 };
+static constexpr Rgb RGB_RED    = { 255,   0,   0 };
+static constexpr Rgb RGB_YELLOW = { 255, 200,   0 };
+static constexpr Rgb RGB_GREEN  = {   0, 255,   0 };
+static constexpr Rgb RGB_PURPLE = { 180,   0, 255 };
+static constexpr Rgb RGB_BLUE   = {   0,   0, 255 };
+static constexpr Rgb RGB_LIME   = {   0, 255, 255 };
+static constexpr Rgb RGB_ORANGE = { 255,  80,   0 };
 
-static inline void rgbOff(){ setRgb(false, false, false); }
+static inline void setRgb(Rgb c){ ledSetRgb(c); }
+static inline void rgbOff(){ setRgb(RGB_OFF); }
 
-static inline void applyRgb(bool on, bool r, bool g, bool b){
-  if (on) setRgb(r, g, b); else rgbOff();
+// ============================================================
+// ------------------ 로그 (지연 포맷 링) ----------------------
+// ============================================================
+
+// 포맷 번호. LOG_FORMATS 와 순서가 같아야 한다
+enum LogId : uint16_t {
+  LOG_STATUS_CAL,       // 3초 상태: 보정 / 펄스
+  LOG_STATUS_SAMPLE,    // 3초 상태: 샘플 / 지연 / 양자화
+  LOG_STATUS_TELEM,     // 3초 상태: 텔레메트리 (RC_TELEMETRY)
+  LOG_PULSE_OVERRUN,    // ISR: 펄스 링 가득 참
+  LOG_SIGNAL_UP,
+  LOG_SIGNAL_LOST,
+  LOG_CAL_SAVED,
+  LOG_DROPPED,          // 소비자 전용: 로그 링이 버린 개수
+  LOG_ID_COUNT
+};
+
+// printf 형식. 인자는 모두 32비트 → %d / %u / %x 만 쓸 것
+static const char* const LOG_FORMATS[] = {
+  "MinPulse=%d, MaxPulse=%d, Pulses=%u, Overruns=%u, Seq=%u",
+  "RawUs=%u, AvgUs=%u, LatAvgUs=%u, LatMaxUs=%u, Transitions=%u, Suppressed=%u",
+  "TelemFrames=%u, TelemDrops=%u",
+  "pulse ring overrun (total %u)",
+  "RC signal present",
+  "RC signal lost",
+  "calibration saved: min=%u max=%u",
+  "log ring dropped %u messages",
+};
+static_assert(sizeof(LOG_FORMATS) / sizeof(LOG_FORMATS[0]) == LOG_ID_COUNT,
+              "LOG_FORMATS out of sync with LogId");
+
+// 128 × 36바이트. 3초 상태 3줄 + 이벤트, 호스트가 몇 초 멈춰도 버티는 크기
+static LogRing<128> gLog;
+
+// USB CDC 송신권 (taskLogDrain / taskTelemetry). 로그 줄 / 셸 응답 / 텔레메트리 묶음 하나를
+// 다 보낼 때까지 쥐고 있어 서로의 중간에 끼어들지 않는다 (끼어들면 COBS 프레임이 깨짐)
+static Mutex gSerialTx;
+
+// 태스크 / ISR 어디서든. 복사만 하고 바로 반환
+template <typename... Args>
+static inline void logEvent(LogId id, Args... args){
+  static_assert(sizeof...(Args) <= LOG_MAX_ARGS, "too many log arguments");
+  const int32_t a[] = { (int32_t)args..., 0 };
+  gLog.push(id, millis(), a, sizeof...(Args));
 }
-static inline void red(bool on){     applyRgb(on, true,  false, false); }
-static inline void yellow(bool on){  applyRgb(on, true,  true,  false); }
-static inline void green(bool on){   applyRgb(on, false, true,  false); }
-static inline void purple(bool on){  applyRgb(on, true,  false, true ); }
-static inline void blue(bool on){    applyRgb(on, false, false, true ); }
-static inline void lime(bool on){    applyRgb(on, false, true,  true ); }
-static inline void orange(bool on){  applyRgb(on, true,  true,  true ); } // RGB 조합으로 주황 대체
 
 // ============================================================
 // -------------------- RC 입력 -------------------------------
@@ -57,73 +180,265 @@ static const uint16_t RC_MAX_US = 2200;
 static const uint32_t RC_TIMEOUT_MS = 300;
 
 volatile uint32_t gRiseUs = 0;
-volatile uint16_t gLastPulseUs = 0;
-volatile uint32_t gLastSeenMs = 0;
+
+// ISR(생산자) → taskRcInput(소비자). 50Hz 기준 64개 = 1.28초 분량
+SpscRing<PulseRecord, 64> gPulseRing;
+
+// 펄스 도착 알림 (ISR 에서 set 가능)
+EventFlags gRcEvents;
+constexpr uint32_t RC_EVT_PULSE = 1u << 0;
+
+#if RC_TRACE
+// 트레이스용 원시 에지 (ISR → taskRcInput). 펄스 판정 전에 넣는다
+struct TraceEdge {
+  uint32_t tUs;
+  bool high;
+};
+static SpscRing<TraceEdge, 256> gTraceEdges;
+#endif
+
+static inline void traceEdge(uint32_t tUs, bool high){
+#if RC_TRACE
+  gTraceEdges.push(TraceEdge{ tUs, high });
+#else
+  (void)tUs; (void)high;
+#endif
+}
+
+static inline void pushPulse(const PulseRecord& rec){
+  if (!gPulseRing.push(rec)){
+    // 1, 2, 4, 8 … 번째에만 기록 (태스크가 멈춘 동안 로그가 넘치지 않게)
+    const uint32_t n = gPulseRing.overruns();
+    if ((n & (n - 1)) == 0) logEvent(LOG_PULSE_OVERRUN, n);
+  }
+#if !RC_WAKE_POLLING
+  gRcEvents.set(RC_EVT_PULSE);
+#endif
+}
+
+// 에지 하나 → 펄스. ISR 과 트레이스 재생이 같은 판정을 쓴다
+template <typename Rise>
+static inline bool edgeToPulse(bool high, uint32_t t, Rise& riseUs, PulseRecord& out){
+  if (high){
+    riseUs = t;
+    return false;
+  }
+  uint32_t w = (t - riseUs);
+  if (w > 0xFFFF) w = 0xFFFF;
+  const uint16_t us = (uint16_t)w;
+  if (us < RC_MIN_US || us > RC_MAX_US) return false;
+  out = PulseRecord{ t, us };
+  return true;
+}
 
 void IRAM_ATTR onRcChange(){
   const int lv = digitalRead(RC_PIN);
   const uint32_t t = micros();
 
-  if (lv == HIGH){
-    gRiseUs = t;
-  } else {
-    uint32_t w = (t - gRiseUs);
-    if (w > 0xFFFF) w = 0xFFFF;
-    const uint16_t us = (uint16_t)w;
+  traceEdge(t, lv == HIGH);
+  PulseRecord rec;
+  if (edgeToPulse(lv == HIGH, t, gRiseUs, rec)) pushPulse(rec);
+}
 
-    if (us >= RC_MIN_US && us <= RC_MAX_US){
-      gLastPulseUs = us;
-      gLastSeenMs  = millis();
-    }
-  }
+// 캡처 백엔드 콜백: 폭은 하드웨어가 래치한 값, 범위 검사는 디코더가 끝냄.
+// 거부된 HIGH 구간(valid = false)은 트레이스에만 남긴다
+void onRcPulse(const RcPulse& pulse, uint32_t tUs){
+  traceEdge(tUs - pulse.us, true);
+  traceEdge(tUs, false);
+  if (pulse.valid) pushPulse(PulseRecord{ tUs, pulse.us });
 }
 
 // ============================================================
-// ------------------ 이동 평균 (32샘플) -----------------------
+// ------------------ 필터 파이프라인 (컴파일 타임) -------------
 // ============================================================
 
 #define AVG_WINDOW 32
-volatile uint16_t pulseBuffer[AVG_WINDOW];
-volatile uint8_t pulseIndex = 0;
 
-uint16_t filterPulse(uint16_t newVal){
-  pulseBuffer[pulseIndex++] = newVal;
-  if (pulseIndex >= AVG_WINDOW) pulseIndex = 0;
+#define RC_FILTER_MEAN        0   // 이동 평균 32샘플 (기존 동작)
+#define RC_FILTER_MEDIAN_EMA  1   // 중앙값 5 → EMA 0.1
+#define RC_FILTER_MEDIAN_MEAN 2   // 중앙값 5 → 이동 평균 32
+#define RC_FILTER_ONE_EURO    3   // 1€ 필터 (저지연)
+#define RC_FILTER_MODE        4   // 최근 PULSE_HIST_WINDOW 펄스의 1µs 최빈값
 
-  uint32_t sum = 0; uint8_t count = 0;
-  for (uint8_t i=0;i<AVG_WINDOW;i++){
-    if (pulseBuffer[i] > 0){ sum += pulseBuffer[i]; count++; }
-  }
-  if (count == 0) return 0;
-  return (uint16_t)(sum / count);
+// 펄스 폭 히스토그램 창 (펄스 수). 최빈값은 계단 변화 후 약 창/2 펄스 늦게 따라온다
+#ifndef PULSE_HIST_WINDOW
+#define PULSE_HIST_WINDOW 64
+#endif
+using PulseHist = PulseHistogram<RC_MIN_US, RC_MAX_US, PULSE_HIST_WINDOW>;
+
+#ifndef RC_FILTER
+#define RC_FILTER RC_FILTER_MEAN
+#endif
+
+#if RC_FILTER == RC_FILTER_MEAN
+using RcFilter = Pipeline<MovingAverage<AVG_WINDOW>>;
+#elif RC_FILTER == RC_FILTER_MEDIAN_EMA
+using RcFilter = Pipeline<Median<5>, Ema<Q15(0.1)>>;
+#elif RC_FILTER == RC_FILTER_MEDIAN_MEAN
+using RcFilter = Pipeline<Median<5>, MovingAverage<AVG_WINDOW>>;
+#elif RC_FILTER == RC_FILTER_ONE_EURO
+using RcFilter = Pipeline<OneEuro<1000, 5000, 50>>;
+#elif RC_FILTER == RC_FILTER_MODE
+using RcFilter = Pipeline<PulseHist>;
+#else
+#error "unknown RC_FILTER"
+#endif
+
+// 이동 평균 단계의 창 변경 (셸 avg_window). 평균 단계가 없는 필터는 무시
+static void setAvgWindow(RcFilter& f, uint16_t n){
+#if RC_FILTER == RC_FILTER_MEAN
+  f.head().setWindow(n);
+#elif RC_FILTER == RC_FILTER_MEDIAN_MEAN
+  f.tail().head().setWindow(n);
+#else
+  (void)f; (void)n;
+#endif
+}
+
+// 필터 앞단 이상치 제거 (0 = 끔). 창 7, 3.0σ, 최소 허용 편차 3µs
+#ifndef RC_HAMPEL_WINDOW
+#define RC_HAMPEL_WINDOW 7
+#endif
+
+// taskRcInput 전용 → volatile 불필요
+static RcFilter gPulseFilter;
+#if RC_HAMPEL_WINDOW
+static Hampel<RC_HAMPEL_WINDOW, 30, 3> gOutlier;
+#endif
+
+// 히스토그램은 필터와 같은 입력(Hampel 뒤)을 본다. 최빈값 필터면 그 단계 자체.
+// 셸 조회와 공유 → 갱신 / 조회 모두 잠금 안에서 (둘 다 짧다)
+#if RC_FILTER == RC_FILTER_MODE
+static PulseHist& gPulseHist = gPulseFilter.head();
+#else
+static PulseHist gPulseHist;
+#endif
+static Mutex gPulseHistLock;
+
+uint16_t filterPulse(uint16_t newVal){
+#if RC_HAMPEL_WINDOW
+  newVal = gOutlier.push(newVal);
+#endif
+  gPulseHistLock.lock();
+#if RC_FILTER == RC_FILTER_MODE
+  const uint16_t out = gPulseFilter.push(newVal);
+  gPulseHistLock.unlock();
+  return out;
+#else
+  gPulseHist.push(newVal);
+  gPulseHistLock.unlock();
+  return gPulseFilter.push(newVal);
+#endif
 }
 
 // ============================================================
-// ------------------ 자동 보정용 변수 -------------------------
+// ------------------ 자동 보정 (스트리밍 분위수) ---------------
 // ============================================================
 
 static uint16_t gMinPulse = 2000;
 static uint16_t gMaxPulse = 1000;
 
+// 분위수 [‰]. 나쁜 평균값 몇 개는 0.5% 꼬리에 묻혀 경계를 못 움직인다
+#ifndef CAL_Q_LOW_PERMILLE
+#define CAL_Q_LOW_PERMILLE   5
+#endif
+#ifndef CAL_Q_HIGH_PERMILLE
+#define CAL_Q_HIGH_PERMILLE  995
+#endif
+// 0 = 전체 이력, N = 최근 약 N 샘플 비중 (오래된 극값이 서서히 사라짐)
+#ifndef CAL_AGING_WINDOW
+#define CAL_AGING_WINDOW     0
+#endif
+// 추정 폭이 이보다 좁으면(스틱을 아직 안 움직임) 기존 경계 유지
+static const uint16_t CAL_MIN_SPAN_US = 600;
+// 이만큼 본 뒤에야 플래시에 저장 (0.5% 꼬리에 샘플 ~5개, 50Hz 로 20초).
+// 그 전의 경계는 LUT 에는 쓰지만 스윕 도중의 부분 폭일 수 있다
+#ifndef CAL_PERSIST_MIN_SAMPLES
+#define CAL_PERSIST_MIN_SAMPLES 1000
+#endif
+
+static P2Quantile gCalLow (CAL_Q_LOW_PERMILLE  / 1000.0f, CAL_AGING_WINDOW);
+static P2Quantile gCalHigh(CAL_Q_HIGH_PERMILLE / 1000.0f, CAL_AGING_WINDOW);
+static volatile uint32_t gCalSamples = 0;   // 분위수가 본 샘플 수 (작성자: taskRcInput)
+// 플래시에서 불러온 경계. 분위수는 이 폭을 넓힐 때만 반영 (부분 스윕이 저장값을 좁히지 않게).
+// 2000 / 1000 = 불러온 값 없음 (어떤 추정도 넓히는 쪽)
+static uint16_t gCalFloorMin = 2000;
+static uint16_t gCalFloorMax = 1000;
+
+// taskRcInput 에서 샘플당 1회, O(1)
+void calibrate(uint16_t avg){
+  if (!avg) return;
+  gCalLow.add(avg);
+  gCalHigh.add(avg);
+  gCalSamples = gCalLow.count();
+  if (!gCalLow.ready()) return;
+
+  uint16_t lo = (uint16_t)(gCalLow.value() + 0.5f);
+  uint16_t hi = (uint16_t)(gCalHigh.value() + 0.5f);
+  if (lo > gCalFloorMin) lo = gCalFloorMin;
+  if (hi < gCalFloorMax) hi = gCalFloorMax;
+  if (hi > lo && hi - lo >= CAL_MIN_SPAN_US){
+    gMinPulse = lo;
+    gMaxPulse = hi;
+  }
+}
+
+static const char* const CAL_KEY = "cal";
+static CalSaver<> gCalSaver;
+
+// 부팅 시 저장된 보정값 복원. 없거나 깨졌으면 기본값(미보정) 유지
+bool loadCalibration(){
+  CalRecord rec;
+  if (!kvInit() || !kvGet(CAL_KEY, &rec, sizeof(rec)) || !rec.valid()) return false;
+  gMinPulse = gCalFloorMin = rec.minUs;
+  gMaxPulse = gCalFloorMax = rec.maxUs;
+  gCalSaver.loaded(rec.minUs, rec.maxUs);
+  return true;
+}
+
+// taskLogger (osPriorityBelowNormal) 에서 주기 호출 (플래시 쓰기는 여기서만)
+void persistCalibration(uint32_t nowMs){
+  if (gCalSamples < CAL_PERSIST_MIN_SAMPLES) return;
+  const uint16_t minUs = gMinPulse;
+  const uint16_t maxUs = gMaxPulse;
+  if (!gCalSaver.poll(minUs, maxUs, nowMs)) return;
+
+  const CalRecord rec = { CalRecord::MAGIC, CalRecord::VERSION, minUs, maxUs };
+  if (kvSet(CAL_KEY, &rec, sizeof(rec))){
+    gCalSaver.committed(minUs, maxUs, nowMs);
+    logEvent(LOG_CAL_SAVED, minUs, maxUs);
+  }
+}
+
 // ============================================================
-// ------------------ 퍼센트 변환 (구간 매핑) ------------------
+// ------------------ 퍼센트 변환 (구간 매핑 LUT) --------------
 // ============================================================
 
-int16_t throttlePercentFromUs(uint16_t us){
-  if (gMaxPulse <= gMinPulse) return 0;
+// RC_MIN_US..RC_MAX_US 1401칸 x 2 (앞/뒤 버퍼)
+static PercentLut<RC_MIN_US, RC_MAX_US> gPercentLut;
 
-  int32_t span = gMaxPulse - gMinPulse;
-  int32_t step = span / 200;
+// 샘플당 재구성 칸 수 상한 (1401칸 → 최대 6샘플 뒤 교체)
+static const size_t LUT_STEP_BUDGET = 256;
 
-  if (step <= 0) return 0;
+// 보정값이 바뀌었으면 재구성 예약 + 조금씩 진행 (taskRcInput 전용)
+void updatePercentLut(){
+  gPercentLut.retarget(gMinPulse, gMaxPulse);
+  gPercentLut.step(LUT_STEP_BUDGET);
+}
 
-  int32_t idx = (us - gMinPulse) / step;
-  int32_t value = idx - 100;
+int16_t throttlePercentFromUs(uint16_t us){
+  return gPercentLut.lookup(us);
+}
+
+// 구간 폭 대비 히스테리시스 [1/256 구간], 0 = 끔
+#ifndef RC_HYSTERESIS_Q8
+#define RC_HYSTERESIS_Q8 64
+#endif
 
-  if (value > 100) value = 100;
-  if (value < -100) value = -100;
+static HysteresisQuantizer gQuantizer(RC_HYSTERESIS_Q8);
 
-  return (int16_t)value;
+int16_t quantizePercent(uint16_t us, int16_t percent){
+  return gQuantizer.update(us, percent, gPercentLut.calMin(), gPercentLut.calMax());
 }
 
 // ============================================================
@@ -132,63 +447,379 @@ int16_t throttlePercentFromUs(uint16_t us){
 
 struct ValuePattern {
   int16_t value;
-  void (*color)(bool);
+  Rgb color;
 };
 
-static const ValuePattern VALUE_PATTERNS[] = {
-  { 100, red },
-  {  99, yellow },
-  {  98, green },
-  {  97, purple },
-  {   0, orange },
-  { -50, blue },
-  { -99, lime },
+static constexpr ValuePattern VALUE_PATTERNS[] = {
+  { 100, RGB_RED },
+  {  99, RGB_YELLOW },
+  {  98, RGB_GREEN },
+  {  97, RGB_PURPLE },
+  {   0, RGB_ORANGE },
+  { -50, RGB_BLUE },
+  { -99, RGB_LIME },
 };
 
+static_assert(valuesInRange(VALUE_PATTERNS), "VALUE_PATTERNS value out of -100..100");
+static_assert(valuesUnique(VALUE_PATTERNS), "VALUE_PATTERNS has duplicate values");
+
+static constexpr ValueIndex PATTERN_INDEX = buildValueIndex(VALUE_PATTERNS);
+
 const ValuePattern* findPattern(int16_t value){
-  const size_t count = sizeof(VALUE_PATTERNS) / sizeof(VALUE_PATTERNS[0]);
-  for (size_t i=0; i<count; ++i){
-    if (VALUE_PATTERNS[i].value == value) return &VALUE_PATTERNS[i];
+  const int32_t i = PATTERN_INDEX.find(value);
+  return i < 0 ? nullptr : &VALUE_PATTERNS[i];
+}
+
+// ============================================================
+// ------------------ 범위/조건 규칙 (런타임 적재) --------------
+// ============================================================
+
+// 규칙의 color 번호 → 색
+enum : uint8_t {
+  COLOR_RED, COLOR_YELLOW, COLOR_GREEN, COLOR_PURPLE,
+  COLOR_BLUE, COLOR_LIME, COLOR_ORANGE, COLOR_COUNT
+};
+static constexpr Rgb COLOR_PALETTE[COLOR_COUNT] = {
+  RGB_RED, RGB_YELLOW, RGB_GREEN, RGB_PURPLE, RGB_BLUE, RGB_LIME, RGB_ORANGE,
+};
+
+static const uint16_t DEFAULT_BLINK_MS = 200;
+static const size_t RULES_MAX = 256;
+static const size_t RULES_STORED_MAX = 32;   // 플래시에 저장하는 최대 개수
+
+// 규칙이 맞으면 VALUE_PATTERNS 보다 우선
+static PatternRuleSet<RULES_MAX> gRules;
+static Mutex gRulesLock;
+
+struct StoredRules {
+  uint16_t magic;
+  uint16_t count;
+  PatternRule rules[RULES_STORED_MAX];
+
+  static const uint16_t MAGIC = 0x5255;
+};
+
+static const char* const RULES_KEY = "rules";
+
+// 앞 RULES_STORED_MAX 개를 플래시에 저장 (셸 = taskLogDrain, osPriorityLow). 반환 = 저장한 개수
+size_t storePatternRules(const PatternRule* rules, size_t n){
+  static StoredRules stored;
+  stored.magic = StoredRules::MAGIC;
+  stored.count = (uint16_t)(n < RULES_STORED_MAX ? n : RULES_STORED_MAX);
+  for (size_t i = 0; i < stored.count; ++i) stored.rules[i] = rules[i];
+  return kvSet(RULES_KEY, &stored, sizeof(stored)) ? stored.count : 0;
+}
+
+// 규칙 전체 교체. persist 면 플래시에도 저장 (입력 / LED 태스크에서는 persist 금지)
+size_t loadPatternRules(const PatternRule* rules, size_t n, bool persist){
+  gRulesLock.lock();
+  const size_t loaded = gRules.load(rules, n);
+  gRulesLock.unlock();
+
+  if (persist) storePatternRules(rules, n);
+  return loaded;
+}
+
+bool loadStoredRules(){
+  static StoredRules stored;
+  if (!kvGet(RULES_KEY, &stored, sizeof(stored)) || stored.magic != StoredRules::MAGIC) return false;
+  if (stored.count > RULES_STORED_MAX) return false;
+  loadPatternRules(stored.rules, stored.count, false);
+  return true;
+}
+
+// ============================================================
+// ------------------ 런타임 파라미터 (셸에서 변경) -------------
+// ============================================================
+
+static const uint8_t COLOR_NONE = 0xFF;
+static const char* const COLOR_NAMES[COLOR_COUNT] = {
+  "red", "yellow", "green", "purple", "blue", "lime", "orange",
+};
+
+// 셸이 통째로 게시 → 각 태스크가 다음 샘플 처리 전에 자기 사본을 교체 (중간 상태 없음)
+struct RuntimeParams {
+  uint16_t avgWindow;      // 이동 평균 창 (1..AVG_WINDOW, 평균 단계가 있는 필터만)
+  uint16_t timeoutMs;      // 신호 끊김 판정 (기본 RC_TIMEOUT_MS)
+  uint16_t blinkMs;        // 정확 일치 패턴 / 주기 없는 규칙의 점멸 주기
+  uint16_t hysteresisQ8;   // 양자화 히스테리시스
+  uint16_t calResets;      // 바뀔 때마다 자동 보정 재시작
+  uint8_t valueColor[201]; // 값 + 100 → COLOR_*, COLOR_NONE = 없음 (VALUE_PATTERNS 로 시작)
+};
+
+static RuntimeParams defaultParams(){
+  RuntimeParams p = {};
+  p.avgWindow = AVG_WINDOW;
+  p.timeoutMs = RC_TIMEOUT_MS;
+  p.blinkMs = DEFAULT_BLINK_MS;
+  p.hysteresisQ8 = RC_HYSTERESIS_Q8;
+  for (int16_t v = -100; v <= 100; ++v){
+    uint8_t c = COLOR_NONE;
+    const ValuePattern* pattern = findPattern(v);
+    for (uint8_t i = 0; pattern && i < COLOR_COUNT; ++i){
+      if (COLOR_PALETTE[i] == pattern->color){ c = i; break; }
+    }
+    p.valueColor[v + 100] = c;
   }
-  return nullptr;
+  return p;
+}
+
+static Seqlock<RuntimeParams> gParams;                 // 작성자: 셸 (taskLogDrain)
+static RuntimeParams gLedParams = defaultParams();     // taskLed 사본 (재생 / 벤치는 기본값)
+
+// 새로 게시된 것이 있으면 사본 교체. 반환 = 바뀜
+static bool refreshParams(RuntimeParams& local, uint32_t& version){
+  const uint32_t w = gParams.writes();
+  if (w == version) return false;
+  while (!gParams.read(local, 4)) ThisThread::yield();
+  version = w;
+  return true;
+}
+
+// ============================================================
+// ------------------ 점멸 선택 --------------------------------
+// ============================================================
+
+// 현재 값에 적용할 점멸 (규칙 우선, 없으면 정확 일치 패턴). periodMs 0 = 끔
+struct LedChoice {
+  Rgb color;
+  uint16_t periodMs;
+};
+
+// recheckMs: 값이 그대로여도 이 시간 뒤 다시 골라야 함 (체류/변화율 규칙, 0 = 불필요)
+LedChoice choosePattern(int16_t value, uint32_t nowMs, uint32_t& recheckMs){
+  LedChoice c = { RGB_OFF, 0 };
+
+  gRulesLock.lock();
+  gRules.observe(value, nowMs);
+  const PatternRule* rule = gRules.match(value, nowMs);
+  if (rule && rule->color < COLOR_COUNT){
+    c.color = COLOR_PALETTE[rule->color];
+    c.periodMs = rule->periodMs ? rule->periodMs : gLedParams.blinkMs;
+  }
+  recheckMs = gRules.recheckMs();
+  gRulesLock.unlock();
+
+  if (!c.periodMs && value >= -100 && value <= 100){
+    const uint8_t color = gLedParams.valueColor[value + 100];
+    if (color < COLOR_COUNT){
+      c.color = COLOR_PALETTE[color];
+      c.periodMs = gLedParams.blinkMs;
+    }
+  }
+  return c;
 }
 
 // ============================================================
-// ------------------ Blinker (무한 반복) ----------------------
+// ------------------ LED 애니메이션 (타이밍 휠) ---------------
 // ============================================================
 
-struct Blinker {
-  void (*apply)(bool) = nullptr;
-  uint16_t periodMs = 0;
-  uint32_t next = 0;
-  bool on = false;
+// 휠 틱 [ms]. 단계 길이는 이 단위로 반올림
+#ifndef LED_ANIM_TICK_MS
+#define LED_ANIM_TICK_MS 10
+#endif
+
+// 1 = 정확 일치 패턴이 없을 때도 현재 퍼센트를 숫자 점멸로 표시
+#ifndef LED_SHOW_PERCENT
+#define LED_SHOW_PERCENT 0
+#endif
+
+// 뒤 트랙이 위에 그려진다: 패턴 점멸이 숫자 표시를 덮음
+enum : size_t { TRACK_NUMBER, TRACK_PATTERN, TRACK_COUNT };
+
+static const size_t ANIM_STEPS_MAX = 48;   // 숫자 표시 최악(-99) 38단계
+typedef LedAnimator<TRACK_COUNT, ANIM_STEPS_MAX> Animator;
+typedef Animator::Sequence AnimSeq;
+
+// 휠 진행은 Ticker 인터럽트, 재생/정지는 taskLed → 임계 구역으로 보호
+static Animator gAnimator(LED_ANIM_TICK_MS, setRgb);
+static mbed::Ticker gAnimTicker;
+static bool gAnimTicking = false;
 
-  void start(void(*func)(bool), uint16_t period){
-    stop();
-    if (!func || !period) return;
-    apply = func;
-    periodMs = period;
-    on = false;
-    next = millis();
+void onAnimTick(){
+  gAnimator.tick(millis());
+}
+
+void ledAnimate(size_t track, const AnimSeq& seq){
+  core_util_critical_section_enter();
+  gAnimator.play(track, seq, millis());
+  core_util_critical_section_exit();
+
+  if (!gAnimTicking && seq.count){
+    gAnimTicker.attach(onAnimTick, milliseconds(LED_ANIM_TICK_MS));
+    gAnimTicking = true;
   }
+}
 
-  void stop(){
-    if (apply) apply(false);
-    apply = nullptr;
-    on = false;
-    periodMs = 0;
+void ledAnimStop(size_t track){
+  core_util_critical_section_enter();
+  gAnimator.stop(track);
+  const bool idle = gAnimator.idle();
+  core_util_critical_section_exit();
+
+  // 재생 중인 트랙이 없으면 틱 인터럽트도 멈춘다
+  if (idle && gAnimTicking){
+    gAnimTicker.detach();
+    gAnimTicking = false;
   }
+}
 
-  void run(){
-    if (!apply || !periodMs) return;
-    const uint32_t now = millis();
-    if ((int32_t)(now - next) >= 0){
-      do { next += periodMs; } while ((int32_t)(now - next) >= 0);
-      on = !on;
-      apply(on);
+// 무한 점멸 (기존 Blinker 와 같은 모양: period 켜짐, period 꺼짐)
+void blinkSequence(AnimSeq& seq, Rgb color, uint16_t periodMs){
+  seq.clear().flash(color, periodMs, periodMs);
+}
+
+// 퍼센트 숫자 표시
+//   부호(초록 + / 빨강 -, 0 은 주황) 길게 1회
+//   → 십의 자리: 파랑 길게 n회 → 일의 자리: 노랑 짧게 n회 (자리값 0 은 보라 아주 짧게 1회)
+//   → 긴 휴지 후 반복. ±100 은 십의 자리 10회.
+static const uint16_t NUM_SIGN_MS  = 600;
+static const uint16_t NUM_LONG_MS  = 350;
+static const uint16_t NUM_SHORT_MS = 120;
+static const uint16_t NUM_ZERO_MS  = 60;
+static const uint16_t NUM_GAP_MS   = 250;
+static const uint16_t NUM_DIGIT_GAP_MS = 700;
+static const uint16_t NUM_REPEAT_GAP_MS = 2000;
+
+static void digitSequence(AnimSeq& seq, uint8_t n, Rgb color, uint16_t onMs){
+  if (!n) seq.flash(RGB_PURPLE, NUM_ZERO_MS, NUM_GAP_MS);
+  else seq.flash(color, onMs, NUM_GAP_MS, n);
+}
+
+void numberSequence(AnimSeq& seq, int16_t value){
+  seq.clear();
+  if (value == 0){
+    seq.flash(RGB_ORANGE, NUM_SIGN_MS, NUM_REPEAT_GAP_MS);
+    return;
+  }
+  const uint16_t mag = (uint16_t)(value < 0 ? -value : value);
+  seq.flash(value > 0 ? RGB_GREEN : RGB_RED, NUM_SIGN_MS, NUM_DIGIT_GAP_MS);
+  digitSequence(seq, (uint8_t)(mag / 10), RGB_BLUE, NUM_LONG_MS);
+  seq.pause(NUM_DIGIT_GAP_MS);
+  digitSequence(seq, (uint8_t)(mag % 10), RGB_YELLOW, NUM_SHORT_MS);
+  seq.pause(NUM_REPEAT_GAP_MS);
+}
+
+// ============================================================
+// ------------------ 트레이스 기록 (RC_TRACE) ------------------
+// ============================================================
+
+#if RC_TRACE
+// taskRcInput 이 채우고 로거가 내보낸다. 밀리면 청크 단위로 버림 (overruns)
+static SpscRing<TraceChunk, 8> gTraceOut;
+static TraceWriter gTraceWriter;
+static uint32_t gTraceSeq = 0;
+static bool gTraceOpen = false;
+#endif
+
+void traceFlush(){
+#if RC_TRACE
+  if (gTraceOpen && !gTraceWriter.empty()) gTraceOut.push(gTraceWriter.chunk());
+  gTraceOpen = false;
+#endif
+}
+
+// ISR 이 쌓은 원시 에지를 청크로 (taskRcInput 전용)
+void traceDrain(){
+#if RC_TRACE
+  TraceEdge e;
+  while (gTraceEdges.pop(e)){
+    if (gTraceOpen && !gTraceWriter.hasRoom(1)) traceFlush();
+    if (!gTraceOpen){
+      gTraceWriter.begin(gTraceSeq++, e.tUs, gMinPulse, gMaxPulse);
+      gTraceOpen = true;
     }
+    gTraceWriter.add(e.tUs, e.high);
   }
-} throttleBlinker;
+#endif
+}
+
+// 로그 송신 태스크에서 호출: 쌓인 청크 하나를 "#T <hex>\n" 한 줄로. 반환 = 길이 (0 = 없음)
+size_t traceFormatLine(char* out, size_t cap){
+#if RC_TRACE
+  static TraceChunk chunk;
+  static const char HEX_DIGITS[] = "0123456789abcdef";
+  if (cap < 3 + 2 * sizeof(TraceChunk) + 1 || !gTraceOut.pop(chunk)) return 0;
+  const uint8_t* p = reinterpret_cast<const uint8_t*>(&chunk);
+  size_t n = 0;
+  out[n++] = '#'; out[n++] = 'T'; out[n++] = ' ';
+  for (size_t i = 0; i < chunk.wireSize(); ++i){
+    out[n++] = HEX_DIGITS[p[i] >> 4];
+    out[n++] = HEX_DIGITS[p[i] & 0x0F];
+  }
+  out[n++] = '\n';
+  return n;
+#else
+  (void)out; (void)cap;
+  return 0;
+#endif
+}
+
+// ============================================================
+// ------------------ 바이너리 텔레메트리 (RC_TELEMETRY) --------
+// ============================================================
+
+// 1 = 처리한 모든 샘플을 COBS 패킷으로 USB CDC 송신 (텍스트 로그와 섞여도 복호 가능)
+#ifndef RC_TELEMETRY
+#define RC_TELEMETRY 0
+#endif
+
+#if RC_TELEMETRY
+// 버퍼 하나 2kB: 500 샘플/s 에서 호스트가 약 190ms 멈춰도 버리지 않음
+static TelemetryTx<2048> gTelemetry;
+#endif
+
+// taskRcInput 에서 호출: 인코딩 + 복사만, 전송은 기다리지 않음
+void telemetrySample(const TelemetrySample& s){
+#if RC_TELEMETRY
+  gTelemetry.push(TELEM_SAMPLE, &s, sizeof(s));
+#else
+  (void)s;
+#endif
+}
+
+// 낮은 우선순위 송신 태스크: 10ms 마다 묶어서 보낸다.
+// 묶음 하나는 송신권을 쥔 채 엔드포인트가 비는 대로 (1ms 간격) 끝까지 이어 보낸다
+void taskTelemetry(){
+#if RC_TELEMETRY
+  while (true){
+    if (!Serial){
+      // 미연결: 쌓인 묶음은 버림 (taskLogDrain 과 같은 정책)
+      while (gTelemetry.drain([](const uint8_t*, size_t n){ return n; })) {}
+      ThisThread::sleep_for(100ms);
+      continue;
+    }
+    gSerialTx.lock();
+    bool more = gTelemetry.drain(halSerialWriteSome);
+    while (more && gTelemetry.sending() && Serial){
+      ThisThread::sleep_for(1ms);
+      more = gTelemetry.drain(halSerialWriteSome);
+    }
+    gSerialTx.unlock();
+    // 묶음 사이에서 송신권을 놓아 로그 줄이 끼어들 수 있게 한다
+    if (!more) ThisThread::sleep_for(10ms);
+  }
+#endif
+}
+
+// ============================================================
+// ------------------ 정확 일치 통계 ---------------------------
+// ============================================================
+
+// 한 값에 이만큼 머물면 "안착" (안착 시간 분포 기준)
+#ifndef ACC_SETTLE_MS
+#define ACC_SETTLE_MS 250
+#endif
+
+// 작성자: taskRcInput (게시마다). 셸은 잠금 상태로 통째 복사 후 포맷
+static AccuracyStats gAccuracy(ACC_SETTLE_MS);
+static Mutex gAccuracyLock;
+
+void accuracyObserve(int16_t percent, bool valid, uint32_t tUs){
+  gAccuracyLock.lock();
+  gAccuracy.observe(percent, valid, tUs);
+  gAccuracyLock.unlock();
+}
 
 // ============================================================
 // ------------------ RTOS 태스크 ------------------------------
@@ -196,95 +827,1028 @@ struct Blinker {
 
 Thread threadRcInput;
 Thread threadLed;
-Thread threadLogger;
+// 보정값 플래시 저장(섹터 소거 수 초)이 LED / 입력 태스크를 막지 않도록 한 단계 아래
+Thread threadLogger(osPriorityBelowNormal);
+Thread threadLogDrain(osPriorityLow);
+#if RC_TELEMETRY
+Thread threadTelemetry(osPriorityBelowNormal);
+#endif
+
+// 최신 샘플 스냅샷 (작성자: taskRcInput, 독자: taskLed / 로거)
+enum : uint16_t {
+  SAMPLE_VALID   = 1u << 0,   // 신호 있음, percent 유효
+  SAMPLE_CHANGED = 1u << 1,   // 직전 샘플과 percent 또는 유효 여부가 다름
+  SAMPLE_CAL     = 1u << 2,   // 보정값으로 만든 퍼센트 LUT 사용 중 (없으면 퍼센트는 항상 0)
+};
+
+struct SampleSnapshot {
+  uint32_t seq;        // 게시 번호 (같은 값이 반복돼도 증가)
+  uint32_t tMicros;    // 하강 에지 시각
+  uint16_t rawUs;      // 측정 폭
+  uint16_t avgUs;      // 필터 출력
+  int16_t percent;
+  uint16_t flags;
+};
+
+static Seqlock<SampleSnapshot> gSample;
+static SampleSnapshot gLastSample = {};   // 작성자 사본 (taskRcInput 전용)
+
+// 값이 바뀌면 taskLed 를 깨운다
+EventFlags gLedEvents;
+constexpr uint32_t LED_EVT_SAMPLE = 1u << 0;
 
-volatile int16_t gStablePercent = 0x7FFF;
+static void publishSample(uint16_t rawUs, uint16_t avgUs, int16_t percent, uint32_t tMicros, bool valid){
+  SampleSnapshot s;
+  s.seq = gLastSample.seq + 1;
+  s.tMicros = tMicros;
+  s.rawUs = rawUs;
+  s.avgUs = avgUs;
+  s.percent = valid ? percent : 0;
+  s.flags = (uint16_t)((valid ? SAMPLE_VALID : 0) | (gPercentLut.calibrated() ? SAMPLE_CAL : 0));
+
+  const bool changed = s.percent != gLastSample.percent ||
+                       (s.flags & SAMPLE_VALID) != (gLastSample.flags & SAMPLE_VALID);
+  if (changed) s.flags |= SAMPLE_CHANGED;
+
+  gSample.write(s);
+  gLastSample = s;
+  telemetrySample({ s.seq, s.tMicros, s.rawUs, s.avgUs, s.percent, s.flags });
+  accuracyObserve(s.percent, valid, tMicros);
+  if (changed) gLedEvents.set(LED_EVT_SAMPLE);
+}
+
+// 독자는 작성자와 같은 우선순위 → 몇 번 겹치면 양보 후 재시도
+SampleSnapshot readSample(){
+  SampleSnapshot s;
+  while (!gSample.read(s, 4)) ThisThread::yield();
+  return s;
+}
+
+volatile uint32_t gPulseCount = 0;
+
+// 에지 → 퍼센트 게시까지 지연 [µs] (taskRcInput 단독 갱신)
+struct LatencyStats {
+  uint32_t count = 0;
+  uint32_t sumUs = 0;
+  uint32_t maxUs = 0;
+} gLatency;
+
+// 신호 끊김: 무효 샘플 한 번 게시 + 양자화 상태 초기화 (taskRcInput / 재생 공용)
+void signalLost(uint32_t tUs){
+  if (gLastSample.flags & SAMPLE_VALID) publishSample(0, 0, 0, tUs, false);
+  gQuantizer.reset();
+}
+
+void processPulse(const PulseRecord& rec){
+  uint16_t avg = filterPulse(rec.us);
+  calibrate(avg);
+  updatePercentLut();
+  int16_t percent = quantizePercent(avg, throttlePercentFromUs(avg));
+  publishSample(rec.us, avg, percent, rec.tUs, avg != 0);
+
+  const uint32_t lat = micros() - rec.tUs;
+  gLatency.count++;
+  gLatency.sumUs += lat;
+  if (lat > gLatency.maxUs) gLatency.maxUs = lat;
+}
+
+// 자동 보정을 처음부터 (셸 reset-cal). 불러온 경계도 잊으므로 새 보정이 잡히면 좁아져도 덮어쓴다
+static void resetCalibration(){
+  gCalLow.reset();
+  gCalHigh.reset();
+  gCalSamples = 0;
+  gCalFloorMin = 2000;
+  gCalFloorMax = 1000;
+  gMinPulse = 2000;
+  gMaxPulse = 1000;
+  gPercentLut.rebuild(gMinPulse, gMaxPulse);
+  gQuantizer.reset();
+}
+
+static RuntimeParams gRcParams = defaultParams();   // taskRcInput 사본
+
+// 셸이 바꾼 값 중 입력 쪽 것을 적용 (taskRcInput, 샘플 사이에서만)
+static void applyRcParams(){
+  static uint32_t version = 0;
+  const RuntimeParams prev = gRcParams;
+  if (!refreshParams(gRcParams, version)) return;
+  if (gRcParams.avgWindow != prev.avgWindow) setAvgWindow(gPulseFilter, gRcParams.avgWindow);
+  if (gRcParams.hysteresisQ8 != prev.hysteresisQ8) gQuantizer.setHysteresis((uint8_t)gRcParams.hysteresisQ8);
+  if (gRcParams.calResets != prev.calResets) resetCalibration();
+}
 
 void taskRcInput(){
+  uint32_t lastSeenMs = millis() - RC_TIMEOUT_MS - 1;
+  bool present = false;
   while (true){
-    noInterrupts();
-    uint16_t us = gLastPulseUs;
-    uint32_t seen = gLastSeenMs;
-    interrupts();
-
-    if (millis() - seen > RC_TIMEOUT_MS){
-      gStablePercent = 0x7FFF;
-    } else if (us > 0){
-      uint16_t avg = filterPulse(us);
-      if (avg < gMinPulse) gMinPulse = avg;
-      if (avg > gMaxPulse) gMaxPulse = avg;
-      int16_t percent = throttlePercentFromUs(avg);
-      gStablePercent = percent;
+    PulseRecord rec;
+    bool any = false;
+    applyRcParams();
+    traceDrain();
+    while (gPulseRing.pop(rec)){
+      applyRcParams();
+      processPulse(rec);
+      gPulseCount++;
+      any = true;
     }
 
+    // 마지막 펄스 뒤 정확히 timeoutMs 가 지나면 끊김 (대기 시간과 같은 경계)
+    uint32_t idleMs = millis() - lastSeenMs;
+    if (any){
+      lastSeenMs = millis();
+      idleMs = 0;
+      if (!present) logEvent(LOG_SIGNAL_UP);
+      present = true;
+    } else if (idleMs >= gRcParams.timeoutMs){
+      signalLost(micros());
+      traceDrain();
+      traceFlush();
+      if (present) logEvent(LOG_SIGNAL_LOST);
+      present = false;
+    }
+
+#if RC_WAKE_POLLING
     ThisThread::sleep_for(2ms);
+#else
+    // 펄스가 오거나 남은 타임아웃이 지날 때까지 대기 (이미 끊겼으면 한 주기 통째로)
+    const uint32_t waitMs = idleMs < gRcParams.timeoutMs ? gRcParams.timeoutMs - idleMs : gRcParams.timeoutMs;
+    gRcEvents.wait_any_for(RC_EVT_PULSE, Kernel::Clock::duration_u32(waitMs));
+#endif
   }
 }
 
 void taskLed(){
-  int16_t lastPercent = 0x7FFF;
+  static AnimSeq seq;
+  LedChoice current = { RGB_OFF, 0 };
+  uint32_t lastSeq = 0;
+  uint32_t recheckMs = 0;
+  uint32_t paramsVersion = 0;
+#if LED_SHOW_PERCENT
+  bool shownValid = false;
+  int16_t shownNumber = 0;
+#endif
   while (true){
-    int16_t now = gStablePercent;
-    if (now != lastPercent){
-      if (now == 0x7FFF){
-        throttleBlinker.stop();
-        rgbOff();
-      } else {
-        const ValuePattern* pattern = findPattern(now);
-        if (pattern){
-          throttleBlinker.start(pattern->color, 200);
+    const SampleSnapshot sample = readSample();
+    const bool paramsChanged = refreshParams(gLedParams, paramsVersion);
+
+    // 새 샘플도 없고 재평가 시점도 아니면 (가짜 기상) 건너뜀
+    if (sample.seq != lastSeq || recheckMs || paramsChanged){
+      lastSeq = sample.seq;
+      const bool valid = sample.flags & SAMPLE_VALID;
+
+      LedChoice next = { RGB_OFF, 0 };
+      recheckMs = 0;
+      if (valid) next = choosePattern(sample.percent, millis(), recheckMs);
+
+      if (next.color != current.color || next.periodMs != current.periodMs){
+        if (next.periodMs){
+          blinkSequence(seq, next.color, next.periodMs);
+          ledAnimate(TRACK_PATTERN, seq);
         } else {
-          throttleBlinker.stop();
-          rgbOff();
+          ledAnimStop(TRACK_PATTERN);
         }
+        current = next;
       }
-      lastPercent = now;
+
+#if LED_SHOW_PERCENT
+      if (valid != shownValid || (valid && sample.percent != shownNumber)){
+        if (valid){
+          numberSequence(seq, sample.percent);
+          ledAnimate(TRACK_NUMBER, seq);
+        } else {
+          ledAnimStop(TRACK_NUMBER);
+        }
+        shownValid = valid;
+        shownNumber = sample.percent;
+      }
+#endif
+    }
+
+    // 퍼센트가 바뀔 때까지 대기. 체류/변화율 규칙이 걸려 있으면 그 시점에 재평가
+    if (recheckMs){
+      gLedEvents.wait_any_for(LED_EVT_SAMPLE, Kernel::Clock::duration_u32(recheckMs));
+    } else {
+      gLedEvents.wait_any_for(LED_EVT_SAMPLE, Kernel::wait_for_u32_forever);
     }
-    throttleBlinker.run();
-    ThisThread::sleep_for(20ms);
   }
 }
 
 // ------------------ Logger Task ------------------------------
 
+// 3초마다 상태를 로그 링에 적재 + 보정값 저장. Serial 은 직접 쓰지 않는다
 void taskLogger() {
   uint32_t last3s = millis();
+  uint32_t latCount = 0, latSum = 0;
 
   while (true) {
     uint32_t now = millis();
 
     if (Serial) {  // USB 연결된 경우에만 출력
-      // 3초마다 Min/Max 펄스 출력
       if (now - last3s >= 3000) {
-        Serial.print("[");
-        Serial.print(now / 1000);
-        Serial.print("s] MinPulse=");
-        Serial.print(gMinPulse);
-        Serial.print(", MaxPulse=");
-        Serial.println(gMaxPulse);
+        const SampleSnapshot sample = readSample();
+        logEvent(LOG_STATUS_CAL, gMinPulse, gMaxPulse, gPulseCount, gPulseRing.overruns(), sample.seq);
+
+        // 구간 평균 / 누적 최대 지연 (폴링 모드와 비교용)
+        const uint32_t n = gLatency.count - latCount;
+        const uint32_t sum = gLatency.sumUs - latSum;
+        latCount += n; latSum += sum;
+        logEvent(LOG_STATUS_SAMPLE, sample.rawUs, sample.avgUs, n ? sum / n : 0, gLatency.maxUs,
+                 gQuantizer.transitions(), gQuantizer.suppressed());
+#if RC_TELEMETRY
+        logEvent(LOG_STATUS_TELEM, gTelemetry.frames(), gTelemetry.drops());
+#endif
         last3s += 3000;
       }
     }
 
+    persistCalibration(now);
+
     ThisThread::sleep_for(100ms);
   }
 }
 
+// "[초.밀리초s] " + 포맷. 반환 = 길이
+static size_t formatLog(const LogRecord& r, char* out, size_t cap){
+  const int32_t* a = r.args;
+  int n = snprintf(out, cap, "[%u.%03us] ", (unsigned)(r.tMs / 1000), (unsigned)(r.tMs % 1000));
+  if (r.id < LOG_ID_COUNT && n > 0 && (size_t)n < cap){
+    n += snprintf(out + n, cap - n, LOG_FORMATS[r.id], a[0], a[1], a[2], a[3], a[4], a[5]);
+  }
+  if (n < 0) return 0;
+  if ((size_t)n > cap - 2) n = (int)(cap - 2);
+  out[n++] = '\n';
+  out[n] = 0;
+  return (size_t)n;
+}
+
+// ------------------ 명령 셸 ----------------------------------
+
+// 셸 편집본 (taskLogDrain 전용). 명령마다 통째로 gParams 에 게시
+static RuntimeParams gShellParams = defaultParams();
+
+struct ParamDesc {
+  const char* name;
+  uint16_t RuntimeParams::* field;
+  uint16_t min;
+  uint16_t max;
+};
+
+static constexpr ParamDesc PARAMS[] = {
+  { "avg_window",    &RuntimeParams::avgWindow,    1,  AVG_WINDOW },
+  { "timeout_ms",    &RuntimeParams::timeoutMs,    20, 5000 },
+  { "blink_ms",      &RuntimeParams::blinkMs,      20, 5000 },
+  { "hysteresis_q8", &RuntimeParams::hysteresisQ8, 0,  128 },
+};
+
+static const ParamDesc* findParam(const char* name){
+  for (const ParamDesc& p : PARAMS){
+    if (!strcmp(p.name, name)) return &p;
+  }
+  return nullptr;
+}
+
+static uint8_t findColor(const char* name){
+  for (uint8_t i = 0; i < COLOR_COUNT; ++i){
+    if (!strcmp(COLOR_NAMES[i], name)) return i;
+  }
+  return strcmp(name, "off") ? (uint8_t)COLOR_COUNT : COLOR_NONE;
+}
+
+// 게시 + 두 태스크를 깨워 바로 적용 (다음 샘플 전)
+static void publishParams(){
+  gParams.write(gShellParams);
+  gRcEvents.set(RC_EVT_PULSE);
+  gLedEvents.set(LED_EVT_SAMPLE);
+}
+
+static void printParams(ShellOut& out){
+  for (const ParamDesc& p : PARAMS) out.print("%s=%u\n", p.name, gShellParams.*p.field);
+}
+
+static void printPatterns(ShellOut& out){
+  out.print("patterns:");
+  for (int16_t v = -100; v <= 100; ++v){
+    const uint8_t c = gShellParams.valueColor[v + 100];
+    if (c < COLOR_COUNT) out.print(" %d=%s", v, COLOR_NAMES[c]);
+  }
+  out.print("\n");
+}
+
+static bool cmdGet(size_t argc, char* const* argv, ShellOut& out){
+  if (argc == 1){
+    printParams(out);
+    return true;
+  }
+  if (!strcmp(argv[1], "pattern")){
+    printPatterns(out);
+    return true;
+  }
+  const ParamDesc* p = findParam(argv[1]);
+  if (!p){
+    out.print("error: unknown parameter '%s'\n", argv[1]);
+    return true;
+  }
+  out.print("%s=%u\n", p->name, gShellParams.*p->field);
+  return true;
+}
+
+static bool cmdSet(size_t argc, char* const* argv, ShellOut& out){
+  int32_t v;
+  if (!strcmp(argv[1], "pattern")){
+    // set pattern <값> <색|off>
+    if (argc != 4 || !shellParseInt(argv[2], v)) return false;
+    const uint8_t color = findColor(argv[3]);
+    if (v < -100 || v > 100 || color == COLOR_COUNT){
+      out.print("error: value -100..100, color red|yellow|green|purple|blue|lime|orange|off\n");
+      return true;
+    }
+    gShellParams.valueColor[v + 100] = color;
+  } else {
+    const ParamDesc* p = findParam(argv[1]);
+    if (!p){
+      out.print("error: unknown parameter '%s'\n", argv[1]);
+      return true;
+    }
+    if (argc != 3 || !shellParseInt(argv[2], v)) return false;
+    if (v < p->min || v > p->max){
+      out.print("error: %s must be %u..%u\n", p->name, p->min, p->max);
+      return true;
+    }
+    gShellParams.*p->field = (uint16_t)v;
+  }
+  publishParams();
+  out.print("ok\n");
+  return true;
+}
+
+static bool cmdStats(size_t, char* const*, ShellOut& out){
+  out.print("pulses=%u overruns=%u lat_avg_us=%u lat_max_us=%u\n",
+            (unsigned)gPulseCount, (unsigned)gPulseRing.overruns(),
+            (unsigned)(gLatency.count ? gLatency.sumUs / gLatency.count : 0), (unsigned)gLatency.maxUs);
+  out.print("transitions=%u suppressed=%u log_drops=%u\n",
+            (unsigned)gQuantizer.transitions(), (unsigned)gQuantizer.suppressed(), (unsigned)gLog.drops());
+#if RC_TELEMETRY
+  out.print("telem_frames=%u telem_drops=%u\n", (unsigned)gTelemetry.frames(), (unsigned)gTelemetry.drops());
+#endif
+  return true;
+}
+
+static bool cmdResetCal(size_t, char* const*, ShellOut& out){
+  gShellParams.calResets++;
+  publishParams();
+  out.print("ok: calibration restarts with the next pulse\n");
+  return true;
+}
+
+static bool cmdDump(size_t, char* const*, ShellOut& out){
+  const SampleSnapshot s = readSample();
+  out.print("sample: seq=%u t_us=%u raw_us=%u avg_us=%u percent=%d flags=0x%x\n",
+            (unsigned)s.seq, (unsigned)s.tMicros, s.rawUs, s.avgUs, s.percent, s.flags);
+  out.print("cal: min=%u max=%u lut=%u..%u\n", gMinPulse, gMaxPulse, gPercentLut.calMin(), gPercentLut.calMax());
+  printParams(out);
+  printPatterns(out);
+  gRulesLock.lock();
+  const size_t rules = gRules.size();
+  gRulesLock.unlock();
+  out.print("rules=%u\n", (unsigned)rules);
+  return true;
+}
+
+// ---- 패턴 규칙 (rule) ----
+// 활성 규칙을 lo 순 사본으로 떠서 고친 뒤 통째로 다시 적재 (규칙 상태는 처음부터).
+// 적재는 즉시, 플래시 저장은 rule save 때만 (부팅 시 loadStoredRules 가 복원)
+
+static PatternRule gRuleEdit[RULES_MAX];   // taskLogDrain 전용
+
+static size_t copyActiveRules(){
+  gRulesLock.lock();
+  const size_t n = gRules.size();
+  for (size_t i = 0; i < n; ++i) gRuleEdit[i] = gRules.at(i);
+  gRulesLock.unlock();
+  return n;
+}
+
+// rule add 와 같은 형식으로 출력 (그대로 다시 붙여 넣을 수 있게)
+static void printRule(size_t i, const PatternRule& r, ShellOut& out){
+  out.print("%u: %d %d %s", (unsigned)i, r.lo, r.hi, r.color < COLOR_COUNT ? COLOR_NAMES[r.color] : "?");
+  if (r.dwellMs) out.print(" dwell=%u", r.dwellMs);
+  if (r.rateMin <= r.rateMax) out.print(" rate=%d:%d", r.rateMin, r.rateMax);
+  if (r.priority) out.print(" prio=%u", r.priority);
+  if (r.periodMs) out.print(" period=%u", r.periodMs);
+  out.print("\n");
+}
+
+// "key=값" 이면 값 부분을, 아니면 nullptr
+static char* ruleOption(char* arg, const char* key){
+  const size_t n = strlen(key);
+  return !strncmp(arg, key, n) && arg[n] == '=' ? arg + n + 1 : nullptr;
+}
+
+static bool parseRuleOption(char* arg, PatternRule& r){
+  char* v;
+  int32_t a, b;
+  if ((v = ruleOption(arg, "dwell"))){
+    if (!shellParseInt(v, a) || a < 0 || a > 0xFFFF) return false;
+    r.dwellMs = (uint16_t)a;
+  } else if ((v = ruleOption(arg, "rate"))){
+    // rate=min:max [%/s]
+    char* colon = strchr(v, ':');
+    if (!colon) return false;
+    *colon = 0;
+    const bool ok = shellParseInt(v, a) && shellParseInt(colon + 1, b);
+    *colon = ':';
+    if (!ok) return false;
+    if (a > b || a < INT16_MIN || b > INT16_MAX) return false;
+    r.rateMin = (int16_t)a;
+    r.rateMax = (int16_t)b;
+  } else if ((v = ruleOption(arg, "prio"))){
+    if (!shellParseInt(v, a) || a < 0 || a > 0xFF) return false;
+    r.priority = (uint8_t)a;
+  } else if ((v = ruleOption(arg, "period"))){
+    if (!shellParseInt(v, a) || (a && (a < 20 || a > 5000))) return false;
+    r.periodMs = (uint16_t)a;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+static bool cmdRule(size_t argc, char* const* argv, ShellOut& out){
+  size_t n = copyActiveRules();
+  if (argc == 1 || !strcmp(argv[1], "list")){
+    if (argc > 2) return false;
+    for (size_t i = 0; i < n; ++i) printRule(i, gRuleEdit[i], out);
+    out.print("rules=%u/%u\n", (unsigned)n, (unsigned)RULES_MAX);
+    return true;
+  }
+
+  int32_t lo, hi;
+  if (!strcmp(argv[1], "add")){
+    // rule add <lo> <hi> <색> [dwell=ms] [rate=min:max] [prio=n] [period=ms]
+    if (argc < 5 || !shellParseInt(argv[2], lo) || !shellParseInt(argv[3], hi)) return false;
+    const uint8_t color = findColor(argv[4]);
+    if (lo < -100 || hi > 100 || lo > hi || color >= COLOR_COUNT){
+      out.print("error: -100 <= lo <= hi <= 100, color red|yellow|green|purple|blue|lime|orange\n");
+      return true;
+    }
+    // 변화율 조건 없음 = rateMin > rateMax
+    PatternRule r = { (int16_t)lo, (int16_t)hi, 0, 1, 0, color, 0, 0 };
+    for (size_t i = 5; i < argc; ++i){
+      if (!parseRuleOption(argv[i], r)){
+        out.print("error: bad option '%s' (dwell=ms rate=min:max prio=n period=ms)\n", argv[i]);
+        return true;
+      }
+    }
+    if (n >= RULES_MAX){
+      out.print("error: rule table full (%u)\n", (unsigned)RULES_MAX);
+      return true;
+    }
+    gRuleEdit[n++] = r;
+  } else if (!strcmp(argv[1], "del")){
+    if (argc != 3 || !shellParseInt(argv[2], lo)) return false;
+    if (lo < 0 || (size_t)lo >= n){
+      out.print("error: no rule %d\n", (int)lo);
+      return true;
+    }
+    for (size_t i = (size_t)lo; i + 1 < n; ++i) gRuleEdit[i] = gRuleEdit[i + 1];
+    n--;
+  } else if (!strcmp(argv[1], "clear")){
+    if (argc != 2) return false;
+    n = 0;
+  } else if (!strcmp(argv[1], "save")){
+    if (argc != 2) return false;
+    const size_t saved = storePatternRules(gRuleEdit, n);
+    if (saved < n) out.print("warning: saved %u of %u rules (flash holds %u)\n",
+                             (unsigned)saved, (unsigned)n, (unsigned)RULES_STORED_MAX);
+    else out.print("ok: saved %u rules\n", (unsigned)saved);
+    return true;
+  } else {
+    return false;
+  }
+
+  loadPatternRules(gRuleEdit, n, false);
+  out.print("ok: %u rules (rule save to keep)\n", (unsigned)n);
+  return true;
+}
+
+// 정수만으로 백분율 한 자리 (printf 부동소수 지원 여부와 무관)
+static void printShare(ShellOut& out, uint32_t part, uint32_t total){
+  const uint32_t pm = total ? (uint32_t)((uint64_t)part * 1000 / total) : 0;
+  out.print("%u.%u%%", (unsigned)(pm / 10), (unsigned)(pm % 10));
+}
+
+static void printAccValue(const AccuracyStats& a, int16_t v, ShellOut& out){
+  out.print("v=%d samples=%u (", v, (unsigned)a.count(v));
+  printShare(out, a.count(v), a.samples() - a.invalid());
+  out.print(") hits=%u dwell_ms=%u max_dwell_ms=%u settles=%u\n",
+            (unsigned)a.hits(v), (unsigned)a.dwellMs(v), (unsigned)a.maxDwellMs(v), (unsigned)a.settles(v));
+}
+
+static void printAccSummary(const AccuracyStats& a, ShellOut& out){
+  int16_t cur = 0;
+  const bool have = a.current(cur);
+  out.print("samples=%u invalid=%u transitions=%u current=", (unsigned)a.samples(),
+            (unsigned)a.invalid(), (unsigned)a.transitions());
+  if (have) out.print("%d\n", cur);
+  else out.print("none\n");
+
+  static const char* const STEP_NAMES[AccuracyStats::STEP_BUCKETS] = { "1", "2", "3", "4", "5-9", "10+" };
+  out.print("steps:");
+  for (size_t i = 0; i < AccuracyStats::STEP_BUCKETS; ++i) out.print(" %s=%u", STEP_NAMES[i], (unsigned)a.stepHist(i));
+  out.print("\nsettle_ms:");
+  for (size_t i = 0; i < AccuracyStats::SETTLE_BUCKETS; ++i){
+    if (i + 1 < AccuracyStats::SETTLE_BUCKETS) out.print(" <%u=%u", (unsigned)AccuracyStats::settleBucketLimitMs(i), (unsigned)a.settleHist(i));
+    else out.print(" >=%u=%u", (unsigned)AccuracyStats::settleBucketLimitMs(i - 1), (unsigned)a.settleHist(i));
+  }
+  out.print("\n");
+}
+
+// 패턴이 걸린 값들 (params.valueColor)
+static void printAccTargets(const AccuracyStats& a, const RuntimeParams& params, ShellOut& out){
+  for (int16_t v = AccuracyStats::MIN_VALUE; v <= AccuracyStats::MAX_VALUE; ++v){
+    if (params.valueColor[v + 100] < COLOR_COUNT) printAccValue(a, v, out);
+  }
+}
+
+static bool cmdAcc(size_t argc, char* const* argv, ShellOut& out){
+  if (argc >= 2 && !strcmp(argv[1], "reset")){
+    gAccuracyLock.lock();
+    gAccuracy.reset();
+    gAccuracyLock.unlock();
+    out.print("ok\n");
+    return true;
+  }
+
+  // 조회는 사본으로 (잠금은 복사하는 동안만)
+  static AccuracyStats a;
+  gAccuracyLock.lock();
+  a = gAccuracy;
+  gAccuracyLock.unlock();
+
+  int32_t v, hi;
+  if (argc == 1){
+    printAccSummary(a, out);
+  } else if (!strcmp(argv[1], "targets")){
+    printAccTargets(a, gShellParams, out);
+  } else if (!strcmp(argv[1], "hist")){
+    // acc hist [lo] [hi] : 0 이 아닌 칸만
+    v = AccuracyStats::MIN_VALUE;
+    hi = AccuracyStats::MAX_VALUE;
+    if (argc >= 3 && !shellParseInt(argv[2], v)) return false;
+    if (argc >= 4 && !shellParseInt(argv[3], hi)) return false;
+    if (argc == 3) hi = v;
+    if (v < AccuracyStats::MIN_VALUE) v = AccuracyStats::MIN_VALUE;
+    if (hi > AccuracyStats::MAX_VALUE) hi = AccuracyStats::MAX_VALUE;
+    for (; v <= hi; ++v){
+      if (a.count((int16_t)v)) out.print("%d=%u\n", (int)v, (unsigned)a.count((int16_t)v));
+    }
+  } else if (argc == 2 && shellParseInt(argv[1], v) && AccuracyStats::inRange((int16_t)v)){
+    printAccValue(a, (int16_t)v, out);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// 펄스 폭 히스토그램 (창 안 최근 펄스). 조회마다 잠깐 잠근다 (사본 없음)
+static bool cmdPulse(size_t argc, char* const* argv, ShellOut& out){
+  if (argc == 1){
+    static const uint16_t Q_PERMILLE[] = { 5, 50, 250, 500, 750, 950, 995 };
+    uint16_t q[sizeof(Q_PERMILLE) / sizeof(Q_PERMILLE[0])];
+    gPulseHistLock.lock();
+    const size_t n = gPulseHist.size();
+    const uint16_t mode = gPulseHist.mode();
+    const uint16_t modeCount = gPulseHist.modeCount();
+    for (size_t i = 0; i < sizeof(q) / sizeof(q[0]); ++i) q[i] = gPulseHist.quantile(Q_PERMILLE[i]);
+    gPulseHistLock.unlock();
+
+    out.print("n=%u/%u mode=%u (%u)\n", (unsigned)n, (unsigned)PulseHist::window(), mode, modeCount);
+    out.print("q:");
+    for (size_t i = 0; i < sizeof(q) / sizeof(q[0]); ++i) out.print(" p%u.%u=%u", Q_PERMILLE[i] / 10, Q_PERMILLE[i] % 10, q[i]);
+    out.print("\n");
+    return true;
+  }
+
+  // pulse <us> [hi] : 0 이 아닌 칸만
+  int32_t lo, hi;
+  if (!shellParseInt(argv[1], lo)) return false;
+  hi = lo;
+  if (argc >= 3 && !shellParseInt(argv[2], hi)) return false;
+  if (lo < RC_MIN_US) lo = RC_MIN_US;
+  if (hi > RC_MAX_US) hi = RC_MAX_US;
+  for (; lo <= hi; ++lo){
+    gPulseHistLock.lock();
+    const uint16_t c = gPulseHist.count((uint16_t)lo);
+    gPulseHistLock.unlock();
+    if (c) out.print("%d=%u\n", (int)lo, c);
+  }
+  return true;
+}
+
+static constexpr ShellCommand SHELL_COMMANDS[] = {
+  { "get",       0, 1, cmdGet,      "get [name|pattern]" },
+  { "set",       2, 3, cmdSet,      "set <name> <value> | set pattern <value> <color|off>" },
+  { "stats",     0, 0, cmdStats,    "stats" },
+  { "reset-cal", 0, 0, cmdResetCal, "reset-cal" },
+  { "dump",      0, 0, cmdDump,     "dump" },
+  { "acc",       0, 3, cmdAcc,      "acc [<value>|targets|hist [lo] [hi]|reset]" },
+  { "pulse",     0, 2, cmdPulse,    "pulse [<us> [hi]]" },
+  { "rule",      0, 8, cmdRule,     "rule [list|add <lo> <hi> <color> [dwell=ms] [rate=min:max] [prio=n] [period=ms]|del <i>|clear|save]" },
+};
+static_assert(shellNamesUnique(SHELL_COMMANDS), "SHELL_COMMANDS has duplicate names");
+
+static Shell<96, 8> gShell(SHELL_COMMANDS);   // 인자 8 = rule add 전체 옵션
+
+// ------------------ 로그 송신 / 셸 태스크 ---------------------
+
+// 가장 낮은 우선순위. Serial 입출력 전담: 셸 입력 → 응답, 로그 링 / 트레이스 → 한 줄씩.
+// 보낼 수 있는 만큼만 보내고 나머지는 다음 차례. 호스트가 못 받으면
+// 링이 차고 생산자 쪽에서 버린다 (drops) → 어떤 태스크도 안 막힘
+// 응답이 버퍼를 넘쳤을 때 끝에 붙이는 표시
+static const char SHELL_TRUNCATED_NOTE[] = "...(truncated)\n";
+
+void taskLogDrain(){
+  static char line[3 + 2 * sizeof(TraceChunk) + 2];
+  static char reply[1536];
+  // 뒤에 줄바꿈 1 + 잘림 표시 자리를 남겨 둔다
+  ShellOut shellOut(reply, sizeof(reply) - sizeof(SHELL_TRUNCATED_NOTE));
+  const char* pending = nullptr;
+  size_t len = 0, off = 0;
+  uint32_t reported = 0;
+  LogRecord rec;
+
+  while (true){
+    if (!Serial){
+      // 미연결: 예전처럼 출력하지 않음 (쌓인 것도 버림, drops 로 세지 않음)
+      while (gLog.pop(rec)) {}
+      len = off = 0;
+      reported = gLog.drops();
+      ThisThread::sleep_for(100ms);
+      continue;
+    }
+
+    if (off < len){
+      // 한 줄 / 응답 전체를 송신권 안에서 (텔레메트리 묶음 사이에만 끼어듦)
+      gSerialTx.lock();
+      while (true){
+        off += halSerialWriteSome(reinterpret_cast<const uint8_t*>(pending) + off, len - off);
+        if (off >= len || !Serial) break;
+        ThisThread::sleep_for(1ms);
+      }
+      gSerialTx.unlock();
+      if (off < len) continue;   // 도중에 끊김 → 위에서 버림
+    }
+    len = off = 0;
+    pending = line;
+
+    // 셸 입력이 먼저 (응답을 다 보내기 전엔 다음 줄을 읽지 않음)
+    shellOut.clear();
+    bool ran = false;
+    while (!ran && Serial.available() > 0) ran = gShell.feed((char)Serial.read(), shellOut);
+    if (shellOut.size()){
+      pending = reply;
+      len = shellOut.size();
+      if (shellOut.truncated()){
+        if (reply[len - 1] != '\n') reply[len++] = '\n';   // 끊긴 줄은 닫고
+        memcpy(reply + len, SHELL_TRUNCATED_NOTE, sizeof(SHELL_TRUNCATED_NOTE) - 1);
+        len += sizeof(SHELL_TRUNCATED_NOTE) - 1;
+      }
+      continue;
+    }
+
+    const uint32_t drops = gLog.drops();
+    if (drops != reported){
+      const LogRecord note = { millis(), LOG_DROPPED, 1, { (int32_t)(drops - reported) } };
+      len = formatLog(note, line, sizeof(line));
+      reported = drops;
+    } else if (gLog.pop(rec)){
+      len = formatLog(rec, line, sizeof(line));
+    } else if (!(len = traceFormatLine(line, sizeof(line))) && !ran){
+      ThisThread::sleep_for(20ms);
+    }
+  }
+}
+
+// ============================================================
+// ------------------ 마이크로 벤치마크 (RC_BENCHMARK) ---------
+// ============================================================
+
+#if RC_BENCHMARK
+
+static const uint32_t BENCH_OPS = 1000;
+static const uint32_t BENCH_ROUNDS = 31;
+static const size_t BENCH_INPUTS = 1024;          // 2의 거듭제곱 (i & MASK 로 순환)
+static const size_t BENCH_MASK = BENCH_INPUTS - 1;
+
+static uint16_t gBenchUs[BENCH_INPUTS];
+static int16_t gBenchPercent[BENCH_INPUTS];
+
+// 비교 기준: 매번 복사 + 삽입 정렬하는 중앙값 (O(N²))
+template <size_t N>
+struct NaiveMedian {
+  uint16_t buf[N] = {};
+  size_t count = 0;
+  size_t pos = 0;
+
+  uint16_t push(uint16_t v){
+    buf[pos] = v;
+    pos = (pos + 1) % N;
+    if (count < N) count++;
+    uint16_t t[N];
+    for (size_t i = 0; i < count; ++i){
+      size_t j = i;
+      while (j > 0 && t[j - 1] > buf[i]){ t[j] = t[j - 1]; j--; }
+      t[j] = buf[i];
+    }
+    return t[count / 2];
+  }
+};
+
+// 같은 입력으로 인덱스 이중 힙 / 정렬 중앙값 비교 (창이 클수록 차이가 벌어진다)
+template <size_t N>
+static void benchMedian(const char* indexedName, const char* naiveName){
+  static SlidingMedian<N> median;
+  benchRun(indexedName, BENCH_OPS, BENCH_ROUNDS, [](uint32_t i){
+    benchKeep(median.push(gBenchUs[i & BENCH_MASK]));
+  });
+  static NaiveMedian<N> naive;
+  benchRun(naiveName, BENCH_OPS, BENCH_ROUNDS, [](uint32_t i){
+    benchKeep(naive.push(gBenchUs[i & BENCH_MASK]));
+  });
+}
+
+// 범위 규칙 16개 (choosePattern 이 실제 조회를 하도록)
+static void loadBenchRules(){
+  PatternRule rules[16];
+  for (int i = 0; i < 16; ++i){
+    const int16_t lo = (int16_t)(-100 + i * 12);
+    rules[i] = PatternRule{ lo, (int16_t)(lo + 15), 0, 1, 0, (uint8_t)(i % COLOR_COUNT), 0, 0 };
+  }
+  loadPatternRules(rules, 16, false);
+}
+
+void runBenchmarks(){
+  while (!Serial && millis() < 5000) {}
+  benchBegin();
+
+  const BenchParam params[] = {
+    { "rc_filter",        RC_FILTER },
+    { "avg_window",       AVG_WINDOW },
+    { "hist_window",      PULSE_HIST_WINDOW },
+    { "hampel_window",    RC_HAMPEL_WINDOW },
+    { "hysteresis_q8",    RC_HYSTERESIS_Q8 },
+    { "led_pwm_bits",     LED_PWM_BITS },
+    { "anim_tick_ms",     LED_ANIM_TICK_MS },
+    { "rc_capture_timer", RC_CAPTURE_TIMER },
+    { "budget_us",        2000 },
+  };
+  benchConfig(params, sizeof(params) / sizeof(params[0]));
+
+  // 입력: 시드 고정 합성 신호 (1000→2000µs 스윕 + 지터 σ2µs) → 같은 빌드면 같은 입력
+  RcSignalConfig cfg;
+  cfg.jitterGaussUs = 2.0f;
+  RcSignalGen gen(cfg, 0x5EED);
+  RcEdge edges[RcSignalGen::MAX_EDGES];
+  for (size_t i = 0; i < BENCH_INPUTS; ++i){
+    gen.setWidthUs(1000.0f + 1000.0f * (float)i / (float)BENCH_MASK);
+    const size_t n = gen.nextFrame(edges);
+    gBenchUs[i] = n >= 2 ? (uint16_t)((edges[1].tNs - edges[0].tNs + 500) / 1000) : 1500;
+    gBenchPercent[i] = (int16_t)((int32_t)(i * 201 / BENCH_INPUTS) - 100);
+  }
+  gPercentLut.rebuild(1000, 2000);
+  loadBenchRules();
+
+  benchRun("baseline", BENCH_OPS, BENCH_ROUNDS, [](uint32_t i){ benchKeep(i); });
+
+  benchRun("filterPulse", BENCH_OPS, BENCH_ROUNDS, [](uint32_t i){
+    benchKeep(filterPulse(gBenchUs[i & BENCH_MASK]));
+  });
+
+  benchMedian<5>("median5_indexed", "median5_naive");
+  benchMedian<15>("median15_indexed", "median15_naive");
+  benchMedian<31>("median31_indexed", "median31_naive");
+  benchMedian<63>("median63_indexed", "median63_naive");
+
+  static PulseHist hist;
+  benchRun("pulseHistPush", BENCH_OPS, BENCH_ROUNDS, [](uint32_t i){
+    benchKeep(hist.push(gBenchUs[i & BENCH_MASK]));
+  });
+
+  benchRun("throttlePercentFromUs", BENCH_OPS, BENCH_ROUNDS, [](uint32_t i){
+    benchKeep(throttlePercentFromUs(gBenchUs[i & BENCH_MASK]));
+  });
+
+  benchRun("quantizePercent", BENCH_OPS, BENCH_ROUNDS, [](uint32_t i){
+    const uint16_t us = gBenchUs[i & BENCH_MASK];
+    benchKeep(quantizePercent(us, throttlePercentFromUs(us)));
+  });
+
+  benchRun("findPattern", BENCH_OPS, BENCH_ROUNDS, [](uint32_t i){
+    benchKeep(findPattern(gBenchPercent[i & BENCH_MASK]) != nullptr);
+  });
+
+  benchRun("choosePattern", BENCH_OPS, BENCH_ROUNDS, [](uint32_t i){
+    uint32_t recheckMs = 0;
+    benchKeep(choosePattern(gBenchPercent[i & BENCH_MASK], i * 20, recheckMs).periodMs);
+  });
+
+  // 펄스 1개의 태스크 쪽 전체 경로 (필터 → 보정 → LUT → 양자화 → 게시)
+  benchRun("processPulse", BENCH_OPS, BENCH_ROUNDS, [](uint32_t i){
+    processPulse(PulseRecord{ micros(), gBenchUs[i & BENCH_MASK] });
+  });
+
+  // 구 Blinker::run 자리: 애니메이션 휠 1틱 (점멸 재생 중, 토글 시 LED 출력 포함)
+  static AnimSeq seq;
+  blinkSequence(seq, RGB_RED, DEFAULT_BLINK_MS);
+  gAnimator.play(TRACK_PATTERN, seq, 0);
+  static uint32_t animMs = 0;
+  benchRun("animTick", BENCH_OPS, BENCH_ROUNDS, [](uint32_t){
+    animMs += LED_ANIM_TICK_MS;
+    gAnimator.tick(animMs);
+  });
+  gAnimator.stop(TRACK_PATTERN);
+
+  // ISR 본체: 링 적재 + 이벤트 플래그 (소비 쪽 pop 포함)
+  benchRun("isr_capture", BENCH_OPS, BENCH_ROUNDS, [](uint32_t i){
+    RcPulse pulse = { gBenchUs[i & BENCH_MASK], 0, 0, true };
+    onRcPulse(pulse, i);
+    PulseRecord rec;
+    benchKeep(gPulseRing.pop(rec));
+  });
+  benchRun("isr_gpio", BENCH_OPS, BENCH_ROUNDS, [](uint32_t){
+    onRcChange();
+    PulseRecord rec;
+    benchKeep(gPulseRing.pop(rec));
+  });
+}
+
+#endif
+
 // ============================================================
-// ------------------ Watchdog -------------------------------
+// ------------------ 트레이스 재생 (RC_REPLAY, 호스트) ----------
 // ============================================================
 
-void initWatchdog(uint32_t timeout_ms){
-  IWDG1->KR = 0x5555;
-  IWDG1->PR = 4;
-  IWDG1->RLR = (timeout_ms * 32);
-  IWDG1->KR = 0xCCCC;
+#if RC_REPLAY
+
+// 재생 중 상태. 시각은 64비트로 이어 붙여 71분 순환을 넘긴다
+struct ReplayState {
+  uint32_t riseUs = 0;
+  bool haveRise = false;
+  uint32_t lastEdgeUs = 0;
+  uint64_t tUs = 0;
+  uint64_t lastPulseUs = 0;
+  bool anyPulse = false;
+  uint32_t nextSeq = 0;
+
+  uint32_t chunks = 0, badChunks = 0, seqGaps = 0;
+  uint32_t edges = 0, samples = 0, lost = 0, lit = 0;
+};
+
+static void replayEdge(ReplayState& st, uint32_t t, bool high){
+  st.tUs += (uint32_t)(t - st.lastEdgeUs);
+  st.lastEdgeUs = t;
+  st.edges++;
+
+  // 청크 유실 뒤 첫 하강 에지는 짝이 없다
+  if (!high && !st.haveRise) return;
+  st.haveRise = high;
+
+  PulseRecord rec;
+  if (!edgeToPulse(high, t, st.riseUs, rec)) return;
+
+  // taskRcInput 과 같은 타임아웃 판정 (펄스 사이 공백)
+  if (st.anyPulse && st.tUs - st.lastPulseUs > (uint64_t)RC_TIMEOUT_MS * 1000){
+    signalLost(rec.tUs);
+    st.lost++;
+  }
+  st.anyPulse = true;
+  st.lastPulseUs = st.tUs;
+
+  processPulse(rec);
+  st.samples++;
+
+  const SampleSnapshot& s = gLastSample;
+  uint32_t recheckMs = 0;
+  LedChoice led = { RGB_OFF, 0 };
+  if (s.flags & SAMPLE_VALID) led = choosePattern(s.percent, (uint32_t)(st.tUs / 1000), recheckMs);
+  if (led.periodMs) st.lit++;
+
+  printf("%llu,%u,%u,%d,%u,%u,%u,%02x%02x%02x,%u\n",
+         (unsigned long long)st.tUs, s.rawUs, s.avgUs, s.percent,
+         (s.flags & SAMPLE_VALID) ? 1u : 0u, gPercentLut.calMin(), gPercentLut.calMax(),
+         led.color.r, led.color.g, led.color.b, led.periodMs);
 }
 
-void kickWatchdog(){
-  IWDG1->KR = 0xAAAA;
+static void replayChunk(ReplayState& st, const uint8_t* buf, size_t len){
+  TraceChunkHeader h;
+  const bool first = st.chunks == 0;
+  // 헤더만 먼저 확인해 이어지는 청크인지 판정
+  if (len >= sizeof(h)) memcpy(&h, buf, sizeof(h));
+  if (len < sizeof(h) || h.magic != TRACE_MAGIC){
+    st.badChunks++;
+    return;
+  }
+  if (first){
+    // 부팅 직후부터 기록됐으면 그때의 저장 보정값으로 시작 (기기와 같은 초기 상태)
+    if (h.seq == 0 && h.calMin < h.calMax){
+      gMinPulse = h.calMin;
+      gMaxPulse = h.calMax;
+      gPercentLut.rebuild(gMinPulse, gMaxPulse);
+    }
+    st.lastEdgeUs = h.startUs;
+  } else if (h.seq != st.nextSeq){
+    st.seqGaps++;
+    st.haveRise = false;
+  }
+  st.nextSeq = h.seq + 1;
+
+  const bool ok = traceDecodeChunk(buf, len, h, [&](uint32_t t, bool high){ replayEdge(st, t, high); });
+  if (ok) st.chunks++;
+  else st.badChunks++;
 }
 
+// RC_TRACE_FILE: 바이너리 청크 연속, 또는 "#T <hex>" 줄이 섞인 Serial 로그
+void runReplay(){
+  const char* path = getenv("RC_TRACE_FILE");
+  if (!path) path = "trace.log";
+  FILE* f = fopen(path, "rb");
+  if (!f){
+    fprintf(stderr, "replay: cannot open %s\n", path);
+    exit(1);
+  }
+
+  ReplayState st;
+  static uint8_t buf[sizeof(TraceChunk)];
+  printf("t_us,raw_us,avg_us,percent,valid,cal_min,cal_max,led_rgb,led_period_ms\n");
+
+  uint32_t magic = 0;
+  const bool binary = fread(&magic, 1, sizeof(magic), f) == sizeof(magic) && magic == TRACE_MAGIC;
+  rewind(f);
+
+  if (binary){
+    while (fread(buf, 1, sizeof(TraceChunkHeader), f) == sizeof(TraceChunkHeader)){
+      TraceChunkHeader h;
+      memcpy(&h, buf, sizeof(h));
+      if (h.magic != TRACE_MAGIC || h.bytes > TRACE_CHUNK_DATA) break;
+      if (fread(buf + sizeof(h), 1, h.bytes, f) != h.bytes) break;
+      replayChunk(st, buf, sizeof(h) + h.bytes);
+    }
+  } else {
+    static char line[2 * sizeof(TraceChunk) + 64];
+    while (fgets(line, sizeof(line), f)){
+      const size_t n = traceParseHexLine(line, buf, sizeof(buf));
+      if (n) replayChunk(st, buf, n);
+    }
+  }
+  fclose(f);
+
+  fprintf(stderr, "replay: chunks=%u bad=%u seq_gaps=%u edges=%u samples=%u signal_lost=%u led_on=%u\n",
+          st.chunks, st.badChunks, st.seqGaps, st.edges, st.samples, st.lost, st.lit);
+
+  // 셸 acc / acc targets 와 같은 형식
+  static char report[4096];
+  ShellOut out(report, sizeof(report));
+  printAccSummary(gAccuracy, out);
+  printAccTargets(gAccuracy, gLedParams, out);
+  fputs(report, stderr);
+  exit(0);
+}
+
+#endif
+
+// ============================================================
+// ------------------ 텔레메트리 복호 (RC_TELEMETRY_DECODE, 호스트)
+// ============================================================
+
+#if RC_TELEMETRY_DECODE
+
+// 예: cat /dev/ttyACM0 | program > samples.csv  (텍스트 로그가 섞여 있어도 됨)
+void runTelemetryDecode(){
+  const char* path = getenv("RC_TELEMETRY_FILE");
+  FILE* f = path ? fopen(path, "rb") : stdin;
+  if (!f){
+    fprintf(stderr, "telemetry: cannot open %s\n", path);
+    exit(1);
+  }
+
+  TelemetryDecoder dec;
+  static uint8_t buf[4096];
+  printf("seq,t_us,raw_us,avg_us,percent,flags\n");
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0){
+    dec.feed(buf, n, [](const TelemetrySample& s){
+      printf("%u,%u,%u,%u,%d,%u\n", s.seq, s.tMicros, s.rawUs, s.avgUs, s.percent, s.flags);
+    });
+  }
+  if (f != stdin) fclose(f);
+
+  fprintf(stderr, "telemetry: samples=%u lost=%u crc_errors=%u bad_frames=%u\n",
+          dec.samples(), dec.lost(), dec.crcErrors(), dec.badFrames());
+  exit(0);
+}
+
+#endif
+
 // ============================================================
 // ------------------ 아두이노 엔트리 --------------------------
 // ============================================================
@@ -292,22 +1856,47 @@ void kickWatchdog(){
 void setup(){
   Serial.begin(115200);
   pinMode(LEDR, OUTPUT); pinMode(LEDG, OUTPUT); pinMode(LEDB, OUTPUT);
+  ledPwmBegin();
   rgbOff();
 
+#if RC_BENCHMARK
+  // 벤치마크 빌드: 입력 인터럽트 / 태스크 / 워치독 없이 측정만
+  runBenchmarks();
+  benchFinish();
+  return;
+#endif
+#if RC_REPLAY
+  runReplay();
+#endif
+#if RC_TELEMETRY_DECODE
+  runTelemetryDecode();
+#endif
+
   pinMode(RC_PIN, INPUT);
+#if RC_CAPTURE_TIMER
+  if (!rcCaptureBegin(RC_MIN_US, RC_MAX_US, onRcPulse))
+#endif
   attachInterrupt(RC_PIN, onRcChange, CHANGE);
 
-  initWatchdog(1000);
+  loadCalibration();
+  loadStoredRules();
+  gPercentLut.rebuild(gMinPulse, gMaxPulse);
+
+  halWatchdogBegin(1000);
 
   threadRcInput.start(taskRcInput);
   threadLed.start(taskLed);
   threadLogger.start(taskLogger);
+  threadLogDrain.start(taskLogDrain);
+#if RC_TELEMETRY
+  threadTelemetry.start(taskTelemetry);
+#endif
 }
 
 void loop(){
   static unsigned long lastKick = 0;
   if (millis() - lastKick >= 100){
-    kickWatchdog();
+    halWatchdogKick();
     lastKick = millis();
   }
 
@@ -0,0 +1,144 @@
+// ============================================================
+// RC 입력 캡처 백엔드 구현 (TIM1_CH1 양 에지 캡처 → DMA2_Stream7)
+// ============================================================
+
+#include "hal.h"
+#include "rc_capture_tim.h"
+
+#if defined(ARDUINO)
+
+#ifndef RC_CAPTURE_DMA_STREAM
+#define RC_CAPTURE_DMA_STREAM   DMA2_Stream7
+#define RC_CAPTURE_DMAMUX_CH    DMAMUX1_Channel15   // DMA2 스트림 n = DMAMUX 채널 8+n
+#define RC_CAPTURE_DMA_CLR()    (DMA2->HIFCR = DMA_HIFCR_CTCIF7 | DMA_HIFCR_CHTIF7 | \
+                                 DMA_HIFCR_CTEIF7 | DMA_HIFCR_CDMEIF7 | DMA_HIFCR_CFEIF7)
+#endif
+
+namespace {
+
+// DMA1/2 는 DTCM 에 접근할 수 없으므로 기본 .bss(AXI SRAM)에 둔다.
+// 캐시 무효화 단위(32B)에 맞춰 정렬.
+alignas(32) volatile uint16_t sRing[RC_CAPTURE_RING];
+static_assert(sizeof(sRing) % 32 == 0, "ring must be whole cache lines");
+
+RcEdgeDecoder sDecoder;
+RcPulseHandler sOnPulse = nullptr;
+size_t sTail = 0;
+uint16_t sLastCnt = 0;
+uint32_t sExt = 0;
+
+inline bool rcPinHigh(){
+  return (GPIOK->IDR & GPIO_PIN_1) != 0;
+}
+
+// APB2 타이머 클럭: 분주가 있으면 PCLK2 x2
+uint32_t tim1ClockHz(){
+  const uint32_t pclk2 = HAL_RCC_GetPCLK2Freq();
+  return (RCC->D2CFGR & RCC_D2CFGR_D2PPRE2_2) ? pclk2 * 2 : pclk2;
+}
+
+// 반주기(CC2)와 오버플로(UPDATE)마다 호출 → 드레인 간격 < 2^15 틱
+void onTim1Irq(){
+  const uint32_t sr = TIM1->SR;
+  TIM1->SR = ~(sr & (TIM_SR_UIF | TIM_SR_CC2IF | TIM_SR_CC1OF));
+
+  // NDTR 을 카운터보다 먼저 읽어야 링에 있는 캡처가 모두 cnt 이전 값이 된다
+  const size_t head = (RC_CAPTURE_RING - RC_CAPTURE_DMA_STREAM->NDTR) % RC_CAPTURE_RING;
+  const uint16_t cnt = (uint16_t)TIM1->CNT;
+  const uint32_t nowUs = micros();
+
+  sExt += (uint16_t)(cnt - sLastCnt);
+  sLastCnt = cnt;
+
+  SCB_InvalidateDCache_by_Addr((uint32_t*)sRing, sizeof(sRing));
+  const uint32_t tpu = sDecoder.ticksPerUs();
+  const auto deliver = [nowUs, tpu](const RcPulse& p){
+    if (sOnPulse) sOnPulse(p, nowUs - (sExt - p.fallTick) / tpu);
+  };
+  sDecoder.drain(sRing, RC_CAPTURE_RING, sTail, head, cnt, sExt, deliver, deliver);
+
+  // CC1IF 가 안 비워진 채 다음 캡처 → 에지 유실, 위상 재동기화
+  if (sr & TIM_SR_CC1OF) sDecoder.resync(rcPinHigh());
+}
+
+} // namespace
+
+bool rcCaptureBegin(uint16_t minUs, uint16_t maxUs, RcPulseHandler onPulse){
+  const uint32_t timHz = tim1ClockHz();
+  if (timHz % RC_CAPTURE_TICK_HZ) return false;
+
+  sOnPulse = onPulse;
+  sDecoder.configure(RC_CAPTURE_TICK_HZ / 1000000UL, minUs, maxUs);
+
+  __HAL_RCC_GPIOK_CLK_ENABLE();
+  __HAL_RCC_TIM1_CLK_ENABLE();
+  __HAL_RCC_DMA2_CLK_ENABLE();
+
+  GPIO_InitTypeDef gpio = {};
+  gpio.Pin = GPIO_PIN_1;
+  gpio.Mode = GPIO_MODE_AF_PP;
+  gpio.Pull = GPIO_NOPULL;
+  gpio.Speed = GPIO_SPEED_FREQ_LOW;
+  gpio.Alternate = GPIO_AF1_TIM1;
+  HAL_GPIO_Init(GPIOK, &gpio);
+
+  // ---- DMA: TIM1->CCR1 (16bit) → sRing, 원형 ----
+  RC_CAPTURE_DMA_STREAM->CR &= ~DMA_SxCR_EN;
+  while (RC_CAPTURE_DMA_STREAM->CR & DMA_SxCR_EN) {}
+  RC_CAPTURE_DMA_CLR();
+  RC_CAPTURE_DMAMUX_CH->CCR = DMA_REQUEST_TIM1_CH1;
+  RC_CAPTURE_DMA_STREAM->PAR  = (uint32_t)&TIM1->CCR1;
+  RC_CAPTURE_DMA_STREAM->M0AR = (uint32_t)sRing;
+  RC_CAPTURE_DMA_STREAM->NDTR = RC_CAPTURE_RING;
+  RC_CAPTURE_DMA_STREAM->FCR  = 0;   // 직접 모드
+  RC_CAPTURE_DMA_STREAM->CR   = DMA_SxCR_PL_1 | DMA_SxCR_MSIZE_0 | DMA_SxCR_PSIZE_0 |
+                                DMA_SxCR_MINC | DMA_SxCR_CIRC;
+  RC_CAPTURE_DMA_STREAM->CR  |= DMA_SxCR_EN;
+  sTail = 0;
+
+  // ---- TIM1: 자유 구동 16비트, CH1 양 에지 캡처, CH2 반주기 인터럽트 ----
+  TIM1->CR1 = 0;
+  TIM1->PSC = timHz / RC_CAPTURE_TICK_HZ - 1;
+  TIM1->ARR = 0xFFFF;
+  // IC1F=0011: fCK_INT 8샘플 필터 (양 에지에 같은 지연 → 폭 불변)
+  TIM1->CCMR1 = TIM_CCMR1_CC1S_0 | TIM_CCMR1_IC1F_1 | TIM_CCMR1_IC1F_0;
+  TIM1->CCR2 = 0x8000;
+  TIM1->CCER = TIM_CCER_CC1P | TIM_CCER_CC1NP | TIM_CCER_CC1E;
+  TIM1->EGR = TIM_EGR_UG;
+  TIM1->SR = 0;
+  TIM1->DIER = TIM_DIER_CC1DE | TIM_DIER_CC2IE | TIM_DIER_UIE;
+
+  sLastCnt = 0;
+  sExt = 0;
+  sDecoder.reset(rcPinHigh());
+
+  NVIC_SetVector(TIM1_UP_IRQn, (uint32_t)&onTim1Irq);
+  NVIC_SetVector(TIM1_CC_IRQn, (uint32_t)&onTim1Irq);
+  NVIC_SetPriority(TIM1_UP_IRQn, 2);
+  NVIC_SetPriority(TIM1_CC_IRQn, 2);
+  NVIC_EnableIRQ(TIM1_UP_IRQn);
+  NVIC_EnableIRQ(TIM1_CC_IRQn);
+
+  TIM1->CR1 = TIM_CR1_CEN;
+  return true;
+}
+
+const RcEdgeDecoder& rcCaptureDecoder(){
+  return sDecoder;
+}
+
+#else  // 호스트: 캡처 타이머 없음 → main 은 GPIO 인터럽트 경로로 대체
+
+namespace {
+RcEdgeDecoder sDecoder;
+} // namespace
+
+bool rcCaptureBegin(uint16_t, uint16_t, RcPulseHandler){
+  return false;
+}
+
+const RcEdgeDecoder& rcCaptureDecoder(){
+  return sDecoder;
+}
+
+#endif
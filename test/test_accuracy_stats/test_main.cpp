@@ -0,0 +1,212 @@
+// ============================================================
+// AccuracyStats 테스트
+// ------------------------------------------------------------
+//  - 손으로 계산한 시나리오: 안착 → 이동(3 → 5) → 안착, 신호 끊김이 체류를 닫고
+//    안착 추적을 초기화, 범위 밖 값은 무효
+//  - 무작위 샘플 열 (µs 순환 포함) 을 통째로 "같은 값 구간" 으로 나눠 계산한
+//    기준과 모든 조회 값이 같다 (값별 수 / 진입 / 체류 합 / 최장 체류 / 안착,
+//    전이 수 / 폭 분포 / 안착 시간 분포)
+// ============================================================
+
+#include <unity.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+#include "accuracy_stats.h"
+
+static uint32_t gRng = 0xACC0u;
+static uint32_t rnd(){
+  gRng ^= gRng << 13; gRng ^= gRng >> 17; gRng ^= gRng << 5;
+  return gRng;
+}
+
+void setUp(void){ gRng = 0xACC0u; }
+void tearDown(void){}
+
+static const uint32_t MS = 1000;
+
+static void test_hand_scenario(void){
+  static AccuracyStats acc(250);
+  acc.reset();
+  acc.observe(0, true, 0);
+  acc.observe(0, true, 300 * MS);          // 250ms 넘게 유지 → 0 에 안착
+  TEST_ASSERT_EQUAL_UINT32(1, acc.settles(0));
+  acc.observe(3, true, 400 * MS);          // 안착에서 벗어남 (이동 시작 400ms)
+  acc.observe(5, true, 450 * MS);
+  acc.observe(5, true, 700 * MS);          // 450ms 에 들어온 5 에 안착 → 이동 50ms
+  acc.observe(0, false, 800 * MS);         // 신호 끊김: 5 의 체류를 닫음
+  acc.observe(5, true, 900 * MS);          // 끊김 뒤 재진입: 전이 아님
+  acc.observe(5, true, 1200 * MS);         // 다시 안착, 이동 중이 아니었으므로 분포 없음
+  acc.observe(101, true, 1300 * MS);       // 범위 밖 = 무효
+
+  TEST_ASSERT_EQUAL_UINT32(9, acc.samples());
+  TEST_ASSERT_EQUAL_UINT32(2, acc.invalid());
+  TEST_ASSERT_EQUAL_UINT32(2, acc.transitions());
+  TEST_ASSERT_EQUAL_UINT32(1, acc.stepHist(1));     // 3 → 5
+  TEST_ASSERT_EQUAL_UINT32(1, acc.stepHist(2));     // 0 → 3
+
+  TEST_ASSERT_EQUAL_UINT32(2, acc.count(0));
+  TEST_ASSERT_EQUAL_UINT32(1, acc.count(3));
+  TEST_ASSERT_EQUAL_UINT32(4, acc.count(5));
+  TEST_ASSERT_EQUAL_UINT32(2, acc.hits(5));
+  TEST_ASSERT_EQUAL_UINT32(2, acc.settles(5));
+  TEST_ASSERT_EQUAL_UINT32(0, acc.settles(3));
+
+  TEST_ASSERT_EQUAL_UINT32(400, acc.dwellMs(0));
+  TEST_ASSERT_EQUAL_UINT32(50, acc.dwellMs(3));
+  TEST_ASSERT_EQUAL_UINT32(350 + 400, acc.dwellMs(5));   // 800-450, 1300-900 (무효 샘플이 닫음)
+  TEST_ASSERT_EQUAL_UINT32(400, acc.maxDwellMs(5));
+
+  // 50ms → [32, 64) 구간 하나뿐
+  uint32_t total = 0;
+  for (size_t i = 0; i < AccuracyStats::SETTLE_BUCKETS; ++i) total += acc.settleHist(i);
+  TEST_ASSERT_EQUAL_UINT32(1, total);
+  TEST_ASSERT_EQUAL_UINT32(1, acc.settleHist(2));
+
+  int16_t v = 0;
+  TEST_ASSERT_FALSE(acc.current(v));
+  acc.observe(-7, true, 1400 * MS);
+  TEST_ASSERT_TRUE(acc.current(v));
+  TEST_ASSERT_EQUAL_INT16(-7, v);
+  TEST_ASSERT_EQUAL_UINT32(0, acc.count(-101));     // 범위 밖 조회는 0
+}
+
+// ------------------ 무작위 열 vs 구간 기준 ------------------
+
+struct Sample { int16_t v; bool valid; uint32_t t; };
+
+struct Reference {
+  uint32_t samples = 0, invalid = 0, transitions = 0;
+  uint32_t count[AccuracyStats::VALUES] = {};
+  uint32_t hits[AccuracyStats::VALUES] = {};
+  uint64_t dwellUs[AccuracyStats::VALUES] = {};
+  uint32_t maxDwellMs[AccuracyStats::VALUES] = {};
+  uint32_t settles[AccuracyStats::VALUES] = {};
+  uint32_t stepHist[AccuracyStats::STEP_BUCKETS] = {};
+  uint32_t settleHist[AccuracyStats::SETTLE_BUCKETS] = {};
+};
+
+static bool good(const Sample& s){ return s.valid && AccuracyStats::inRange(s.v); }
+
+// 열 전체를 같은 값 구간으로 나눈 뒤 정의대로 센다
+static void buildReference(const std::vector<Sample>& in, uint32_t settleUs, Reference& r){
+  const size_t n = in.size();
+  r.samples = (uint32_t)n;
+  bool moving = false;
+  uint32_t moveStart = 0;
+
+  size_t i = 0;
+  while (i < n){
+    if (!good(in[i])){
+      r.invalid++;
+      moving = false;
+      i++;
+      continue;
+    }
+    // [i, j) = 같은 값 구간
+    size_t j = i;
+    while (j < n && good(in[j]) && in[j].v == in[i].v) j++;
+    const size_t idx = (size_t)(in[i].v - AccuracyStats::MIN_VALUE);
+    r.count[idx] += (uint32_t)(j - i);
+    r.hits[idx]++;
+
+    // 시작 샘플 뒤 샘플 중 하나라도 settleUs 이상 지났으면 안착
+    bool settled = false;
+    for (size_t k = i + 1; k < j && !settled; ++k) settled = in[k].t - in[i].t >= settleUs;
+    if (settled){
+      r.settles[idx]++;
+      if (moving){
+        const uint32_t ms = (in[i].t - moveStart) / 1000;
+        size_t b = 0;
+        while (b + 1 < AccuracyStats::SETTLE_BUCKETS && ms >= AccuracyStats::settleBucketLimitMs(b)) b++;
+        r.settleHist[b]++;
+        moving = false;
+      }
+    }
+
+    if (j < n){
+      // 다음 샘플이 구간을 닫는다
+      const uint32_t us = in[j].t - in[i].t;
+      r.dwellUs[idx] += us;
+      if (us / 1000 > r.maxDwellMs[idx]) r.maxDwellMs[idx] = us / 1000;
+      if (good(in[j])){
+        r.transitions++;
+        const int32_t d = in[j].v > in[i].v ? in[j].v - in[i].v : in[i].v - in[j].v;
+        r.stepHist[d >= 10 ? 5 : d >= 5 ? 4 : d - 1]++;
+        if (settled){ moving = true; moveStart = in[j].t; }
+      }
+    }
+    i = j;
+  }
+}
+
+static void checkRandom(uint32_t settleMs, size_t samples){
+  std::vector<Sample> in;
+  in.reserve(samples);
+  uint32_t t = 0xFFFFFFFFu - 60000000u;    // 1분 뒤 µs 순환
+  int16_t v = 0;
+  while (in.size() < samples){
+    const uint32_t r = rnd();
+    // 값 하나를 몇 샘플 유지 (짧은 흔들림 ~ 긴 안착)
+    if ((r & 31) == 0){
+      v = (int16_t)(-100 + (int32_t)((r >> 8) % 201));         // 큰 점프
+    } else if ((r & 3) != 0){
+      v = (int16_t)(v + (int32_t)((r >> 8) % 7) - 3);          // 근처로 이동
+      if (v < -100) v = -100;
+      if (v > 100) v = 100;
+    }
+    const size_t hold = 1 + ((r >> 20) & 1 ? (r >> 12) % 40 : (r >> 12) % 3);
+    for (size_t k = 0; k < hold && in.size() < samples; ++k){
+      const uint32_t q = rnd();
+      t += 1000 + q % 40000;                                   // 1 ~ 41ms 간격
+      if ((q >> 24) < 1) in.push_back(Sample{ 0, false, t });                  // 끊김
+      else if ((q >> 24) == 1) in.push_back(Sample{ 120, true, t });           // 범위 밖
+      else in.push_back(Sample{ v, true, t });
+    }
+  }
+
+  static Reference ref;
+  ref = Reference();
+  buildReference(in, settleMs * 1000, ref);
+
+  static AccuracyStats acc;
+  acc = AccuracyStats(settleMs);
+  for (const Sample& s : in) acc.observe(s.v, s.valid, s.t);
+
+  TEST_ASSERT_EQUAL_UINT32(ref.samples, acc.samples());
+  TEST_ASSERT_EQUAL_UINT32(ref.invalid, acc.invalid());
+  TEST_ASSERT_EQUAL_UINT32(ref.transitions, acc.transitions());
+  for (size_t b = 0; b < AccuracyStats::STEP_BUCKETS; ++b) TEST_ASSERT_EQUAL_UINT32(ref.stepHist[b], acc.stepHist(b));
+  uint32_t settleTotal = 0;
+  for (size_t b = 0; b < AccuracyStats::SETTLE_BUCKETS; ++b){
+    TEST_ASSERT_EQUAL_UINT32(ref.settleHist[b], acc.settleHist(b));
+    settleTotal += ref.settleHist[b];
+  }
+  TEST_ASSERT_GREATER_THAN(100, settleTotal);      // 분포가 실제로 채워졌다
+
+  for (int16_t v2 = AccuracyStats::MIN_VALUE; v2 <= AccuracyStats::MAX_VALUE; ++v2){
+    const size_t idx = (size_t)(v2 - AccuracyStats::MIN_VALUE);
+    if (acc.count(v2) != ref.count[idx] || acc.hits(v2) != ref.hits[idx] ||
+        acc.settles(v2) != ref.settles[idx] || acc.maxDwellMs(v2) != ref.maxDwellMs[idx] ||
+        acc.dwellMs(v2) != ref.dwellUs[idx] / 1000){
+      char msg[160];
+      snprintf(msg, sizeof(msg), "settle %ums, value %d: count %u/%u hits %u/%u settles %u/%u max %u/%u",
+               (unsigned)settleMs, v2, acc.count(v2), ref.count[idx], acc.hits(v2), ref.hits[idx],
+               acc.settles(v2), ref.settles[idx], acc.maxDwellMs(v2), ref.maxDwellMs[idx]);
+      TEST_FAIL_MESSAGE(msg);
+    }
+  }
+}
+
+static void test_random_matches_reference(void){
+  checkRandom(250, 300000);
+  checkRandom(40, 300000);
+  checkRandom(1000, 300000);
+}
+
+int main(int, char**){
+  UNITY_BEGIN();
+  RUN_TEST(test_hand_scenario);
+  RUN_TEST(test_random_matches_reference);
+  return UNITY_END();
+}
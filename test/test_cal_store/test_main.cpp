@@ -0,0 +1,242 @@
+// ============================================================
+// 보정값 저장 정책 (CalSaver) + 호스트 키-값 저장소 테스트
+// ------------------------------------------------------------
+// HAL 가상 시계를 100ms 씩 (taskLogger 주기) 진행하며 persistCalibration 과
+// 같은 순서로 poll → kvSet → committed. 쓰기 횟수와 시각을 확인한다:
+//  - 스윕 중(1초마다 바뀜)에는 안 씀, 멈추면 정확히 SettleMs 뒤 1회
+//  - MinDeltaUs 미만 변화는 안 씀, 큰 변화도 IntervalMs 전에는 안 씀
+//  - 재부팅: 불러온 값과 같으면 안 씀
+//  - 부팅당 MaxWrites 회에서 멈춤 (플래시 수명)
+//  - src/ 의 loadCalibration 뒤 부분 스윕은 저장값을 좁히지 않음, 넓은 스윕은 넓힘
+// 저장소: 정확한 크기만 읽힘, 덮어쓰기, 없는 키, 임시 파일 안 남음
+// ============================================================
+
+#include <unity.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "hal.h"
+#include "cal_store.h"
+#include "kv_store.h"
+
+#ifndef KV_STORE_DIR
+#define KV_STORE_DIR "."
+#endif
+
+static const char* const KEY = "test_cal";
+static const char* const PATH = KV_STORE_DIR "/kv_test_cal.bin";
+static const char* const APP_PATH = KV_STORE_DIR "/kv_cal.bin";   // src/main.cpp 의 "cal"
+
+// src/main.cpp (test_build_src)
+bool loadCalibration();
+void calibrate(uint16_t avg);
+void persistCalibration(uint32_t nowMs);
+void updatePercentLut();
+int16_t throttlePercentFromUs(uint16_t us);
+
+static uint32_t gT0;   // 시나리오 시작 millis
+
+static uint32_t elapsedMs(){ return millis() - gT0; }
+
+// taskLogger + persistCalibration 과 같은 호출 순서
+template <typename Saver>
+struct Logger {
+  Saver saver;
+  std::vector<uint32_t> writes;   // 시나리오 시작 기준 [ms]
+
+  void poll(uint16_t minUs, uint16_t maxUs){
+    const uint32_t now = millis();
+    if (!saver.poll(minUs, maxUs, now)) return;
+    const CalRecord rec = { CalRecord::MAGIC, CalRecord::VERSION, minUs, maxUs };
+    TEST_ASSERT_TRUE(kvSet(KEY, &rec, sizeof(rec)));
+    saver.committed(minUs, maxUs, now);
+    writes.push_back(elapsedMs());
+  }
+
+  // ms 동안 같은 값을 100ms 마다 poll
+  void run(uint32_t ms, uint16_t minUs, uint16_t maxUs){
+    for (uint32_t t = 0; t < ms; t += 100){
+      poll(minUs, maxUs);
+      halClockAdvanceUs(100000);
+    }
+  }
+};
+
+static CalRecord stored(){
+  CalRecord rec = {};
+  TEST_ASSERT_TRUE(kvGet(KEY, &rec, sizeof(rec)));
+  TEST_ASSERT_TRUE(rec.valid());
+  return rec;
+}
+
+static void expectWrites(const std::vector<uint32_t>& got, const std::vector<uint32_t>& want){
+  char msg[64];
+  snprintf(msg, sizeof(msg), "writes: got %u, want %u", (unsigned)got.size(), (unsigned)want.size());
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(want.size(), got.size(), msg);
+  for (size_t i = 0; i < want.size(); ++i){
+    snprintf(msg, sizeof(msg), "write %u at %u ms, want %u ms", (unsigned)i, got[i], want[i]);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(want[i], got[i], msg);
+  }
+}
+
+void setUp(void){
+  remove(PATH);
+  gT0 = millis();
+}
+void tearDown(void){}
+
+static void test_settle_delta_and_interval(void){
+  static Logger<CalSaver<>> log;
+  log = Logger<CalSaver<>>();
+
+  // 0 ~ 10초: 스윕 (1초마다 경계가 바뀜) → 안 씀
+  for (uint16_t i = 0; i < 10; ++i) log.run(1000, (uint16_t)(1100 - 10 * i), (uint16_t)(1900 + 10 * i));
+  expectWrites(log.writes, {});
+  CalRecord rec;
+  TEST_ASSERT_FALSE(kvGet(KEY, &rec, sizeof(rec)));
+
+  // 10초부터 1000..2000 유지 → 5초 뒤 (15초) 1회
+  log.run(10000, 1000, 2000);
+  expectWrites(log.writes, { 15000 });
+  TEST_ASSERT_EQUAL_UINT16(1000, stored().minUs);
+  TEST_ASSERT_EQUAL_UINT16(2000, stored().maxUs);
+
+  // 20 ~ 35초: 1µs 흔들림 (MinDeltaUs 2 미만) → 안 씀
+  log.run(15000, 1001, 2000);
+  expectWrites(log.writes, { 15000 });
+
+  // 35초: 5µs 이동. 40초에 안정되지만 마지막 쓰기(15초) 뒤 60초 → 75초
+  log.run(45000, 1005, 2000);
+  expectWrites(log.writes, { 15000, 75000 });
+  TEST_ASSERT_EQUAL_UINT16(1005, stored().minUs);
+
+  // 3초마다 바뀌면 (5초 안정 불가) 아무리 길어도 안 씀
+  for (int i = 0; i < 40; ++i) log.run(3000, (uint16_t)(990 + (i & 1) * 20), 2000);
+  expectWrites(log.writes, { 15000, 75000 });
+  TEST_ASSERT_EQUAL_UINT32(2, log.saver.writes());
+}
+
+static void test_reboot_keeps_loaded_value(void){
+  // 이전 부팅이 저장한 값
+  const CalRecord saved = { CalRecord::MAGIC, CalRecord::VERSION, 1010, 1990 };
+  TEST_ASSERT_TRUE(kvSet(KEY, &saved, sizeof(saved)));
+
+  static Logger<CalSaver<>> log;
+  log = Logger<CalSaver<>>();
+  const CalRecord rec = stored();
+  log.saver.loaded(rec.minUs, rec.maxUs);
+
+  // 같은 값 / 1µs 차이로 한참 유지 → 안 씀
+  log.run(20000, 1010, 1990);
+  log.run(20000, 1011, 1990);
+  expectWrites(log.writes, {});
+
+  // 2µs 이상 바뀌면 안정 5초 뒤 바로 (이번 부팅 첫 쓰기라 간격 제한 없음)
+  log.run(10000, 1010, 1993);
+  expectWrites(log.writes, { 45000 });
+  TEST_ASSERT_EQUAL_UINT16(1993, stored().maxUs);
+
+  // 뒤집힌 / 빈 경계 (미보정) 는 저장하지 않음
+  log.run(120000, 2000, 1000);
+  expectWrites(log.writes, { 45000 });
+}
+
+static void test_write_budget_per_boot(void){
+  // 안정 1초, 간격 2초, 부팅당 4회
+  static Logger<CalSaver<2, 1000, 2000, 4>> log;
+  log = Logger<CalSaver<2, 1000, 2000, 4>>();
+
+  // 3초마다 10µs 씩 이동 → 각 구간 1초 지점에서 쓰기, 4회 뒤 멈춤
+  for (uint16_t i = 0; i < 20; ++i) log.run(3000, (uint16_t)(1000 + 10 * i), 2000);
+  expectWrites(log.writes, { 1000, 4000, 7000, 10000 });
+  TEST_ASSERT_EQUAL_UINT32(4, log.saver.writes());
+  TEST_ASSERT_EQUAL_UINT16(1030, stored().minUs);
+}
+
+// taskRcInput (50Hz 삼각파 lo..hi) + taskLogger (100ms) 를 ms 동안
+static void sweepAndPersist(uint32_t ms, uint16_t lo, uint16_t hi){
+  static uint32_t phase = 0;
+  const uint32_t span = hi - lo;
+  for (uint32_t t = 0; t < ms; t += 100){
+    for (int i = 0; i < 5; ++i, phase += 20){
+      const uint32_t p = phase % (2 * span);
+      calibrate((uint16_t)(lo + (p < span ? p : 2 * span - p)));
+      updatePercentLut();
+    }
+    persistCalibration(millis());
+    halClockAdvanceUs(100000);
+  }
+}
+
+static CalRecord appStored(){
+  CalRecord rec = {};
+  TEST_ASSERT_TRUE(kvGet("cal", &rec, sizeof(rec)));
+  TEST_ASSERT_TRUE(rec.valid());
+  return rec;
+}
+
+static void test_partial_sweep_keeps_loaded_bounds(void){
+  const CalRecord saved = { CalRecord::MAGIC, CalRecord::VERSION, 1000, 2000 };
+  TEST_ASSERT_TRUE(kvSet("cal", &saved, sizeof(saved)));
+  TEST_ASSERT_TRUE(loadCalibration());
+
+  // 1200..1900 만 80초 (4000 샘플, 폭 700µs ≥ CAL_MIN_SPAN_US) → 저장값 / 변환 그대로
+  sweepAndPersist(80000, 1200, 1900);
+  TEST_ASSERT_EQUAL_UINT16(1000, appStored().minUs);
+  TEST_ASSERT_EQUAL_UINT16(2000, appStored().maxUs);
+  TEST_ASSERT_EQUAL_INT16(-100, throttlePercentFromUs(1000));
+  TEST_ASSERT_EQUAL_INT16(0, throttlePercentFromUs(1500));
+  TEST_ASSERT_EQUAL_INT16(100, throttlePercentFromUs(2000));
+
+  // 불러온 폭보다 넓게 움직이면 그 쪽은 반영되어 저장
+  sweepAndPersist(120000, 900, 2100);
+  const CalRecord wider = appStored();
+  TEST_ASSERT_LESS_OR_EQUAL(990, wider.minUs);
+  TEST_ASSERT_GREATER_OR_EQUAL(2010, wider.maxUs);
+  remove(APP_PATH);
+}
+
+static void test_kv_store_exact_size(void){
+  CalRecord rec = {};
+  TEST_ASSERT_FALSE(kvGet(KEY, &rec, sizeof(rec)));   // 없는 키
+
+  const CalRecord a = { CalRecord::MAGIC, CalRecord::VERSION, 1000, 2000 };
+  TEST_ASSERT_TRUE(kvSet(KEY, &a, sizeof(a)));
+  TEST_ASSERT_TRUE(kvGet(KEY, &rec, sizeof(rec)));
+  TEST_ASSERT_EQUAL_MEMORY(&a, &rec, sizeof(a));
+
+  // 크기가 다르면 (구 버전 레코드 등) 읽지 않음
+  uint8_t bigger[sizeof(CalRecord) + 1];
+  TEST_ASSERT_FALSE(kvGet(KEY, bigger, sizeof(bigger)));
+  TEST_ASSERT_FALSE(kvGet(KEY, bigger, sizeof(CalRecord) - 1));
+
+  // 덮어쓰기 + 임시 파일은 rename 으로 사라짐
+  const CalRecord b = { CalRecord::MAGIC, CalRecord::VERSION, 1111, 1888 };
+  TEST_ASSERT_TRUE(kvSet(KEY, &b, sizeof(b)));
+  TEST_ASSERT_TRUE(kvGet(KEY, &rec, sizeof(rec)));
+  TEST_ASSERT_EQUAL_UINT16(1111, rec.minUs);
+  TEST_ASSERT_EQUAL_UINT16(1888, rec.maxUs);
+  FILE* tmp = fopen((std::string(PATH) + ".tmp").c_str(), "rb");
+  TEST_ASSERT_NULL(tmp);
+  if (tmp) fclose(tmp);
+
+  // 깨진 레코드는 valid() 가 거른다
+  const CalRecord bad = { CalRecord::MAGIC, (uint16_t)(CalRecord::VERSION + 1), 1000, 2000 };
+  TEST_ASSERT_TRUE(kvSet(KEY, &bad, sizeof(bad)));
+  TEST_ASSERT_TRUE(kvGet(KEY, &rec, sizeof(rec)));
+  TEST_ASSERT_FALSE(rec.valid());
+}
+
+int main(int, char**){
+  halClockManual(true);
+  kvInit();
+  UNITY_BEGIN();
+  RUN_TEST(test_settle_delta_and_interval);
+  RUN_TEST(test_reboot_keeps_loaded_value);
+  RUN_TEST(test_write_budget_per_boot);
+  RUN_TEST(test_partial_sweep_keeps_loaded_bounds);
+  RUN_TEST(test_kv_store_exact_size);
+  remove(PATH);
+  return UNITY_END();
+}
@@ -0,0 +1,139 @@
+// ============================================================
+// Ema / OneEuro / Pipeline 테스트
+// ------------------------------------------------------------
+//  - Ema<α> 계단 응답: N 번째 출력이 닫힌 식 b + (a - b)(1 - α)^N 과 1µs 이내
+//    (위/아래 계단, α = 1 은 바로 따라감, 입력 0 은 값 유지)
+//  - OneEuro: 느린 드리프트 + 잡음은 매끄럽게 (잔차가 입력 잡음보다 작음),
+//    큰 계단은 같은 최소 컷오프의 EMA 보다 훨씬 빨리 따라감
+//  - Pipeline<Median<5>, Ema<…>>: 가상 함수 없음 (컴파일 타임 확인), 단계 순서대로 적용
+// ============================================================
+
+#include <unity.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <type_traits>
+#include "filter_pipeline.h"
+
+// 조합이 가상 호출 / vtable 없이 단계 값만으로 이루어진다
+typedef Pipeline<Median<5>, Ema<Q15(0.1)>> MedianEma;
+static_assert(!std::is_polymorphic<MedianEma>::value, "Pipeline must not use virtual dispatch");
+static_assert(!std::is_polymorphic<Ema<Q15(0.1)>>::value && !std::is_polymorphic<OneEuro<>>::value,
+              "filter stages must not use virtual dispatch");
+static_assert(sizeof(MedianEma) <= sizeof(Median<5>) + sizeof(Ema<Q15(0.1)>) + sizeof(void*),
+              "Pipeline must hold only its stages");
+static_assert(std::is_same<decltype(std::declval<MedianEma&>().push(0)), uint16_t>::value,
+              "Pipeline::push must return the last stage output");
+
+static uint32_t gRng = 0xE3A5u;
+static uint32_t rnd(){
+  gRng ^= gRng << 13; gRng ^= gRng >> 17; gRng ^= gRng << 5;
+  return gRng;
+}
+
+void setUp(void){ gRng = 0xE3A5u; }
+void tearDown(void){}
+
+template <uint16_t AlphaQ15>
+static void checkEmaStep(uint16_t from, uint16_t to, uint32_t steps){
+  Ema<AlphaQ15> ema;
+  TEST_ASSERT_EQUAL_UINT16(0, ema.value());
+  TEST_ASSERT_EQUAL_UINT16(from, ema.push(from));   // 첫 값으로 초기화
+
+  const double alpha = AlphaQ15 / 32768.0;
+  char msg[96];
+  for (uint32_t n = 1; n <= steps; ++n){
+    const uint16_t got = ema.push(to);
+    const double want = to + ((double)from - to) * pow(1.0 - alpha, (double)n);
+    snprintf(msg, sizeof(msg), "alpha %u, %u->%u step %u: got %u want %.2f",
+             AlphaQ15, from, to, (unsigned)n, got, want);
+    TEST_ASSERT_TRUE_MESSAGE(fabs(got - want) <= 1.0, msg);
+  }
+  TEST_ASSERT_EQUAL_UINT16(to, ema.value());
+
+  // 0 = 값 없음 → 상태 유지
+  TEST_ASSERT_EQUAL_UINT16(to, ema.push(0));
+  ema.reset();
+  TEST_ASSERT_EQUAL_UINT16(0, ema.value());
+}
+
+static void test_ema_step_matches_closed_form(void){
+  checkEmaStep<Q15(0.1)>(1000, 2000, 200);
+  checkEmaStep<Q15(0.1)>(2000, 1000, 200);
+  checkEmaStep<Q15(0.02)>(1500, 1900, 1000);
+  checkEmaStep<Q15(0.5)>(1900, 1100, 60);
+
+  // α = 1 은 지연 없음
+  Ema<Q15(1.0)> follow;
+  follow.push(1000);
+  TEST_ASSERT_EQUAL_UINT16(1873, follow.push(1873));
+  TEST_ASSERT_EQUAL_UINT16(901, follow.push(901));
+}
+
+// ±3µs 균등 잡음
+static float noise(){ return (float)(rnd() % 7) - 3.0f; }
+
+static void test_one_euro_smooths_slow_drift(void){
+  OneEuro<1000, 5000, 50> f;
+  double inErr = 0.0, outErr = 0.0;
+  uint32_t n = 0;
+  // 10초 동안 1500 → 1520 (2µs/s) + 잡음. 처음 1초는 수렴 구간이라 제외
+  for (uint32_t i = 0; i < 500; ++i){
+    const float truth = 1500.0f + 20.0f * (float)i / 500.0f;
+    const uint16_t in = (uint16_t)(truth + noise() + 0.5f);
+    const uint16_t out = f.push(in);
+    if (i < 50) continue;
+    inErr += ((double)in - truth) * ((double)in - truth);
+    outErr += ((double)out - truth) * ((double)out - truth);
+    n++;
+  }
+  const double inRms = sqrt(inErr / n), outRms = sqrt(outErr / n);
+  char msg[80];
+  snprintf(msg, sizeof(msg), "input rms %.2f, output rms %.2f", inRms, outRms);
+  TEST_ASSERT_TRUE_MESSAGE(outRms < inRms * 0.6, msg);
+}
+
+static void test_one_euro_tracks_fast_step(void){
+  OneEuro<1000, 5000, 50> fast;
+  Ema<Q15(0.112)> slow;   // 최소 컷오프 1Hz @ 50Hz 와 같은 α
+  for (int i = 0; i < 100; ++i){ fast.push(1000); slow.push(1000); }
+
+  // 1000 → 2000: 목표 ±10µs 안에 들어오는 프레임 수
+  int fastFrames = -1, slowFrames = -1;
+  for (int i = 1; i <= 200; ++i){
+    const uint16_t a = fast.push(2000);
+    const uint16_t b = slow.push(2000);
+    if (fastFrames < 0 && a >= 1990) fastFrames = i;
+    if (slowFrames < 0 && b >= 1990) slowFrames = i;
+  }
+  char msg[64];
+  snprintf(msg, sizeof(msg), "one-euro %d frames, ema %d frames", fastFrames, slowFrames);
+  TEST_ASSERT_TRUE_MESSAGE(fastFrames > 0 && fastFrames <= 10, msg);
+  TEST_ASSERT_TRUE_MESSAGE(slowFrames >= 3 * fastFrames, msg);
+
+  // 계단 뒤 과도 진동 없이 제자리
+  for (int i = 0; i < 50; ++i) fast.push(2000);
+  TEST_ASSERT_EQUAL_UINT16(2000, fast.value());
+}
+
+static void test_pipeline_applies_stages_in_order(void){
+  MedianEma p;
+  Median<5> median;
+  Ema<Q15(0.1)> ema;
+  for (uint32_t i = 0; i < 5000; ++i){
+    uint16_t v = (uint16_t)(1400 + rnd() % 200);
+    if ((i & 15) == 0) v = (uint16_t)(v + 400);   // 중앙값이 걸러낼 튀는 값
+    TEST_ASSERT_EQUAL_UINT16(ema.push(median.push(v)), p.push(v));
+  }
+  p.reset();
+  TEST_ASSERT_EQUAL_UINT16(1500, p.push(1500));
+}
+
+int main(int, char**){
+  UNITY_BEGIN();
+  RUN_TEST(test_ema_step_matches_closed_form);
+  RUN_TEST(test_one_euro_smooths_slow_drift);
+  RUN_TEST(test_one_euro_tracks_fast_step);
+  RUN_TEST(test_pipeline_applies_stages_in_order);
+  return UNITY_END();
+}
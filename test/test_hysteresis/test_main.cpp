@@ -0,0 +1,146 @@
+// ============================================================
+// HysteresisQuantizer 테스트 (PercentLut 1000..2000 과 함께)
+// ------------------------------------------------------------
+//  - 모든 구간 경계에서 ±1µs 흔들림 → 출력 고정, suppressed 만 증가
+//    (위 / 아래 어느 쪽에서 시작해도)
+//  - 여유(margin) 를 넘는 이동은 바로 받아들임, transitions 증가
+//  - 히스테리시스 0 이면 같은 흔들림이 매번 전이로 보임 (비교 기준)
+//  - 큰 계단 입력은 한 번에 건너감, reset 뒤 첫 값은 그대로
+//  - 보정 없음(W < 201) 은 통과, setHysteresis 는 128 에서 포화
+// ============================================================
+
+#include <unity.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "hysteresis_quantizer.h"
+#include "percent_lut.h"
+
+typedef PercentLut<800, 2200> Lut;
+
+static const uint16_t CAL_MIN = 1000;
+static const uint16_t CAL_MAX = 2000;
+static Lut gLut;
+
+static int16_t feed(HysteresisQuantizer& q, uint16_t us){
+  return q.update(us, gLut.lookup(us), gLut.calMin(), gLut.calMax());
+}
+
+void setUp(void){ gLut.rebuild(CAL_MIN, CAL_MAX); }
+void tearDown(void){}
+
+// 경계 = LUT 값이 바뀌는 첫 µs
+static void forEachBoundary(void (*fn)(uint16_t u0)){
+  for (uint16_t u = CAL_MIN + 1; u <= CAL_MAX; ++u){
+    if (gLut.lookup(u) != gLut.lookup(u - 1)) fn(u);
+  }
+}
+
+static void checkDitherFromBelow(uint16_t u0){
+  HysteresisQuantizer q(64);
+  const int16_t below = feed(q, u0 - 1);
+  for (int i = 0; i < 10; ++i){
+    char msg[64];
+    snprintf(msg, sizeof(msg), "boundary %u (from below)", u0);
+    TEST_ASSERT_TRUE_MESSAGE(feed(q, u0) == below, msg);
+    TEST_ASSERT_TRUE_MESSAGE(feed(q, u0 - 1) == below, msg);
+  }
+  TEST_ASSERT_EQUAL_UINT32(10, q.suppressed());
+  TEST_ASSERT_EQUAL_UINT32(0, q.transitions());
+
+  // 여유 64/256 구간 ≈ 1.2µs < 2µs → 받아들임
+  TEST_ASSERT_EQUAL_INT16(gLut.lookup(u0 + 2), feed(q, u0 + 2));
+  TEST_ASSERT_EQUAL_UINT32(1, q.transitions());
+}
+
+static void checkDitherFromAbove(uint16_t u0){
+  HysteresisQuantizer q(64);
+  const int16_t above = feed(q, u0);
+  for (int i = 0; i < 10; ++i){
+    char msg[64];
+    snprintf(msg, sizeof(msg), "boundary %u (from above)", u0);
+    TEST_ASSERT_TRUE_MESSAGE(feed(q, u0 - 1) == above, msg);
+    TEST_ASSERT_TRUE_MESSAGE(feed(q, u0) == above, msg);
+  }
+  TEST_ASSERT_EQUAL_UINT32(10, q.suppressed());
+  TEST_ASSERT_EQUAL_UINT32(0, q.transitions());
+
+  TEST_ASSERT_EQUAL_INT16(gLut.lookup(u0 - 3), feed(q, u0 - 3));
+  TEST_ASSERT_EQUAL_UINT32(1, q.transitions());
+}
+
+static void test_dither_at_every_boundary_is_stable(void){
+  size_t boundaries = 0;
+  for (uint16_t u = CAL_MIN + 1; u <= CAL_MAX; ++u) boundaries += gLut.lookup(u) != gLut.lookup(u - 1);
+  TEST_ASSERT_EQUAL_UINT32(200, boundaries);
+  forEachBoundary(checkDitherFromBelow);
+  forEachBoundary(checkDitherFromAbove);
+}
+
+static void test_without_hysteresis_dither_flickers(void){
+  HysteresisQuantizer q(0);
+  uint16_t u0 = 1500;
+  while (gLut.lookup(u0) == gLut.lookup(u0 - 1)) u0++;   // 0 → 1 경계
+  TEST_ASSERT_EQUAL_INT16(1, gLut.lookup(u0));
+  feed(q, u0 - 1);
+  for (int i = 0; i < 10; ++i){
+    TEST_ASSERT_EQUAL_INT16(gLut.lookup(u0), feed(q, u0));
+    TEST_ASSERT_EQUAL_INT16(gLut.lookup(u0 - 1), feed(q, u0 - 1));
+  }
+  TEST_ASSERT_EQUAL_UINT32(20, q.transitions());
+  TEST_ASSERT_EQUAL_UINT32(0, q.suppressed());
+}
+
+static void test_steps_cross_immediately(void){
+  HysteresisQuantizer q(128);   // 최대 (반 구간)
+  TEST_ASSERT_EQUAL_INT16(-100, feed(q, 1000));
+  TEST_ASSERT_EQUAL_INT16(0, feed(q, 1500));
+  TEST_ASSERT_EQUAL_INT16(100, feed(q, 2000));
+  TEST_ASSERT_EQUAL_INT16(gLut.lookup(1250), feed(q, 1250));
+  TEST_ASSERT_EQUAL_UINT32(3, q.transitions());
+  TEST_ASSERT_EQUAL_UINT32(0, q.suppressed());
+
+  // 한 칸(≈5µs) 위로: 반 구간 여유를 넘으므로 받아들임
+  const int16_t cur = q.current();
+  uint16_t u = 1250;
+  while (gLut.lookup(u) == cur) u++;   // 다음 구간 시작
+  TEST_ASSERT_EQUAL_INT16(cur, feed(q, u));   // 경계 바로 위는 억제
+  TEST_ASSERT_EQUAL_INT16(cur + 1, feed(q, (uint16_t)(u + 3)));
+  TEST_ASSERT_EQUAL_UINT32(4, q.transitions());
+  TEST_ASSERT_EQUAL_UINT32(1, q.suppressed());
+
+  // 신호 끊김 뒤 첫 값은 기준 없이 그대로 (전이로 세지 않음)
+  q.reset();
+  TEST_ASSERT_EQUAL_INT16(HysteresisQuantizer::NONE, q.current());
+  TEST_ASSERT_EQUAL_INT16(gLut.lookup(1700), feed(q, 1700));
+  TEST_ASSERT_EQUAL_UINT32(4, q.transitions());
+}
+
+static void test_uncalibrated_passes_through(void){
+  HysteresisQuantizer q(64);
+  // W < 201 (부팅 기본값 2000..1000 포함) 이면 후보 그대로
+  TEST_ASSERT_EQUAL_INT16(3, q.update(1500, 3, 2000, 1000));
+  TEST_ASSERT_EQUAL_INT16(4, q.update(1500, 4, 2000, 1000));
+  TEST_ASSERT_EQUAL_INT16(5, q.update(1500, 5, 1400, 1500));
+  TEST_ASSERT_EQUAL_UINT32(0, q.suppressed());
+  TEST_ASSERT_EQUAL_UINT32(2, q.transitions());
+
+  // 128 에서 포화: 255 를 줘도 반 구간 여유와 같게 동작
+  HysteresisQuantizer a(255), b(128);
+  for (uint16_t u = 1400; u <= 1600; ++u){
+    for (int d = 0; d < 3; ++d){
+      const uint16_t v = (uint16_t)(u + (d & 1 ? 2 : -2));
+      TEST_ASSERT_EQUAL_INT16(feed(b, v), feed(a, v));
+    }
+  }
+  TEST_ASSERT_GREATER_THAN(0, b.suppressed());
+  TEST_ASSERT_EQUAL_UINT32(b.suppressed(), a.suppressed());
+}
+
+int main(int, char**){
+  UNITY_BEGIN();
+  RUN_TEST(test_dither_at_every_boundary_is_stable);
+  RUN_TEST(test_without_hysteresis_dither_flickers);
+  RUN_TEST(test_steps_cross_immediately);
+  RUN_TEST(test_uncalibrated_passes_through);
+  return UNITY_END();
+}
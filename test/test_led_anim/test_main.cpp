@@ -0,0 +1,251 @@
+// ============================================================
+// TimingWheel / LedAnimator 테스트 (가상 시계)
+// ------------------------------------------------------------
+//  - 휠: 무작위 지연(한 바퀴 넘는 것 포함) 타이머가 정확히 만기 틱에 실행,
+//    취소 / 만료된 핸들 무효, 핸들러 안에서 재예약, 풀 고갈
+//  - 애니메이터: "빨강 3번 빠르게, 쉬고, 초록 길게" 전환 시각이 정확하고
+//    100바퀴 반복해도 드리프트 없음, 트랙 덮어쓰기 / once / 밀린 틱 따라잡기,
+//    millis() 32비트 순환을 넘어도 점멸이 같은 간격으로 계속
+// ============================================================
+
+#include <unity.h>
+#include <stdint.h>
+#include "led_anim.h"
+
+static const Rgb RED   = { 255, 0, 0 };
+static const Rgb GREEN = { 0, 255, 0 };
+static const Rgb BLUE  = { 0, 0, 255 };
+static const Rgb OFF   = { 0, 0, 0 };
+
+void setUp(void){}
+void tearDown(void){}
+
+// ------------------ 타이밍 휠 ------------------
+
+typedef TimingWheel<16, 64> Wheel;
+
+static uint32_t gFireTick[64];
+static uint32_t gFired;
+static Wheel* gWheel;
+
+static void onFire(void*, uint32_t id){
+  gFireTick[id] = gWheel->now();
+  gFired++;
+}
+
+static void test_wheel_fires_on_exact_tick(void){
+  static Wheel wheel;
+  gWheel = &wheel;
+  wheel.reset(1000);
+  gFired = 0;
+
+  uint32_t due[64];
+  uint32_t seed = 12345;
+  for (uint32_t id = 0; id < 64; ++id){
+    seed = seed * 1103515245u + 12345u;
+    const uint32_t delay = 1 + (seed >> 16) % 200;   // 슬롯 16 → 최대 12바퀴
+    due[id] = 1000 + delay;
+    gFireTick[id] = 0;
+    TEST_ASSERT_TRUE(wheel.schedule(delay, onFire, nullptr, id) != Wheel::INVALID);
+  }
+  TEST_ASSERT_EQUAL_UINT32(64, wheel.active());
+  // 풀 고갈
+  TEST_ASSERT_TRUE(wheel.schedule(5, onFire, nullptr, 0) == Wheel::INVALID);
+
+  for (uint32_t t = 1001; t <= 1201; ++t) wheel.advance(t);
+  TEST_ASSERT_EQUAL_UINT32(64, gFired);
+  for (uint32_t id = 0; id < 64; ++id) TEST_ASSERT_EQUAL_UINT32(due[id], gFireTick[id]);
+  TEST_ASSERT_EQUAL_UINT32(0, wheel.active());
+}
+
+static void test_wheel_cancel_and_stale_handles(void){
+  static Wheel wheel;
+  gWheel = &wheel;
+  wheel.reset(0);
+  gFired = 0;
+
+  const Wheel::Handle a = wheel.schedule(10, onFire, nullptr, 0);
+  const Wheel::Handle b = wheel.schedule(10, onFire, nullptr, 1);
+  TEST_ASSERT_TRUE(wheel.cancel(a));
+  TEST_ASSERT_FALSE(wheel.cancel(a));                 // 두 번째 취소는 실패
+  wheel.advance(50);                                  // 한 번에 여러 틱
+  TEST_ASSERT_EQUAL_UINT32(1, gFired);
+  TEST_ASSERT_EQUAL_UINT32(10, gFireTick[1]);
+  TEST_ASSERT_FALSE(wheel.cancel(b));                 // 이미 만료
+
+  // 같은 노드가 재사용돼도 옛 핸들로는 못 지운다 (세대)
+  const Wheel::Handle c = wheel.schedule(3, onFire, nullptr, 2);
+  TEST_ASSERT_FALSE(wheel.cancel(b));
+  TEST_ASSERT_FALSE(wheel.cancel(a));
+  TEST_ASSERT_TRUE(wheel.cancel(c));
+  TEST_ASSERT_FALSE(wheel.cancel(Wheel::INVALID));
+}
+
+static uint32_t gChain;
+
+static void onChain(void* ctx, uint32_t left){
+  Wheel* w = static_cast<Wheel*>(ctx);
+  gFireTick[gChain++] = w->now();
+  if (left) w->schedule(16, onChain, w, left - 1);   // 같은 슬롯에 재예약
+}
+
+static void test_wheel_reschedule_from_handler(void){
+  static Wheel wheel;
+  wheel.reset(0);
+  gChain = 0;
+  wheel.schedule(16, onChain, &wheel, 4);
+  wheel.advance(200);
+  TEST_ASSERT_EQUAL_UINT32(5, gChain);
+  for (uint32_t i = 0; i < 5; ++i) TEST_ASSERT_EQUAL_UINT32(16 * (i + 1), gFireTick[i]);
+}
+
+// ------------------ 애니메이터 ------------------
+
+static const uint16_t TICK_MS = 10;
+typedef LedAnimator<2, 16> Animator;
+
+struct Change { uint32_t ms; Rgb c; };
+static Change gChanges[2048];
+static size_t gChangeCount;
+static uint32_t gNowMs;
+
+static void record(Rgb c){
+  if (gChangeCount < 2048) gChanges[gChangeCount++] = Change{ gNowMs, c };
+}
+
+static void runUntil(Animator& a, uint32_t endMs){
+  while (gNowMs < endMs){
+    gNowMs += TICK_MS;
+    a.tick(gNowMs);
+  }
+}
+
+static void test_sequence_builder(void){
+  Animator::Sequence seq;
+  seq.flash(RED, 80, 80, 3).pause(400).hold(GREEN, 600);
+  // 빨강/끔 x3 의 마지막 끔 + 휴지는 한 단계로 합쳐짐
+  TEST_ASSERT_EQUAL_UINT8(7, seq.count);
+  TEST_ASSERT_EQUAL_UINT16(480, seq.steps[5].ms);
+  TEST_ASSERT_FALSE(seq.truncated);
+
+  AnimSequence<2> small;
+  small.hold(RED, 10).hold(GREEN, 10).hold(BLUE, 10);
+  TEST_ASSERT_EQUAL_UINT8(2, small.count);
+  TEST_ASSERT_TRUE(small.truncated);
+}
+
+static void test_transitions_exact_without_drift(void){
+  static Animator anim(TICK_MS, record);
+  gNowMs = 100000;
+  gChangeCount = 0;
+
+  Animator::Sequence seq;
+  seq.flash(RED, 80, 80, 3).pause(400).hold(GREEN, 600);
+  anim.play(0, seq, gNowMs);
+
+  // 한 바퀴 = 3 * 160 + 400 + 600 = 1480ms
+  static const uint32_t AT[] = { 0, 80, 160, 240, 320, 400, 880 };
+  static const Rgb COLOR[] = { RED, OFF, RED, OFF, RED, OFF, GREEN };
+  const uint32_t start = gNowMs;
+  runUntil(anim, start + 100 * 1480);
+
+  TEST_ASSERT_EQUAL_UINT32(100 * 7 + 1, gChangeCount);
+  for (size_t i = 0; i < gChangeCount; ++i){
+    const uint32_t cycle = (uint32_t)(i / 7);
+    TEST_ASSERT_EQUAL_UINT32(start + cycle * 1480 + AT[i % 7], gChanges[i].ms);
+    TEST_ASSERT_TRUE(gChanges[i].c == COLOR[i % 7]);
+  }
+  anim.stop(0);
+  TEST_ASSERT_TRUE(anim.idle());
+  TEST_ASSERT_TRUE(anim.color() == OFF);
+}
+
+static void test_tracks_overlay_and_once(void){
+  static Animator anim(TICK_MS, record);
+  gNowMs = 0;
+  gChangeCount = 0;
+
+  Animator::Sequence base;
+  base.hold(GREEN, 1000);
+  anim.play(0, base, gNowMs);
+  TEST_ASSERT_TRUE(anim.color() == GREEN);
+
+  // 뒤 트랙이 위에 덮인다. once → 끝나면 아래 트랙이 다시 보임
+  Animator::Sequence top;
+  top.flash(BLUE, 50, 50, 2).once();
+  runUntil(anim, 200);
+  anim.play(1, top, gNowMs);
+  TEST_ASSERT_TRUE(anim.color() == BLUE);
+  runUntil(anim, 260);
+  TEST_ASSERT_TRUE(anim.color() == OFF);              // 위 트랙의 끔 단계도 덮는다
+  runUntil(anim, 400);
+  TEST_ASSERT_FALSE(anim.active(1));
+  TEST_ASSERT_TRUE(anim.color() == GREEN);
+  TEST_ASSERT_TRUE(anim.active(0));
+}
+
+static void test_catch_up_after_late_tick(void){
+  static Animator anim(TICK_MS, record);
+  gNowMs = 0;
+  Animator::Sequence seq;
+  seq.hold(RED, 100).hold(GREEN, 100).hold(BLUE, 100);
+  anim.play(0, seq, 0);
+
+  // 250ms 동안 tick 이 없다가 한 번에 → 파랑 단계여야 한다
+  gNowMs = 250;
+  anim.tick(gNowMs);
+  TEST_ASSERT_EQUAL_UINT8(2, anim.step(0));
+  TEST_ASSERT_TRUE(anim.color() == BLUE);
+  gNowMs = 300;
+  anim.tick(gNowMs);
+  TEST_ASSERT_EQUAL_UINT8(0, anim.step(0));             // 반복
+}
+
+// millis() 는 약 49.7일에 0 으로 돌아간다. 순환 1초 전부터 100/100ms 점멸
+static void test_blink_across_millis_wrap(void){
+  static Animator anim(TICK_MS, record);
+  const uint32_t start = 0xFFFFFFFFu - 1000u + 1u;   // 순환 1000ms 전
+  gNowMs = start;
+  gChangeCount = 0;
+
+  Animator::Sequence seq;
+  seq.flash(RED, 100, 100);
+  anim.play(0, seq, gNowMs);
+
+  // 1000ms + 순환 뒤 2000ms, 틱마다 호출 (gNowMs 도 순환)
+  for (uint32_t elapsed = TICK_MS; elapsed <= 3000; elapsed += TICK_MS){
+    gNowMs = start + elapsed;
+    anim.tick(gNowMs);
+  }
+  TEST_ASSERT_EQUAL_UINT32(31, gChangeCount);
+  for (size_t i = 0; i < gChangeCount; ++i){
+    TEST_ASSERT_EQUAL_UINT32(start + (uint32_t)i * 100, gChanges[i].ms);
+    TEST_ASSERT_TRUE(gChanges[i].c == (i & 1 ? OFF : RED));
+  }
+
+  // 휠이 빈 뒤 순환 너머에서 다시 재생해도 첫 전환은 정확히 100ms 뒤
+  anim.stop(0);
+  gChangeCount = 0;
+  gNowMs = 5000;
+  anim.play(0, seq, gNowMs);
+  gNowMs = 5090;
+  anim.tick(gNowMs);
+  TEST_ASSERT_EQUAL_UINT32(1, gChangeCount);
+  gNowMs = 5100;
+  anim.tick(gNowMs);
+  TEST_ASSERT_EQUAL_UINT32(2, gChangeCount);
+  TEST_ASSERT_TRUE(anim.color() == OFF);
+}
+
+int main(int, char**){
+  UNITY_BEGIN();
+  RUN_TEST(test_wheel_fires_on_exact_tick);
+  RUN_TEST(test_wheel_cancel_and_stale_handles);
+  RUN_TEST(test_wheel_reschedule_from_handler);
+  RUN_TEST(test_sequence_builder);
+  RUN_TEST(test_transitions_exact_without_drift);
+  RUN_TEST(test_tracks_overlay_and_once);
+  RUN_TEST(test_catch_up_after_late_tick);
+  RUN_TEST(test_blink_across_millis_wrap);
+  return UNITY_END();
+}
@@ -0,0 +1,129 @@
+// ============================================================
+// LogRing 호스트 스트레스 테스트
+// ------------------------------------------------------------
+// 생산자 스레드 여럿(태스크 / ISR 역할) + 소비자 스레드 1 (로그 송신 태스크 역할).
+//  - 생산자별로 받은 레코드는 순서대로 (버려질 수는 있어도 뒤바뀌거나 중복 없음)
+//  - 내용이 찢어지지 않음 (argc / 인자 / 시각 모두 생산자 + 순번에서 유도)
+//  - 적재 성공 + drops == 제공한 수, 적재 성공 == 받은 수
+//  - 단일 스레드: 가득 차면 새 항목을 버림, 인자 수는 LOG_MAX_ARGS 에서 자름
+// ============================================================
+
+#include <unity.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <atomic>
+#include <thread>
+#include "log_ring.h"
+
+static const uint32_t PRODUCERS = 4;
+static const uint32_t OFFERED_EACH = 500000;
+
+// 레코드 하나의 내용 = (생산자, 순번) 의 함수
+static uint16_t argcFor(uint32_t seq){ return (uint16_t)(1 + seq % LOG_MAX_ARGS); }
+static int32_t argFor(uint32_t producer, uint32_t seq, size_t i){
+  return i == 0 ? (int32_t)seq : (int32_t)((seq * 2654435761u) ^ (producer << 24) ^ (uint32_t)i);
+}
+
+static bool push(LogRing<64>& ring, uint32_t producer, uint32_t seq){
+  int32_t args[LOG_MAX_ARGS];
+  const uint16_t argc = argcFor(seq);
+  for (size_t i = 0; i < argc; ++i) args[i] = argFor(producer, seq, i);
+  return ring.push((uint16_t)producer, seq * 3 + producer, args, argc);
+}
+
+static bool intact(const LogRecord& r){
+  const uint32_t seq = (uint32_t)r.args[0];
+  if (r.id >= PRODUCERS || r.argc != argcFor(seq) || r.tMs != seq * 3 + r.id) return false;
+  for (size_t i = 1; i < r.argc; ++i) if (r.args[i] != argFor(r.id, seq, i)) return false;
+  return true;
+}
+
+void setUp(void){}
+void tearDown(void){}
+
+static void test_single_thread_fifo_and_drops(void){
+  static LogRing<64> ring;
+  for (uint32_t i = 0; i < 70; ++i) push(ring, 1, i);
+  TEST_ASSERT_EQUAL_UINT32(6, ring.drops());
+
+  // 가득 찼을 때는 새 항목을 버린다 → 0..63 이 그대로
+  LogRecord rec;
+  for (uint32_t i = 0; i < 64; ++i){
+    TEST_ASSERT_TRUE(ring.pop(rec));
+    TEST_ASSERT_EQUAL_INT32(i, rec.args[0]);
+    TEST_ASSERT_TRUE(intact(rec));
+  }
+  TEST_ASSERT_FALSE(ring.pop(rec));
+
+  // 비운 뒤에는 다시 들어가고, 인자가 너무 많으면 자른다
+  const int32_t many[LOG_MAX_ARGS + 3] = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+  TEST_ASSERT_TRUE(ring.push(9, 1234, many, LOG_MAX_ARGS + 3));
+  TEST_ASSERT_TRUE(ring.pop(rec));
+  TEST_ASSERT_EQUAL_UINT16(9, rec.id);
+  TEST_ASSERT_EQUAL_UINT32(1234, rec.tMs);
+  TEST_ASSERT_EQUAL_UINT16(LOG_MAX_ARGS, rec.argc);
+  TEST_ASSERT_EQUAL_INT32(LOG_MAX_ARGS, rec.args[LOG_MAX_ARGS - 1]);
+  TEST_ASSERT_EQUAL_UINT32(6, ring.drops());
+}
+
+static void test_many_producers_one_consumer(void){
+  static LogRing<64> ring;
+  std::atomic<uint32_t> running{PRODUCERS};
+  uint32_t pushed[PRODUCERS] = {};
+
+  std::thread producers[PRODUCERS];
+  for (uint32_t p = 0; p < PRODUCERS; ++p){
+    producers[p] = std::thread([&, p]{
+      for (uint32_t i = 0; i < OFFERED_EACH; ++i){
+        if (push(ring, p, i)) pushed[p]++;
+        // 가끔 양보해 소비자가 따라잡는 구간 / 밀리는 구간이 모두 생기게
+        if ((i & 0x3FF) == p) std::this_thread::yield();
+      }
+      running.fetch_sub(1, std::memory_order_release);
+    });
+  }
+
+  uint32_t received[PRODUCERS] = {};
+  uint32_t outOfOrder = 0, torn = 0;
+  std::thread consumer([&]{
+    int64_t last[PRODUCERS];
+    for (uint32_t p = 0; p < PRODUCERS; ++p) last[p] = -1;
+    LogRecord rec;
+    while (true){
+      if (!ring.pop(rec)){
+        if (running.load(std::memory_order_acquire) != 0) continue;
+        if (!ring.pop(rec)) break;   // 생산자가 모두 끝난 뒤에도 비었으면 끝
+      }
+      if (!intact(rec)){
+        torn++;
+        continue;
+      }
+      const int64_t seq = rec.args[0];
+      if (seq <= last[rec.id]) outOfOrder++;
+      last[rec.id] = seq;
+      received[rec.id]++;
+    }
+  });
+
+  for (uint32_t p = 0; p < PRODUCERS; ++p) producers[p].join();
+  consumer.join();
+
+  TEST_ASSERT_EQUAL_UINT32(0, torn);
+  TEST_ASSERT_EQUAL_UINT32(0, outOfOrder);
+  uint32_t totalPushed = 0;
+  for (uint32_t p = 0; p < PRODUCERS; ++p){
+    char msg[64];
+    snprintf(msg, sizeof(msg), "producer %u", (unsigned)p);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(pushed[p], received[p], msg);
+    totalPushed += pushed[p];
+  }
+  TEST_ASSERT_EQUAL_UINT32(PRODUCERS * OFFERED_EACH, totalPushed + ring.drops());
+  TEST_ASSERT_GREATER_THAN(0, ring.drops());          // 밀리는 구간이 실제로 있었다
+}
+
+int main(int, char**){
+  UNITY_BEGIN();
+  RUN_TEST(test_single_thread_fifo_and_drops);
+  RUN_TEST(test_many_producers_one_consumer);
+  return UNITY_END();
+}
@@ -0,0 +1,125 @@
+// ============================================================
+// MovingAverage 동등성 테스트
+// ------------------------------------------------------------
+// 기준 = 교체 전 filterPulse (창 전체를 매번 다시 더하는 버전) 그대로.
+//  - MovingAverage<32> (시프트 경로) 가 200만 무작위 샘플(0 포함)에서 완전히 같다
+//  - 2의 거듭제곱이 아닌 창 (나눗셈 경로)
+//  - setWindow(n < N) 후에는 n칸 재계산 버전과 같다
+// ============================================================
+
+#include <unity.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "pulse_filter.h"
+
+// 교체 전 src/main.cpp 의 filterPulse (창 크기만 매개변수로)
+template <uint8_t AVG_WINDOW>
+struct LegacyFilter {
+  uint16_t pulseBuffer[AVG_WINDOW] = {};
+  uint8_t pulseIndex = 0;
+
+  uint16_t filterPulse(uint16_t newVal){
+    pulseBuffer[pulseIndex++] = newVal;
+    if (pulseIndex >= AVG_WINDOW) pulseIndex = 0;
+
+    uint32_t sum = 0; uint8_t count = 0;
+    for (uint8_t i=0;i<AVG_WINDOW;i++){
+      if (pulseBuffer[i] > 0){ sum += pulseBuffer[i]; count++; }
+    }
+    if (count == 0) return 0;
+    return (uint16_t)(sum / count);
+  }
+};
+
+// xorshift32 (시드 고정 → 재현 가능)
+static uint32_t gRng = 0x1234567u;
+static uint32_t rnd(){
+  gRng ^= gRng << 13; gRng ^= gRng >> 17; gRng ^= gRng << 5;
+  return gRng;
+}
+
+// 0 (빈 칸) 이 약 1/8, 나머지는 RC 범위 / 가끔 16비트 전체
+static uint16_t sample(){
+  const uint32_t r = rnd();
+  if ((r & 7) == 0) return 0;
+  if ((r & 0xF0) == 0) return (uint16_t)(r >> 16);
+  return (uint16_t)(800 + (r >> 16) % 1401);
+}
+
+void setUp(void){ gRng = 0x1234567u; }
+void tearDown(void){}
+
+template <size_t N>
+static void checkAgainstLegacy(uint32_t samples){
+  static LegacyFilter<N> legacy;
+  static MovingAverage<N> avg;
+  legacy = LegacyFilter<N>();
+  avg.reset();
+  for (uint32_t i = 0; i < samples; ++i){
+    const uint16_t v = sample();
+    const uint16_t want = legacy.filterPulse(v);
+    const uint16_t got = avg.push(v);
+    if (want != got){
+      char msg[96];
+      snprintf(msg, sizeof(msg), "N=%u sample %u: legacy %u, MovingAverage %u", (unsigned)N, i, want, got);
+      TEST_FAIL_MESSAGE(msg);
+    }
+  }
+}
+
+static void test_window32_matches_legacy(void){
+  checkAgainstLegacy<32>(2000000);
+}
+
+static void test_shift_path_taken_when_full(void){
+  // 창이 가득 찬 2의 거듭제곱 → sum >> 5. 합이 32의 배수가 아니어도 버림이 같아야 한다
+  MovingAverage<32> avg;
+  for (uint16_t i = 0; i < 32; ++i) avg.push((uint16_t)(1000 + i));
+  TEST_ASSERT_EQUAL_UINT32(32, avg.count());
+  TEST_ASSERT_EQUAL_UINT16((32 * 1000 + 31 * 32 / 2) / 32, avg.value());
+  avg.push(0);   // 빈 칸 하나 → 나눗셈 경로
+  TEST_ASSERT_EQUAL_UINT32(31, avg.count());
+}
+
+static void test_non_pow2_windows_match_legacy(void){
+  checkAgainstLegacy<24>(300000);
+  checkAgainstLegacy<7>(300000);
+  checkAgainstLegacy<1>(10000);
+}
+
+static void test_set_window_matches_shorter_legacy(void){
+  static MovingAverage<32> avg;
+  static LegacyFilter<8> legacy8;
+  static LegacyFilter<13> legacy13;
+
+  avg.reset();
+  for (int i = 0; i < 100; ++i) avg.push(sample());   // 버려져야 할 이전 샘플
+  avg.setWindow(8);
+  TEST_ASSERT_EQUAL_UINT32(8, avg.window());
+  TEST_ASSERT_EQUAL_UINT32(0, avg.count());
+  for (uint32_t i = 0; i < 300000; ++i){
+    const uint16_t v = sample();
+    TEST_ASSERT_EQUAL_UINT16(legacy8.filterPulse(v), avg.push(v));
+  }
+
+  avg.setWindow(13);
+  for (uint32_t i = 0; i < 300000; ++i){
+    const uint16_t v = sample();
+    TEST_ASSERT_EQUAL_UINT16(legacy13.filterPulse(v), avg.push(v));
+  }
+
+  // 범위 밖은 1..N 으로 자름
+  avg.setWindow(0);
+  TEST_ASSERT_EQUAL_UINT32(1, avg.window());
+  avg.setWindow(1000);
+  TEST_ASSERT_EQUAL_UINT32(32, avg.window());
+}
+
+int main(int, char**){
+  UNITY_BEGIN();
+  RUN_TEST(test_window32_matches_legacy);
+  RUN_TEST(test_shift_path_taken_when_full);
+  RUN_TEST(test_non_pow2_windows_match_legacy);
+  RUN_TEST(test_set_window_matches_shorter_legacy);
+  return UNITY_END();
+}
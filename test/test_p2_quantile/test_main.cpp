@@ -0,0 +1,135 @@
+// ============================================================
+// P2Quantile 테스트 (정렬 표본 분위수와 비교)
+// ------------------------------------------------------------
+//  - 균일 / 오름 램프 / 내림 램프 입력 2만 개, p = 0.5%..99.5% 다섯 점:
+//    정렬한 표본의 분위수와 범위(1000µs)의 0.3% 이내
+//  - 워밍업 (5개 미만): 본 샘플의 근사 분위수, ready() / count() / reset()
+//  - 노화 창: 분포가 1000..2000 → 1300..1700 으로 바뀌면 창(2000) 의
+//    5배 뒤 새 분포의 분위수 ± 새 폭의 5% 로 수렴, 극값 마커는 안쪽으로 이동.
+//    창 없음(0) 은 옛 극값이 남는다
+// ============================================================
+
+#include <unity.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <algorithm>
+#include <vector>
+#include "p2_quantile.h"
+
+static uint32_t gRng = 0x9251u;
+static uint32_t rnd(){
+  gRng ^= gRng << 13; gRng ^= gRng >> 17; gRng ^= gRng << 5;
+  return gRng;
+}
+
+// lo + [0, span] 균일 (0.01 단위)
+static float uniform(float lo, float span){
+  return lo + (float)(rnd() % (uint32_t)(span * 100.0f + 1.0f)) / 100.0f;
+}
+
+// 정렬 표본의 p 분위수 (가장 가까운 순위)
+static float exactQuantile(std::vector<float> v, float p){
+  std::sort(v.begin(), v.end());
+  return v[(size_t)(p * (float)(v.size() - 1) + 0.5f)];
+}
+
+static const float PS[] = { 0.005f, 0.05f, 0.5f, 0.95f, 0.995f };
+static const size_t N = 20000;
+
+void setUp(void){ gRng = 0x9251u; }
+void tearDown(void){}
+
+static void expectNear(float want, float got, float tol, const char* what, float p){
+  if (got < want - tol || got > want + tol){
+    char msg[96];
+    snprintf(msg, sizeof(msg), "%s p=%.3f: exact %.2f, P2 %.2f (tol %.1f)", what, p, want, got, tol);
+    TEST_FAIL_MESSAGE(msg);
+  }
+}
+
+template <typename Gen>
+static void checkAgainstExact(const char* what, Gen gen){
+  for (float p : PS){
+    P2Quantile q(p);
+    std::vector<float> v;
+    v.reserve(N);
+    for (size_t i = 0; i < N; ++i){
+      const float x = gen(i);
+      q.add(x);
+      v.push_back(x);
+    }
+    TEST_ASSERT_EQUAL_UINT32(N, q.count());
+    expectNear(exactQuantile(v, p), q.value(), 3.0f, what, p);
+  }
+}
+
+static void test_uniform_matches_sorted_quantile(void){
+  checkAgainstExact("uniform", [](size_t){ return uniform(1000.0f, 1000.0f); });
+}
+
+static void test_ramps_match_sorted_quantile(void){
+  checkAgainstExact("ramp up", [](size_t i){ return 1000.0f + (float)i * 1000.0f / (N - 1); });
+  checkAgainstExact("ramp down", [](size_t i){ return 2000.0f - (float)i * 1000.0f / (N - 1); });
+}
+
+static void test_warmup_and_reset(void){
+  P2Quantile q(0.5f);
+  TEST_ASSERT_FALSE(q.ready());
+  TEST_ASSERT_TRUE(q.value() == 0.0f);
+  const float xs[] = { 1500.0f, 1100.0f, 1900.0f, 1300.0f };
+  for (float x : xs) q.add(x);
+  TEST_ASSERT_FALSE(q.ready());
+  TEST_ASSERT_EQUAL_UINT32(4, q.count());
+  // 정렬 1100 1300 1500 1900 → 가운데 (반올림 순위 2)
+  TEST_ASSERT_TRUE(q.value() == 1500.0f);
+  TEST_ASSERT_TRUE(q.min() == 1100.0f);
+  TEST_ASSERT_TRUE(q.max() == 1900.0f);
+  q.add(1700.0f);
+  TEST_ASSERT_TRUE(q.ready());
+  TEST_ASSERT_TRUE(q.value() == 1500.0f);
+
+  q.reset();
+  TEST_ASSERT_FALSE(q.ready());
+  TEST_ASSERT_EQUAL_UINT32(0, q.count());
+  q.add(1234.0f);
+  TEST_ASSERT_TRUE(q.value() == 1234.0f);
+}
+
+// 옛 분포 5000개 → 새 분포 10000개 (창 2000 의 5배)
+static void test_aging_follows_shifted_distribution(void){
+  P2Quantile lo(0.005f, 2000), hi(0.995f, 2000), mid(0.5f, 2000);
+  P2Quantile loAll(0.005f), hiAll(0.995f);
+  std::vector<float> recent;
+  for (int i = 0; i < 5000; ++i){
+    const float x = uniform(1000.0f, 1000.0f);
+    lo.add(x); hi.add(x); mid.add(x); loAll.add(x); hiAll.add(x);
+  }
+  TEST_ASSERT_LESS_OR_EQUAL(1010, (int)lo.value());
+  TEST_ASSERT_GREATER_OR_EQUAL(1990, (int)hi.value());
+
+  for (int i = 0; i < 10000; ++i){
+    const float x = uniform(1300.0f, 400.0f);
+    lo.add(x); hi.add(x); mid.add(x); loAll.add(x); hiAll.add(x);
+    recent.push_back(x);
+  }
+  // 유효 표본 ≈ 창 2000 → 0.5% 꼬리는 약 10개라 새 폭(400µs)의 5% 까지 흔들린다
+  expectNear(exactQuantile(recent, 0.005f), lo.value(), 20.0f, "aged low", 0.005f);
+  expectNear(exactQuantile(recent, 0.995f), hi.value(), 20.0f, "aged high", 0.995f);
+  expectNear(exactQuantile(recent, 0.5f), mid.value(), 20.0f, "aged median", 0.5f);
+  // 극값 마커는 이웃 쪽으로 (1-s) 씩만 당겨져 더 느리다: 옛 극값보다 100µs 이상 안쪽
+  TEST_ASSERT_GREATER_OR_EQUAL((int)loAll.min() + 100, (int)lo.min());
+  TEST_ASSERT_LESS_OR_EQUAL((int)hiAll.max() - 100, (int)hi.max());
+
+  // 창 없음: 옛 1000..2000 의 꼬리가 남아 새 분포로 못 간다
+  TEST_ASSERT_LESS_OR_EQUAL(1100, (int)loAll.value());
+  TEST_ASSERT_GREATER_OR_EQUAL(1900, (int)hiAll.value());
+}
+
+int main(int, char**){
+  UNITY_BEGIN();
+  RUN_TEST(test_uniform_matches_sorted_quantile);
+  RUN_TEST(test_ramps_match_sorted_quantile);
+  RUN_TEST(test_warmup_and_reset);
+  RUN_TEST(test_aging_follows_shifted_distribution);
+  return UNITY_END();
+}
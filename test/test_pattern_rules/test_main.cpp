@@ -0,0 +1,228 @@
+// ============================================================
+// PatternRuleSet 테스트
+// ------------------------------------------------------------
+//  - 구간 인덱스 조회 == 전체 선형 탐색 (무작위 규칙 수백 개, 우선순위 / 좁은 범위 규칙)
+//  - 들여다본 규칙 수 ≤ 겹치는 규칙 수 + 트리 깊이 (넓은 규칙 하나 + 좁은 규칙 여럿 포함)
+//  - 체류 조건: dwellMs 전에는 안 맞고 recheckMs 로 다시 볼 시각을 알려 줌, 이탈 시 초기화
+//  - 변화율 조건: 빠르게 오를 때만 맞음. EMA 는 경과 시간 가중 → 오래 멈춘 뒤 살짝 밀면
+//    변화율 ≈ 0 (호출이 드문 기기 / 펄스마다인 리플레이 모두), 반올림이라 잔여 없이 0 으로
+//  - 범위가 뒤집힌 규칙은 적재하지 않음
+// ============================================================
+
+#include <unity.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "pattern_rules.h"
+
+static const size_t CAP = 512;
+static PatternRuleSet<CAP> gSet;
+
+static uint32_t gRng = 0x5EEDu;
+static uint32_t rnd(){
+  gRng ^= gRng << 13; gRng ^= gRng >> 17; gRng ^= gRng << 5;
+  return gRng;
+}
+
+void setUp(void){ gRng = 0x5EEDu; }
+void tearDown(void){}
+
+// 조건 없는 값 범위 규칙 (rateMin > rateMax = 변화율 조건 없음)
+static PatternRule rangeRule(int16_t lo, int16_t hi, uint8_t prio){
+  return PatternRule{ lo, hi, 0, 1, 0, (uint8_t)(prio % 7), prio, 0 };
+}
+
+// 중심 구간 트리 깊이 상한: floor(log2 n) + 1, 경로 노드마다 불일치 1개
+static size_t visitBound(size_t overlaps, size_t n){
+  size_t depth = 0;
+  while (n){ depth++; n >>= 1; }
+  return overlaps + depth;
+}
+
+static void test_index_matches_linear_scan(void){
+  static PatternRule rules[400];
+  for (int round = 0; round < 20; ++round){
+    const size_t n = 1 + rnd() % 400;
+    for (size_t i = 0; i < n; ++i){
+      const int16_t lo = (int16_t)(-100 + (int32_t)(rnd() % 201));
+      const int16_t len = (int16_t)((rnd() & 3) ? rnd() % 8 : rnd() % 120);
+      const int16_t hi = (int16_t)(lo + len > 100 ? 100 : lo + len);
+      rules[i] = rangeRule(lo, hi, (uint8_t)(rnd() % 4));
+    }
+    TEST_ASSERT_EQUAL_UINT32(n, gSet.load(rules, n));
+
+    for (int16_t v = -110; v <= 110; ++v){
+      gSet.observe(v, 1000);
+      const PatternRule* got = gSet.match(v, 1000);
+
+      const PatternRule* want = nullptr;
+      size_t overlaps = 0;
+      for (size_t i = 0; i < n; ++i){
+        const PatternRule& r = rules[i];
+        if (v < r.lo || v > r.hi) continue;
+        overlaps++;
+        if (!want || r.priority > want->priority ||
+            (r.priority == want->priority && r.hi - r.lo < want->hi - want->lo)) want = &r;
+      }
+      TEST_ASSERT_LESS_OR_EQUAL(visitBound(overlaps, n), gSet.visited());
+      if (!want){
+        TEST_ASSERT_NULL(got);
+        continue;
+      }
+      TEST_ASSERT_NOT_NULL(got);
+      // 동률(같은 우선순위 / 같은 폭)은 어느 쪽이든 허용
+      TEST_ASSERT_EQUAL_UINT8(want->priority, got->priority);
+      TEST_ASSERT_EQUAL_INT(want->hi - want->lo, got->hi - got->lo);
+      TEST_ASSERT_TRUE(got->lo <= v && v <= got->hi);
+    }
+  }
+}
+
+// 앞쪽의 넓은 규칙 하나가 모든 조회를 전체 탐색으로 만들지 않는다
+static void test_wide_rule_stays_logarithmic(void){
+  static PatternRule rules[CAP];
+  size_t n = 0;
+  rules[n++] = rangeRule(-100, 100, 0);
+  for (int16_t v = -100; v <= 100; ++v) rules[n++] = rangeRule(v, v, 1);
+  for (int16_t v = -100; v <= 98; v += 3) rules[n++] = rangeRule(v, (int16_t)(v + 2), 2);
+  TEST_ASSERT_EQUAL_UINT32(n, gSet.load(rules, n));
+
+  size_t maxVisited = 0;
+  for (int16_t v = -100; v <= 100; ++v){
+    gSet.observe(v, 1000);
+    const PatternRule* got = gSet.match(v, 1000);
+    // 넓은 규칙 + [v,v] + 3칸 규칙 1개 → 3칸 규칙 (우선순위 2)
+    TEST_ASSERT_NOT_NULL(got);
+    TEST_ASSERT_EQUAL_UINT8(2, got->priority);
+    TEST_ASSERT_TRUE(got->lo <= v && v <= got->hi);
+    TEST_ASSERT_LESS_OR_EQUAL(visitBound(3, n), gSet.visited());
+    if (gSet.visited() > maxVisited) maxVisited = gSet.visited();
+  }
+  // 바깥 값: 아무것도 안 맞고 경로만 본다
+  gSet.observe(101, 2000);
+  TEST_ASSERT_NULL(gSet.match(101, 2000));
+  TEST_ASSERT_LESS_OR_EQUAL(visitBound(0, n), gSet.visited());
+
+  char msg[64];
+  snprintf(msg, sizeof(msg), "max visited %u of %u rules", (unsigned)maxVisited, (unsigned)n);
+  TEST_ASSERT_TRUE_MESSAGE(maxVisited < n / 10, msg);
+}
+
+static void test_dwell_condition(void){
+  const PatternRule rules[] = {
+    { 99, 99, 500, 1, 0, 2, 1, 0 },   // 99 에서 500ms 유지
+    { 90, 100, 0, 1, 0, 4, 0, 0 },    // 넓은 기본 규칙
+  };
+  gSet.load(rules, 2);
+
+  gSet.observe(99, 0);
+  const PatternRule* r = gSet.match(99, 0);
+  TEST_ASSERT_NOT_NULL(r);
+  TEST_ASSERT_EQUAL_UINT16(0, r->dwellMs);            // 아직은 넓은 규칙
+  TEST_ASSERT_EQUAL_UINT32(500, gSet.recheckMs());
+
+  gSet.observe(99, 499);
+  r = gSet.match(99, 499);
+  TEST_ASSERT_EQUAL_UINT16(0, r->dwellMs);
+  TEST_ASSERT_EQUAL_UINT32(1, gSet.recheckMs());
+
+  gSet.observe(99, 500);
+  r = gSet.match(99, 500);
+  TEST_ASSERT_EQUAL_UINT16(500, r->dwellMs);
+
+  // 범위를 벗어났다 돌아오면 체류 시간은 처음부터
+  gSet.observe(98, 600);
+  gSet.match(98, 600);
+  gSet.observe(99, 700);
+  r = gSet.match(99, 700);
+  TEST_ASSERT_EQUAL_UINT16(0, r->dwellMs);
+  TEST_ASSERT_EQUAL_UINT32(500, gSet.recheckMs());
+}
+
+static void test_rate_condition(void){
+  const PatternRule rules[] = {
+    { 20, 80, 0, 50, 1000, 1, 0, 0 },   // 20~80 을 50~1000 %/s 로 오르는 중
+  };
+  gSet.load(rules, 1);
+
+  // 정지: 안 맞음
+  for (uint32_t t = 0; t <= 200; t += 20){
+    gSet.observe(30, t);
+    TEST_ASSERT_NULL(gSet.match(30, t));
+  }
+  TEST_ASSERT_EQUAL_UINT32(PatternRuleSet<CAP>::RATE_RECHECK_MS, gSet.recheckMs());
+
+  // 20ms 마다 +2 = 100 %/s → EMA 가 따라오면 맞음
+  const PatternRule* r = nullptr;
+  int16_t v = 30;
+  for (uint32_t t = 220; t <= 600; t += 20){
+    v += 2;
+    gSet.observe(v, t);
+    r = gSet.match(v, t);
+  }
+  TEST_ASSERT_NOT_NULL(r);
+  TEST_ASSERT_GREATER_OR_EQUAL(50, gSet.rate());
+}
+
+// 기기에서는 값이 바뀔 때만 observe → 빠른 이동 뒤 오래 멈췄다 살짝 움직여도 옛 변화율이 남으면 안 된다
+static void test_rate_after_hold_is_still(void){
+  const PatternRule rules[] = {
+    { 55, 60, 0, 200, 1000, 1, 0, 0 },
+  };
+  gSet.load(rules, 1);
+
+  // 0 → 50 을 100ms 에 (500 %/s)
+  for (int16_t v = 0; v <= 50; v += 10) gSet.observe(v, (uint32_t)v * 2);
+  TEST_ASSERT_GREATER_OR_EQUAL(200, gSet.rate());
+
+  // 10초 정지 (호출 없음) 뒤 5 만큼 밀기 → 0.5 %/s. 옛 값은 τ/(dt+τ) ≈ 0.6% 만 남는다
+  gSet.observe(55, 100 + 10000);
+  TEST_ASSERT_LESS_OR_EQUAL(5, gSet.rate());
+  TEST_ASSERT_NULL(gSet.match(55, 100 + 10000));
+
+  // 같은 입력을 20ms 마다 넣는 리플레이도 같은 결론
+  gSet.load(rules, 1);
+  uint32_t t = 0;
+  for (int16_t v = 0; v <= 50; v += 10, t += 20) gSet.observe(v, t);
+  for (; t < 10100; t += 20) gSet.observe(50, t);
+  TEST_ASSERT_EQUAL_INT32(0, gSet.rate());   // 반올림 → 잔여 없이 0
+  gSet.observe(55, t);
+  TEST_ASSERT_NULL(gSet.match(55, t));
+
+  // 음의 방향도 잔여 없이 0 으로
+  for (int16_t v = 50; v >= 0; v -= 10, t += 20) gSet.observe(v, t);
+  TEST_ASSERT_TRUE(gSet.rate() < -200);
+  for (uint32_t end = t + 2000; t < end; t += 20) gSet.observe(0, t);
+  TEST_ASSERT_EQUAL_INT32(0, gSet.rate());
+
+  // 호출 간격이 달라도 같은 등속 이동은 같은 변화율로 수렴 (300 %/s)
+  static const uint32_t STEPS[] = { 10, 20, 100 };
+  for (uint32_t step : STEPS){
+    gSet.load(rules, 1);
+    for (uint32_t u = 0; u <= 600; u += step) gSet.observe((int16_t)(-100 + (int32_t)u * 3 / 10), u);
+    char msg[48];
+    snprintf(msg, sizeof(msg), "step %ums: rate %d", (unsigned)step, (int)gSet.rate());
+    TEST_ASSERT_TRUE_MESSAGE(gSet.rate() >= 297 && gSet.rate() <= 303, msg);
+  }
+}
+
+static void test_inverted_rules_dropped(void){
+  const PatternRule rules[] = {
+    rangeRule(10, 5, 0),
+    rangeRule(-5, 5, 0),
+  };
+  TEST_ASSERT_EQUAL_UINT32(1, gSet.load(rules, 2));
+  TEST_ASSERT_EQUAL_INT16(-5, gSet.at(0).lo);
+  gSet.observe(7, 0);
+  TEST_ASSERT_NULL(gSet.match(7, 0));
+}
+
+int main(int, char**){
+  UNITY_BEGIN();
+  RUN_TEST(test_index_matches_linear_scan);
+  RUN_TEST(test_wide_rule_stays_logarithmic);
+  RUN_TEST(test_dwell_condition);
+  RUN_TEST(test_rate_condition);
+  RUN_TEST(test_rate_after_hold_is_still);
+  RUN_TEST(test_inverted_rules_dropped);
+  return UNITY_END();
+}
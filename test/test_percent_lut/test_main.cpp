@@ -0,0 +1,169 @@
+// ============================================================
+// PercentLut 테스트
+// ------------------------------------------------------------
+//  - 무작위 보정값 (calMin < RC_MIN_US, W < 201, 뒤집힌 값 포함) 에서
+//    rebuild() 결과가 floor((u - min) * 201 / W) - 100 (바깥은 ±100 포화) 과 같다
+//  - 보정 구간이 표 안에 있으면 201 구간 폭이 모두 floor/ceil(W/201) (차이 ≤ 1µs)
+//  - step(256) 재구성: 백 버퍼가 다 찰 때까지 앞 표 / calMin / calMax 그대로,
+//    다 찬 step 에서만 교체. 재구성 중 바뀐 목표는 교체 후 이어서 반영
+//  - calibrated(): 전부 0 인 표(W < 201, 부팅 기본값 2000..1000)는 보정 아님
+// ============================================================
+
+#include <unity.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "percent_lut.h"
+
+static const uint16_t LO = 800;     // RC_MIN_US
+static const uint16_t HI = 2200;    // RC_MAX_US
+typedef PercentLut<LO, HI> Lut;
+
+static uint32_t gRng = 0xBADC0DEu;
+static uint32_t rnd(){
+  gRng ^= gRng << 13; gRng ^= gRng >> 17; gRng ^= gRng << 5;
+  return gRng;
+}
+
+void setUp(void){ gRng = 0xBADC0DEu; }
+void tearDown(void){}
+
+static int8_t expected(uint16_t u, uint16_t calMin, uint16_t calMax){
+  const int32_t w = calMax >= calMin ? (int32_t)calMax - calMin + 1 : 0;
+  if (w < Lut::BINS) return 0;
+  if (u < calMin) return -100;
+  if (u > calMax) return 100;
+  return (int8_t)(((int32_t)(u - calMin) * Lut::BINS) / w - 100);
+}
+
+static void checkTable(const Lut& lut, uint16_t calMin, uint16_t calMax){
+  for (uint32_t u = LO; u <= HI; ++u){
+    const int8_t want = expected((uint16_t)u, calMin, calMax);
+    const int8_t got = lut.lookup((uint16_t)u);
+    if (want != got){
+      char msg[96];
+      snprintf(msg, sizeof(msg), "cal %u..%u, u=%u: want %d, got %d",
+               calMin, calMax, (unsigned)u, want, got);
+      TEST_FAIL_MESSAGE(msg);
+    }
+  }
+}
+
+static void test_rebuild_matches_rational_formula(void){
+  static Lut lut;
+  // 고정 경계 사례 + 무작위
+  static const uint16_t FIXED[][2] = {
+    { 1000, 2000 }, { 800, 2200 }, { 600, 2400 }, { 700, 1000 }, { 2100, 2600 },
+    { 1000, 1200 }, { 1000, 1199 }, { 1500, 1500 }, { 2000, 1000 }, { 1, 65535 },
+  };
+  for (size_t i = 0; i < sizeof(FIXED) / sizeof(FIXED[0]); ++i){
+    lut.rebuild(FIXED[i][0], FIXED[i][1]);
+    TEST_ASSERT_EQUAL_UINT16(FIXED[i][0], lut.calMin());
+    TEST_ASSERT_EQUAL_UINT16(FIXED[i][1], lut.calMax());
+    checkTable(lut, FIXED[i][0], FIXED[i][1]);
+  }
+  for (int k = 0; k < 3000; ++k){
+    const uint16_t calMin = (uint16_t)(500 + rnd() % 1200);       // RC_MIN_US 아래 포함
+    const uint16_t w = (uint16_t)(1 + rnd() % 1800);              // W < 201 포함
+    const uint16_t calMax = (uint16_t)(calMin + w - 1);
+    lut.rebuild(calMin, calMax);
+    checkTable(lut, calMin, calMax);
+  }
+}
+
+static void test_bin_widths_differ_by_at_most_1us(void){
+  static Lut lut;
+  for (int k = 0; k < 2000; ++k){
+    const uint16_t w = (uint16_t)(Lut::BINS + rnd() % (HI - LO + 1 - Lut::BINS + 1));
+    const uint16_t calMin = (uint16_t)(LO + rnd() % (HI - LO + 2 - w));
+    const uint16_t calMax = (uint16_t)(calMin + w - 1);
+    lut.rebuild(calMin, calMax);
+
+    uint16_t width[Lut::BINS] = {};
+    for (uint32_t u = calMin; u <= calMax; ++u) width[lut.lookup((uint16_t)u) + 100]++;
+
+    uint16_t lo = 0xFFFF, hi = 0;
+    for (int32_t b = 0; b < Lut::BINS; ++b){
+      if (width[b] < lo) lo = width[b];
+      if (width[b] > hi) hi = width[b];
+    }
+    TEST_ASSERT_EQUAL_UINT16(w / Lut::BINS, lo);                    // 빈 구간 없음
+    TEST_ASSERT_LESS_OR_EQUAL(1, hi - lo);
+    // 양 끝 바로 바깥은 포화
+    if (calMin > LO) TEST_ASSERT_EQUAL_INT8(-100, lut.lookup((uint16_t)(calMin - 1)));
+    if (calMax < HI) TEST_ASSERT_EQUAL_INT8(100, lut.lookup((uint16_t)(calMax + 1)));
+    TEST_ASSERT_EQUAL_INT8(-100, lut.lookup(calMin));
+    TEST_ASSERT_EQUAL_INT8(100, lut.lookup(calMax));
+  }
+}
+
+static void test_front_swaps_only_after_back_is_full(void){
+  static Lut lut;
+  TEST_ASSERT_FALSE(lut.ready());
+  lut.rebuild(1000, 2000);
+  TEST_ASSERT_TRUE(lut.ready());
+  TEST_ASSERT_FALSE(lut.building());
+
+  // 1050µs: 이전 보정에선 -90, 새 보정에선 -100
+  TEST_ASSERT_EQUAL_INT8(-90, lut.lookup(1050));
+  lut.retarget(1100, 1900);
+  TEST_ASSERT_TRUE(lut.building());
+
+  const size_t steps = (Lut::SIZE + 255) / 256;
+  for (size_t i = 1; i < steps; ++i){
+    TEST_ASSERT_FALSE(lut.step(256));
+    TEST_ASSERT_EQUAL_INT8(-90, lut.lookup(1050));
+    TEST_ASSERT_EQUAL_UINT16(1000, lut.calMin());
+    TEST_ASSERT_EQUAL_UINT16(2000, lut.calMax());
+    checkTable(lut, 1000, 2000);
+  }
+
+  // 재구성 도중 목표가 또 바뀜 → 이번 재구성은 끝까지 마친 뒤 다음 재구성 시작
+  lut.retarget(1200, 1800);
+  TEST_ASSERT_TRUE(lut.step(256));
+  TEST_ASSERT_EQUAL_UINT16(1100, lut.calMin());
+  TEST_ASSERT_EQUAL_UINT16(1900, lut.calMax());
+  checkTable(lut, 1100, 1900);
+  TEST_ASSERT_TRUE(lut.building());
+
+  size_t n = 0;
+  while (!lut.step(256)){
+    checkTable(lut, 1100, 1900);
+    n++;
+  }
+  TEST_ASSERT_EQUAL_UINT32(steps - 1, n);
+  checkTable(lut, 1200, 1800);
+  TEST_ASSERT_FALSE(lut.building());
+  TEST_ASSERT_FALSE(lut.step(256));
+
+  // 같은 값으로 retarget → 재구성 없음
+  lut.retarget(1200, 1800);
+  TEST_ASSERT_FALSE(lut.building());
+}
+
+static void test_calibrated_excludes_zero_table(void){
+  static Lut lut;
+  TEST_ASSERT_FALSE(lut.calibrated());
+  lut.rebuild(2000, 1000);             // setup() 의 "보정값 없음"
+  TEST_ASSERT_TRUE(lut.ready());
+  TEST_ASSERT_FALSE(lut.calibrated());
+  lut.rebuild(1000, 1199);             // W = 200
+  TEST_ASSERT_FALSE(lut.calibrated());
+  lut.rebuild(1000, 1200);             // W = 201
+  TEST_ASSERT_TRUE(lut.calibrated());
+
+  // 재구성 중에는 교체 전까지 이전 판정 유지
+  lut.retarget(2000, 1000);
+  TEST_ASSERT_FALSE(lut.step(256));
+  TEST_ASSERT_TRUE(lut.calibrated());
+  while (!lut.step(256)) {}
+  TEST_ASSERT_FALSE(lut.calibrated());
+}
+
+int main(int, char**){
+  UNITY_BEGIN();
+  RUN_TEST(test_rebuild_matches_rational_formula);
+  RUN_TEST(test_bin_widths_differ_by_at_most_1us);
+  RUN_TEST(test_front_swaps_only_after_back_is_full);
+  RUN_TEST(test_calibrated_excludes_zero_table);
+  return UNITY_END();
+}
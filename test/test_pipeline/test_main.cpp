@@ -0,0 +1,233 @@
+// ============================================================
+// 전체 파이프라인 테스트 (env:native, test_build_src = yes)
+// ------------------------------------------------------------
+// src/ 의 setup() 그대로 + 가상 시계. RcSignalGen 에지를 halPinDrive(D1) 로
+// 넣으면 ISR → 링 → taskRcInput → 필터/보정 → taskLed → 애니메이터 → LED.
+// 프레임마다 halSettle 로 모든 태스크가 다시 대기할 때까지 기다리므로
+// 실시간 sleep 없이 결정적. 테스트마다 필요한 상태를 직접 만든다 (순서 무관):
+//  - reset-cal 뒤 보정 없음 (dump: min=2000 max=1000)
+//  - 1000↔2000 스윕 (양 끝에서 잠깐 멈춤) → 보정 1000..2000 ±5,
+//    throttlePercentFromUs 1000 / 1500 / 2000 → -100 / 0 / +100
+//  - 2000 유지 → 빨강 점멸, 1500 유지 → 주황 점멸 (점멸 색 / 끔 외의 색 없음)
+//  - 신호 끊김 → 타임아웃 뒤 계속 꺼짐, 신호가 돌아오면 다시 주황
+// ============================================================
+
+#include <unity.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "hal.h"
+#include "led_pwm.h"
+#include "rc_signal_gen.h"
+
+static const Rgb RED    = { 255,  0, 0 };
+static const Rgb ORANGE = { 255, 80, 0 };
+static const Rgb OFF    = {   0,  0, 0 };
+
+static const uint32_t FRAME_US = 20000;   // 50Hz
+
+static RcSignalConfig signalConfig(){
+  RcSignalConfig cfg;
+  cfg.frameHz = 50;
+  cfg.jitterUniformUs = 2.0f;
+  return cfg;
+}
+
+static RcSignalGen gGen(signalConfig(), 17);
+static uint64_t gStartUs;                 // 발생기 시각 0 에 해당하는 가상 시각
+static bool gCalibrated = false;          // 스윕을 한 번 돌렸다
+
+int16_t throttlePercentFromUs(uint16_t us);   // src/main.cpp
+
+struct ColorTally {
+  uint32_t samples = 0, on = 0, off = 0, other = 0;
+  Rgb lastOther = { 0, 0, 0 };
+
+  void add(Rgb c, Rgb want){
+    samples++;
+    if (c == OFF) off++;
+    else if (c == want) on++;
+    else { other++; lastOther = c; }
+  }
+};
+
+// 주입한 에지가 파이프라인 끝(LED)까지 다 돌았다
+static void settle(){
+  TEST_ASSERT_TRUE_MESSAGE(halSettle(), "tasks did not go idle");
+}
+
+static void advanceTo(uint64_t us){
+  const uint64_t now = halClockNowUs();
+  if (us > now) halClockAdvanceUs(us - now);
+}
+
+// frames 프레임 동안 widthUs 펄스. tally 가 있으면 마지막 measureFrames 프레임의 LED 색을 센다
+static void runFrames(float widthUs, uint32_t frames, ColorTally* tally = nullptr,
+                      Rgb want = OFF, uint32_t measureFrames = 0){
+  RcEdge edges[RcSignalGen::MAX_EDGES];
+  gGen.setWidthUs(widthUs);
+  for (uint32_t f = 0; f < frames; ++f){
+    const size_t n = gGen.nextFrame(edges);
+    for (size_t i = 0; i < n; ++i){
+      advanceTo(gStartUs + edges[i].tNs / 1000);
+      halPinDrive(D1, edges[i].level ? HIGH : LOW);
+    }
+    settle();
+    if (tally && f + measureFrames >= frames) tally->add(ledCurrentRgb(), want);
+  }
+}
+
+// 발생기는 처음부터 다시 (시각 0 = 다음 프레임). 신호 없이 시계만 간 뒤에
+static void restartSignal(){
+  gGen.reseed(18);
+  gStartUs = halClockNowUs() + FRAME_US;
+}
+
+// 에지 없이 시계만 진행 (신호 끊김)
+static void runSilence(uint32_t frames, ColorTally* tally = nullptr, uint32_t measureFrames = 0){
+  for (uint32_t f = 0; f < frames; ++f){
+    halClockAdvanceUs(FRAME_US);
+    settle();
+    if (tally && f + measureFrames >= frames) tally->add(ledCurrentRgb(), OFF);   // 켜지면 전부 other
+  }
+  restartSignal();
+}
+
+// ------------------ 셸 (dump 로 보정값 확인) ------------------
+
+static std::mutex gTapLock;
+static std::vector<std::string> gReplies;   // 셸 응답 (로그 줄 "[" 제외)
+
+// 한 줄 보내고 응답 하나를 기다린다 (가상 시계 20ms 씩 = taskLogDrain 유휴 주기)
+static std::string command(const char* line){
+  size_t before;
+  {
+    std::lock_guard<std::mutex> g(gTapLock);
+    before = gReplies.size();
+  }
+  halSerialInject(line, strlen(line));
+  halSerialInject("\n", 1);
+  for (int i = 0; i < 10; ++i){
+    halClockAdvanceUs(FRAME_US);
+    settle();
+    std::lock_guard<std::mutex> g(gTapLock);
+    if (gReplies.size() > before) return gReplies[before];
+  }
+  TEST_FAIL_MESSAGE(line);
+  return std::string();
+}
+
+// dump 의 "cal: min=.. max=.." 줄
+static void readCal(unsigned& minUs, unsigned& maxUs){
+  const std::string dump = command("dump");
+  const char* cal = strstr(dump.c_str(), "cal: ");
+  TEST_ASSERT_NOT_NULL(cal);
+  TEST_ASSERT_EQUAL_INT(2, sscanf(cal, "cal: min=%u max=%u", &minUs, &maxUs));
+  restartSignal();
+}
+
+// 보정은 0.5 / 99.5% 분위수 → 양 끝에서 잠깐씩 머물러야 경계가 1000 / 2000 에 붙는다
+static void sweep(){
+  for (int round = 0; round < 2; ++round){
+    runFrames(1000.0f, 50);
+    for (int us = 1000; us <= 2000; us += 10) runFrames((float)us, 1);
+    runFrames(2000.0f, 50);
+    for (int us = 2000; us >= 1000; us -= 10) runFrames((float)us, 1);
+  }
+  gCalibrated = true;
+}
+
+static void ensureCalibrated(){
+  if (!gCalibrated) sweep();
+}
+
+static void expectBlink(const ColorTally& t, const char* name){
+  char msg[128];
+  snprintf(msg, sizeof(msg), "%s: samples=%u on=%u off=%u other=%u (last %u,%u,%u)", name,
+           (unsigned)t.samples, (unsigned)t.on, (unsigned)t.off, (unsigned)t.other,
+           t.lastOther.r, t.lastOther.g, t.lastOther.b);
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, t.other, msg);
+  // 200ms 점멸을 2초 동안 → 켜짐/꺼짐 둘 다 보여야 한다
+  TEST_ASSERT_GREATER_THAN_UINT32_MESSAGE(t.samples / 4, t.on, msg);
+  TEST_ASSERT_GREATER_THAN_UINT32_MESSAGE(t.samples / 4, t.off, msg);
+}
+
+void setUp(void){}
+void tearDown(void){}
+
+static void test_sweep_calibrates(void){
+  unsigned minUs = 0, maxUs = 0;
+  // 이전 테스트가 무엇을 했든 보정 없음에서 시작 (신호 없이 → 다음 펄스까지 2000..1000)
+  runSilence(20);
+  TEST_ASSERT_TRUE(command("reset-cal").find("ok") == 0);
+  runSilence(20);
+  readCal(minUs, maxUs);
+  TEST_ASSERT_EQUAL_UINT32(2000, minUs);
+  TEST_ASSERT_EQUAL_UINT32(1000, maxUs);
+
+  sweep();
+  readCal(minUs, maxUs);
+  char msg[64];
+  snprintf(msg, sizeof(msg), "calibrated %u..%u", minUs, maxUs);
+  TEST_ASSERT_TRUE_MESSAGE(minUs >= 995 && minUs <= 1005, msg);
+  TEST_ASSERT_TRUE_MESSAGE(maxUs >= 1995 && maxUs <= 2005, msg);
+  TEST_ASSERT_EQUAL_INT16(-100, throttlePercentFromUs(1000));
+  TEST_ASSERT_EQUAL_INT16(100, throttlePercentFromUs(2000));
+  const int16_t mid = throttlePercentFromUs(1500);
+  TEST_ASSERT_TRUE_MESSAGE(mid >= -1 && mid <= 1, msg);
+}
+
+static void test_hold_2000_blinks_red(void){
+  ensureCalibrated();
+  ColorTally t;
+  runFrames(2000.0f, 150, &t, RED, 100);
+  expectBlink(t, "hold 2000");
+}
+
+static void test_hold_1500_blinks_orange(void){
+  ensureCalibrated();
+  ColorTally t;
+  runFrames(1500.0f, 150, &t, ORANGE, 100);
+  expectBlink(t, "hold 1500");
+}
+
+static void test_signal_loss_turns_off(void){
+  ensureCalibrated();
+  runFrames(1500.0f, 20);
+  ColorTally t;
+  // RC_TIMEOUT_MS (300ms) 뒤부터 1초 동안 계속 꺼짐
+  runSilence(80, &t, 50);
+  TEST_ASSERT_EQUAL_UINT32(50, t.samples);
+  TEST_ASSERT_EQUAL_UINT32(50, t.off);
+
+  // 신호가 돌아오면 다시 주황
+  ColorTally back;
+  runFrames(1500.0f, 150, &back, ORANGE, 100);
+  expectBlink(back, "recovered 1500");
+}
+
+int main(int, char**){
+#ifdef KV_STORE_DIR
+  // 이전 실행의 보정값 / 규칙이 시나리오를 바꾸지 않도록
+  remove(KV_STORE_DIR "/kv_cal.bin");
+  remove(KV_STORE_DIR "/kv_rules.bin");
+#endif
+  halSerialTap([](const uint8_t* p, size_t n){
+    if (!n || p[0] == '[') return;   // 로그 줄
+    std::lock_guard<std::mutex> g(gTapLock);
+    gReplies.emplace_back(reinterpret_cast<const char*>(p), n);
+  });
+  halClockManual(true);
+  setup();
+  gStartUs = halClockNowUs() + FRAME_US;
+
+  UNITY_BEGIN();
+  RUN_TEST(test_sweep_calibrates);
+  RUN_TEST(test_hold_2000_blinks_red);
+  RUN_TEST(test_hold_1500_blinks_orange);
+  RUN_TEST(test_signal_loss_turns_off);
+  return UNITY_END();
+}
@@ -0,0 +1,137 @@
+// ============================================================
+// PulseHistogram 테스트 (최근 Window 개를 그대로 들고 있는 기준과 비교)
+// ------------------------------------------------------------
+//  - 창 1 / 7 / 64, 좁은 군집(동률 잦음) + 넓은 무작위 + 범위 밖 입력
+//  - 펄스마다: size / count / modeCount / mode 가 최대 빈도 칸 /
+//    직전 최빈값이 여전히 최대 빈도면 그대로 (동률 유지)
+//  - 분위수: 창을 정렬한 기준의 ceil(permille * n / 1000) 번째 값
+//  - A A B B 반복 (창 안에서 계속 동률) 에서 최빈값이 번갈아 바뀌지 않음
+// ============================================================
+
+#include <unity.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <algorithm>
+#include <deque>
+#include <vector>
+#include "pulse_histogram.h"
+
+static const uint16_t LO = 800;
+static const uint16_t HI = 2200;
+
+static uint32_t gRng = 0x4157u;
+static uint32_t rnd(){
+  gRng ^= gRng << 13; gRng ^= gRng >> 17; gRng ^= gRng << 5;
+  return gRng;
+}
+
+void setUp(void){ gRng = 0x4157u; }
+void tearDown(void){}
+
+static uint16_t sample(){
+  const uint32_t r = rnd();
+  if ((r & 63) == 0) return (uint16_t)((r >> 8) & 1 ? 700 : 2300);   // 범위 밖
+  if ((r & 3) != 0) return (uint16_t)(1500 + (r >> 8) % 5);           // 좁은 군집
+  return (uint16_t)(LO + (r >> 8) % (HI - LO + 1));
+}
+
+static uint16_t refQuantile(const std::deque<uint16_t>& win, uint16_t permille){
+  std::vector<uint16_t> s(win.begin(), win.end());
+  std::sort(s.begin(), s.end());
+  size_t rank = ((size_t)permille * s.size() + 999) / 1000;
+  if (!rank) rank = 1;
+  return s[rank - 1];
+}
+
+template <size_t W>
+static void checkAgainstBruteForce(uint32_t pushes){
+  static PulseHistogram<LO, HI, W> hist;
+  hist.reset();
+  std::deque<uint16_t> win;
+  static uint16_t counts[HI + 1];
+  for (size_t i = 0; i <= HI; ++i) counts[i] = 0;
+
+  TEST_ASSERT_EQUAL_UINT16(0, hist.mode());
+  TEST_ASSERT_EQUAL_UINT16(0, hist.quantile(500));
+
+  uint16_t prevMode = 0;
+  char msg[128];
+  for (uint32_t i = 0; i < pushes; ++i){
+    const uint16_t us = sample();
+    const uint16_t got = hist.push(us);
+    if (us >= LO && us <= HI){
+      if (win.size() == W){
+        counts[win.front()]--;
+        win.pop_front();
+      }
+      win.push_back(us);
+      counts[us]++;
+    }
+
+    uint16_t maxCount = 0;
+    for (uint16_t v : win) if (counts[v] > maxCount) maxCount = counts[v];
+
+    snprintf(msg, sizeof(msg), "W=%u push %u (%u): mode %u x%u, max %u, prev %u x%u", (unsigned)W,
+             (unsigned)i, us, got, hist.count(got), maxCount, prevMode, prevMode ? counts[prevMode] : 0);
+    TEST_ASSERT_EQUAL_UINT16_MESSAGE(hist.mode(), got, msg);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(win.size(), hist.size(), msg);
+    TEST_ASSERT_EQUAL_UINT16_MESSAGE(maxCount, hist.modeCount(), msg);
+    TEST_ASSERT_EQUAL_UINT16_MESSAGE(maxCount, counts[got], msg);
+    if (prevMode && counts[prevMode] == maxCount) TEST_ASSERT_EQUAL_UINT16_MESSAGE(prevMode, got, msg);
+    prevMode = got;
+
+    // 칸 빈도 / 분위수는 가끔만 (기준 정렬이 느리다)
+    if ((i & 127) == 0){
+      for (int k = 0; k < 8; ++k){
+        const uint16_t v = (uint16_t)(LO + rnd() % (HI - LO + 1));
+        TEST_ASSERT_EQUAL_UINT16(counts[v], hist.count(v));
+      }
+      TEST_ASSERT_EQUAL_UINT16(counts[1500], hist.count(1500));
+      static const uint16_t PERMILLE[] = { 0, 1, 5, 100, 250, 500, 750, 900, 995, 999, 1000, 1200 };
+      for (uint16_t p : PERMILLE){
+        const uint16_t want = refQuantile(win, p > 1000 ? 1000 : p);
+        TEST_ASSERT_EQUAL_UINT16_MESSAGE(want, hist.quantile(p), msg);
+      }
+      const uint16_t p = (uint16_t)(rnd() % 1001);
+      TEST_ASSERT_EQUAL_UINT16_MESSAGE(refQuantile(win, p), hist.quantile(p), msg);
+    }
+  }
+}
+
+static void test_window1_matches_brute_force(void){ checkAgainstBruteForce<1>(50000); }
+static void test_window7_matches_brute_force(void){ checkAgainstBruteForce<7>(200000); }
+static void test_window64_matches_brute_force(void){ checkAgainstBruteForce<64>(200000); }
+
+static void test_tied_mode_does_not_alternate(void){
+  static PulseHistogram<LO, HI, 8> hist;
+  hist.reset();
+  // 창 8 = A A B B A A B B → 계속 4:4 동률. 처음 최빈값(A)이 끝까지 유지돼야 한다
+  static const uint16_t A = 1500, B = 1510;
+  static const uint16_t PATTERN[4] = { A, A, B, B };
+  for (int i = 0; i < 8; ++i) hist.push(PATTERN[i & 3]);
+  TEST_ASSERT_EQUAL_UINT16(A, hist.mode());
+  for (int i = 8; i < 1000; ++i){
+    TEST_ASSERT_EQUAL_UINT16(A, hist.push(PATTERN[i & 3]));
+    TEST_ASSERT_EQUAL_UINT16(4, hist.modeCount());
+  }
+
+  // 범위 밖은 창에 안 들어감
+  const uint16_t before = hist.count(A);
+  TEST_ASSERT_EQUAL_UINT16(A, hist.push(100));
+  TEST_ASSERT_EQUAL_UINT16(before, hist.count(A));
+  TEST_ASSERT_EQUAL_UINT32(8, hist.size());
+
+  hist.reset();
+  TEST_ASSERT_EQUAL_UINT32(0, hist.size());
+  TEST_ASSERT_EQUAL_UINT16(0, hist.mode());
+  TEST_ASSERT_EQUAL_UINT16(0, hist.count(A));
+}
+
+int main(int, char**){
+  UNITY_BEGIN();
+  RUN_TEST(test_window1_matches_brute_force);
+  RUN_TEST(test_window7_matches_brute_force);
+  RUN_TEST(test_window64_matches_brute_force);
+  RUN_TEST(test_tied_mode_does_not_alternate);
+  return UNITY_END();
+}
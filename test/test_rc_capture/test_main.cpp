@@ -0,0 +1,180 @@
+// ============================================================
+// RcEdgeDecoder 호스트 테스트 (합성 에지 스트림)
+// ------------------------------------------------------------
+//  - 정상 위상: 모든 펄스 폭이 그대로
+//  - 시작 위상이 뒤집힘: 가짜 펄스 없이 RESYNC_AFTER 프레임 안에 복구
+//  - 32비트 틱 순환 / 16비트 캡처 값 확장 (drain)
+//  - 범위 밖 HIGH 구간은 drain 의 onReject 로 (valid = false, 폭 포화)
+// ============================================================
+
+#include <unity.h>
+#include <stdint.h>
+#include "rc_capture.h"
+
+static const uint32_t TPU = 24;            // 24MHz 타이머
+static const uint16_t MIN_US = 800;
+static const uint16_t MAX_US = 2200;
+static const uint32_t FRAME_US = 20000;    // 50Hz
+
+static RcEdgeDecoder gDec;
+
+void setUp(void){
+  gDec = RcEdgeDecoder(TPU, MIN_US, MAX_US);   // 통계 카운터까지 새로
+}
+
+void tearDown(void){}
+
+// 프레임 하나 (상승 → 하강) 입력. 완성된 펄스 수 반환, 마지막 폭은 lastUs
+static int pushFrame(uint32_t& tick, uint16_t us, uint16_t& lastUs){
+  int n = 0;
+  RcPulse p;
+  if (gDec.push(tick, p)){ lastUs = p.us; n++; }
+  tick += (uint32_t)us * TPU;
+  if (gDec.push(tick, p)){ lastUs = p.us; n++; }
+  tick += (FRAME_US - us) * TPU;
+  return n;
+}
+
+static void test_widths_in_phase(void){
+  gDec.reset(false);   // 다음 에지 = 상승
+  uint32_t tick = 1000;
+  uint16_t last = 0;
+  for (uint16_t us = 1000; us <= 2000; us += 7){
+    TEST_ASSERT_EQUAL_INT(1, pushFrame(tick, us, last));
+    TEST_ASSERT_EQUAL_UINT16(us, last);
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, gDec.rejects());
+  TEST_ASSERT_EQUAL_UINT32(0, gDec.resyncs());
+}
+
+static void test_wrong_start_phase_recovers(void){
+  gDec.reset(true);    // 실제로는 LOW 인데 HIGH 라고 시작
+  uint32_t tick = 5000;
+  uint16_t last = 0;
+  int frames = 0;
+  // 뒤집힌 동안은 LOW 구간(18.5ms)을 펄스로 보므로 범위 밖 → 가짜 펄스 없음.
+  // 재동기화한 프레임의 하강 에지는 이미 올바른 위상 → 정상 펄스
+  while (gDec.resyncs() == 0 && frames < 10){
+    last = 0;
+    if (pushFrame(tick, 1500, last)) TEST_ASSERT_EQUAL_UINT16(1500, last);
+    frames++;
+  }
+  TEST_ASSERT_EQUAL_UINT32(1, gDec.resyncs());
+  TEST_ASSERT_LESS_OR_EQUAL(RcEdgeDecoder::RESYNC_AFTER + 1, frames);
+
+  for (int i = 0; i < 20; ++i){
+    TEST_ASSERT_EQUAL_INT(1, pushFrame(tick, 1234, last));
+    TEST_ASSERT_EQUAL_UINT16(1234, last);
+  }
+  TEST_ASSERT_EQUAL_UINT32(1, gDec.resyncs());
+}
+
+static void test_lost_edge_resyncs(void){
+  gDec.reset(false);
+  uint32_t tick = 0;
+  uint16_t last = 0;
+  for (int i = 0; i < 5; ++i) pushFrame(tick, 1500, last);
+
+  // 하강 에지 하나 유실 → 위상 반전
+  RcPulse p;
+  TEST_ASSERT_FALSE(gDec.push(tick, p));
+  tick += FRAME_US * TPU;
+
+  int bogus = 0;
+  for (int i = 0; i < 10; ++i){
+    if (pushFrame(tick, 1500, last) && last != 1500) bogus++;
+  }
+  TEST_ASSERT_EQUAL_INT(0, bogus);
+  TEST_ASSERT_EQUAL_UINT32(1, gDec.resyncs());
+  TEST_ASSERT_EQUAL_INT(1, pushFrame(tick, 1600, last));
+  TEST_ASSERT_EQUAL_UINT16(1600, last);
+}
+
+static void test_tick_wrap(void){
+  gDec.reset(false);
+  // 펄스 한가운데서 32비트 틱이 순환
+  uint32_t tick = 0xFFFFFFFFu - 750 * TPU;
+  uint16_t last = 0;
+  for (int i = 0; i < 4; ++i){
+    TEST_ASSERT_EQUAL_INT(1, pushFrame(tick, 1500, last));
+    TEST_ASSERT_EQUAL_UINT16(1500, last);
+  }
+}
+
+static void test_drain_extends_16bit_captures(void){
+  gDec.reset(false);
+  // 16비트 카운터가 여러 번 순환하는 에지 열. 드레인 간격 0x7000 틱 (< 2^16)
+  static const uint16_t WIDTHS[3] = { 1100, 1500, 1900 };
+  static const size_t RING = 16;
+  volatile uint16_t ring[RING];
+  size_t head = 0, tail = 0;
+  uint32_t ext = 0xFFF0;
+  uint32_t edgeTick = ext + 100;
+  bool rising = true;
+  size_t queued = 0, pulses = 0;
+  bool inOrder = true;
+
+  for (int k = 0; k < 12000; ++k){
+    const uint32_t drainExt = ext + 0x7000;
+    while ((int32_t)(edgeTick - drainExt) < 0){
+      ring[head] = (uint16_t)edgeTick;      // 하드웨어가 래치하는 16비트 값
+      head = (head + 1) % RING;
+      const uint16_t us = WIDTHS[queued % 3];
+      edgeTick += (rising ? us : FRAME_US - us) * TPU;
+      if (!rising) queued++;
+      rising = !rising;
+    }
+    ext = drainExt;
+    gDec.drain(ring, RING, tail, head, (uint16_t)ext, ext, [&](const RcPulse& p){
+      if (p.us != WIDTHS[pulses % 3] || p.ticks != WIDTHS[pulses % 3] * TPU) inOrder = false;
+      pulses++;
+    });
+    TEST_ASSERT_EQUAL_UINT32(head, tail);
+  }
+  TEST_ASSERT_TRUE(inOrder);
+  TEST_ASSERT_EQUAL_UINT32(queued, pulses);
+  TEST_ASSERT_GREATER_THAN(500, pulses);
+  TEST_ASSERT_EQUAL_UINT32(0, gDec.rejects());
+}
+
+static void test_drain_reports_rejects(void){
+  gDec.reset(false);
+  // 정상 / 짧은 런트 / 긴 펄스 / 65535µs 넘는 HIGH
+  static const uint32_t WIDTHS[] = { 1500, 20, 3000, 1200, 70000 };
+  static const size_t N = sizeof(WIDTHS) / sizeof(WIDTHS[0]);
+  volatile uint16_t ring[2 * N] = {};
+  uint32_t tick = 0x10000;
+  // 에지마다 바로 드레인 (65535µs 넘는 구간도 16비트 확장이 모호하지 않게)
+  size_t tail = 0;
+  uint32_t accepted = 0, rejected = 0;
+  RcPulse last = {};
+  for (size_t i = 0; i < N; ++i){
+    for (int edge = 0; edge < 2; ++edge){
+      const size_t at = 2 * i + edge;
+      ring[at] = (uint16_t)tick;
+      gDec.drain(ring, 2 * N, tail, at + 1 == 2 * N ? 0 : at + 1, (uint16_t)tick, tick,
+        [&](const RcPulse& p){ accepted++; last = p; },
+        [&](const RcPulse& p){ rejected++; last = p; });
+      tick += (edge == 0 ? WIDTHS[i] : FRAME_US) * TPU;
+    }
+    const bool inRange = WIDTHS[i] >= MIN_US && WIDTHS[i] <= MAX_US;
+    TEST_ASSERT_EQUAL(inRange, last.valid);
+    TEST_ASSERT_EQUAL_UINT16(WIDTHS[i] > 0xFFFF ? 0xFFFF : WIDTHS[i], last.us);
+    if (WIDTHS[i] * TPU <= 0xFFFF) TEST_ASSERT_EQUAL_UINT16(WIDTHS[i] * TPU, last.ticks);
+    else TEST_ASSERT_EQUAL_UINT16(0xFFFF, last.ticks);
+  }
+  TEST_ASSERT_EQUAL_UINT32(2, accepted);
+  TEST_ASSERT_EQUAL_UINT32(3, rejected);
+  TEST_ASSERT_EQUAL_UINT32(3, gDec.rejects());
+}
+
+int main(int, char**){
+  UNITY_BEGIN();
+  RUN_TEST(test_widths_in_phase);
+  RUN_TEST(test_wrong_start_phase_recovers);
+  RUN_TEST(test_lost_edge_resyncs);
+  RUN_TEST(test_tick_wrap);
+  RUN_TEST(test_drain_extends_16bit_captures);
+  RUN_TEST(test_drain_reports_rejects);
+  return UNITY_END();
+}
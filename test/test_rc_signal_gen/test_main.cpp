@@ -0,0 +1,235 @@
+// ============================================================
+// RcSignalGen 테스트 (재현성 + 통계)
+// ------------------------------------------------------------
+//  - 같은 시드 + 설정 → 같은 에지 열, reseed 는 처음부터 다시. 다른 시드는 다른 열
+//  - 지터 없음: 상승 = k·주기, 폭 = 목표 (드리프트 ppm 만큼 늘어남)
+//  - 가우시안 σ: 상승 에지 σ, 폭 σ√2, ±1σ 안 68.3%
+//  - 균등 ±a: 범위 안, σ = a/√3
+//  - 드롭아웃: 연속 1 → 비율 p, 최대 N 연속 → pE[L] / (1 - p + pE[L])
+//  - 런트: 비율 runtProb, 폭 [min, max], LOW 구간 안쪽
+// 통계는 10만 프레임: 허용 오차는 표본 오차(σ/√N 수준)의 5배 이상
+// ============================================================
+
+#include <unity.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "rc_signal_gen.h"
+
+static const uint32_t FRAMES = 100000;
+static const uint64_t PERIOD_NS = 20000000;   // 50Hz
+static const double WIDTH_NS = 1500000.0;
+
+void setUp(void){}
+void tearDown(void){}
+
+static void expectWithin(double want, double got, double tol, const char* what){
+  if (got < want - tol || got > want + tol){
+    char msg[96];
+    snprintf(msg, sizeof(msg), "%s: want %.4f, got %.4f (tol %.4f)", what, want, got, tol);
+    TEST_FAIL_MESSAGE(msg);
+  }
+}
+
+struct Moments {
+  double n = 0, sum = 0, sumSq = 0;
+  void add(double x){ n++; sum += x; sumSq += x * x; }
+  double mean() const { return sum / n; }
+  double sd() const { return sqrt(sumSq / n - mean() * mean()); }
+};
+
+static RcSignalConfig fullConfig(){
+  RcSignalConfig cfg;
+  cfg.frameHz = 333;
+  cfg.jitterGaussUs = 1.5f;
+  cfg.jitterUniformUs = 0.5f;
+  cfg.dropoutProb = 0.05f;
+  cfg.dropoutMaxFrames = 3;
+  cfg.runtProb = 0.1f;
+  cfg.driftPpm = -40.0f;
+  return cfg;
+}
+
+static void test_same_seed_same_sequence(void){
+  RcSignalGen a(fullConfig(), 1234), b(fullConfig(), 1234), c(fullConfig(), 1235);
+  RcEdge ea[RcSignalGen::MAX_EDGES], eb[RcSignalGen::MAX_EDGES], ec[RcSignalGen::MAX_EDGES];
+  uint64_t first[64];
+  size_t firstN = 0;
+  uint32_t differ = 0;
+  for (uint32_t f = 0; f < 10000; ++f){
+    const float w = 1000.0f + (float)(f % 1001);
+    a.setWidthUs(w); b.setWidthUs(w); c.setWidthUs(w);
+    const size_t na = a.nextFrame(ea), nb = b.nextFrame(eb), nc = c.nextFrame(ec);
+    TEST_ASSERT_EQUAL_UINT32(na, nb);
+    for (size_t i = 0; i < na; ++i){
+      TEST_ASSERT_TRUE(ea[i].tNs == eb[i].tNs);
+      TEST_ASSERT_EQUAL_UINT8(ea[i].level, eb[i].level);
+      if (firstN < 64) first[firstN++] = ea[i].tNs;
+    }
+    if (na != nc || (na && ea[0].tNs != ec[0].tNs)) differ++;
+  }
+  TEST_ASSERT_EQUAL_UINT32(a.dropped(), b.dropped());
+  TEST_ASSERT_EQUAL_UINT32(a.runts(), b.runts());
+  TEST_ASSERT_GREATER_THAN(0, a.dropped());
+  TEST_ASSERT_GREATER_THAN(0, a.runts());
+  // 시드가 1 만 달라도 거의 모든 프레임이 다르다
+  TEST_ASSERT_GREATER_THAN(9000, differ);
+
+  // reseed: 카운터 0, 같은 열 처음부터
+  a.reseed(1234);
+  TEST_ASSERT_EQUAL_UINT32(0, a.frames());
+  TEST_ASSERT_EQUAL_UINT32(0, a.dropped());
+  size_t k = 0;
+  for (uint32_t f = 0; k < firstN; ++f){
+    a.setWidthUs(1000.0f + (float)(f % 1001));
+    const size_t n = a.nextFrame(ea);
+    for (size_t i = 0; i < n && k < firstN; ++i) TEST_ASSERT_TRUE(ea[i].tNs == first[k++]);
+  }
+}
+
+static void test_clean_timing_and_drift(void){
+  RcSignalConfig cfg;
+  RcSignalGen gen(cfg, 1);
+  TEST_ASSERT_TRUE(gen.periodNs() == PERIOD_NS);
+  RcEdge e[RcSignalGen::MAX_EDGES];
+  for (uint32_t f = 0; f < 1000; ++f){
+    TEST_ASSERT_EQUAL_UINT32(2, gen.nextFrame(e));
+    TEST_ASSERT_TRUE(e[0].tNs == f * PERIOD_NS);
+    TEST_ASSERT_TRUE(e[1].tNs - e[0].tNs == 1500000);
+    TEST_ASSERT_EQUAL_UINT8(1, e[0].level);
+    TEST_ASSERT_EQUAL_UINT8(0, e[1].level);
+  }
+
+  // +100ppm: 주기와 폭이 모두 1.0001 배
+  cfg.driftPpm = 100.0f;
+  gen.configure(cfg);
+  gen.reseed(1);
+  TEST_ASSERT_TRUE(gen.periodNs() == 20002000);
+  for (uint32_t f = 0; f < 1000; ++f){
+    gen.nextFrame(e);
+    expectWithin((double)f * 20002000.0, (double)e[0].tNs, 1.0, "drifted rise");
+    expectWithin(1500150.0, (double)(e[1].tNs - e[0].tNs), 1.0, "drifted width");
+  }
+}
+
+static void test_gaussian_jitter(void){
+  RcSignalConfig cfg;
+  cfg.jitterGaussUs = 2.0f;
+  RcSignalGen gen(cfg, 42);
+  RcEdge e[RcSignalGen::MAX_EDGES];
+  Moments rise, width;
+  uint32_t inside = 0;
+  gen.nextFrame(e);   // 0 번 프레임 상승은 시각 0 아래로 못 가 잘린다
+  for (uint32_t f = 1; f < FRAMES; ++f){
+    TEST_ASSERT_EQUAL_UINT32(2, gen.nextFrame(e));
+    const double r = (double)e[0].tNs - (double)f * (double)PERIOD_NS;
+    rise.add(r);
+    width.add((double)(e[1].tNs - e[0].tNs) - WIDTH_NS);
+    inside += fabs(r) <= 2000.0;
+  }
+  // 평균 오차 σ/√N ≈ 6ns, 표준편차 오차 σ/√(2N) ≈ 0.2%
+  expectWithin(0.0, rise.mean(), 40.0, "rise mean [ns]");
+  expectWithin(2000.0, rise.sd(), 2000.0 * 0.02, "rise sd [ns]");
+  expectWithin(0.0, width.mean(), 60.0, "width mean [ns]");
+  expectWithin(2000.0 * sqrt(2.0), width.sd(), 2000.0 * sqrt(2.0) * 0.02, "width sd [ns]");
+  expectWithin(0.6827, (double)inside / (FRAMES - 1), 0.01, "within 1 sigma");
+}
+
+static void test_uniform_jitter(void){
+  RcSignalConfig cfg;
+  cfg.jitterUniformUs = 3.0f;
+  RcSignalGen gen(cfg, 7);
+  RcEdge e[RcSignalGen::MAX_EDGES];
+  Moments rise;
+  double lo = 0, hi = 0;
+  gen.nextFrame(e);
+  for (uint32_t f = 1; f < FRAMES; ++f){
+    gen.nextFrame(e);
+    const double r = (double)e[0].tNs - (double)f * (double)PERIOD_NS;
+    rise.add(r);
+    if (r < lo) lo = r;
+    if (r > hi) hi = r;
+  }
+  // 정수 ns 로 잘리므로 ±1ns
+  TEST_ASSERT_TRUE(lo >= -3001.0 && hi <= 3001.0);
+  TEST_ASSERT_TRUE(lo < -2900.0 && hi > 2900.0);
+  expectWithin(0.0, rise.mean(), 30.0, "uniform mean [ns]");
+  expectWithin(3000.0 / sqrt(3.0), rise.sd(), 3000.0 / sqrt(3.0) * 0.02, "uniform sd [ns]");
+}
+
+// 드롭아웃 비율 (반환 0 인 프레임 / 전체)
+static double dropRate(float p, uint16_t maxFrames, uint64_t seed, uint32_t& longestRun){
+  RcSignalConfig cfg;
+  cfg.dropoutProb = p;
+  cfg.dropoutMaxFrames = maxFrames;
+  RcSignalGen gen(cfg, seed);
+  RcEdge e[RcSignalGen::MAX_EDGES];
+  uint32_t zeros = 0, run = 0;
+  longestRun = 0;
+  for (uint32_t f = 0; f < FRAMES; ++f){
+    if (gen.nextFrame(e) == 0){
+      zeros++;
+      if (++run > longestRun) longestRun = run;
+    } else {
+      run = 0;
+    }
+  }
+  TEST_ASSERT_EQUAL_UINT32(zeros, gen.dropped());
+  TEST_ASSERT_EQUAL_UINT32(FRAMES, gen.frames());
+  return (double)zeros / FRAMES;
+}
+
+static void test_dropout_rate(void){
+  uint32_t longest = 0;
+  // 표본 오차 √(p(1-p)/N) ≈ 0.001
+  expectWithin(0.10, dropRate(0.10f, 1, 3, longest), 0.006, "dropout p=0.1, burst 1");
+  expectWithin(0.01, dropRate(0.01f, 1, 4, longest), 0.002, "dropout p=0.01, burst 1");
+  TEST_ASSERT_LESS_OR_EQUAL(3, longest);   // 연달아 두세 번 뽑힐 확률은 매우 작다
+
+  // 버스트 1..4 균등 → E[L] = 2.5: 0.25 / 1.15
+  expectWithin(0.25 / 1.15, dropRate(0.10f, 4, 5, longest), 0.01, "dropout p=0.1, burst 4");
+  TEST_ASSERT_GREATER_OR_EQUAL(4, longest);
+
+  dropRate(0.0f, 4, 6, longest);
+  TEST_ASSERT_EQUAL_UINT32(0, longest);
+}
+
+static void test_runts(void){
+  RcSignalConfig cfg;
+  cfg.runtProb = 0.25f;
+  cfg.runtMinUs = 2.0f;
+  cfg.runtMaxUs = 60.0f;
+  RcSignalGen gen(cfg, 9);
+  RcEdge e[RcSignalGen::MAX_EDGES];
+  uint64_t lastNs = 0;
+  uint32_t withRunt = 0;
+  for (uint32_t f = 0; f < FRAMES; ++f){
+    const size_t n = gen.nextFrame(e);
+    TEST_ASSERT_TRUE(n == 2 || n == 4);
+    // 에지는 프레임 안팎 모두 시각순, 레벨은 교대
+    for (size_t i = 0; i < n; ++i){
+      if (f || i) TEST_ASSERT_TRUE(e[i].tNs > lastNs);
+      TEST_ASSERT_EQUAL_UINT8(i & 1 ? 0 : 1, e[i].level);
+      lastNs = e[i].tNs;
+    }
+    if (n == 4){
+      withRunt++;
+      const uint64_t runt = e[3].tNs - e[2].tNs;
+      TEST_ASSERT_TRUE(runt >= 1999 && runt <= 60001);
+      TEST_ASSERT_TRUE(e[3].tNs < (uint64_t)(f + 1) * PERIOD_NS);
+    }
+  }
+  TEST_ASSERT_EQUAL_UINT32(withRunt, gen.runts());
+  expectWithin(0.25, (double)withRunt / FRAMES, 0.01, "runt rate");
+}
+
+int main(int, char**){
+  UNITY_BEGIN();
+  RUN_TEST(test_same_seed_same_sequence);
+  RUN_TEST(test_clean_timing_and_drift);
+  RUN_TEST(test_gaussian_jitter);
+  RUN_TEST(test_uniform_jitter);
+  RUN_TEST(test_dropout_rate);
+  RUN_TEST(test_runts);
+  return UNITY_END();
+}
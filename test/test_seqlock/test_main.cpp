@@ -0,0 +1,121 @@
+// ============================================================
+// Seqlock 호스트 스트레스 테스트
+// ------------------------------------------------------------
+// 작성자 스레드(taskRcInput 역할) 1 + 독자 스레드 2 (taskLed / 셸 역할).
+//  - 돌려받은 사본은 찢어지지 않음 (모든 워드가 seq 에서 유도)
+//  - 독자마다 seq 는 단조 증가 (옛 값으로 되돌아가지 않음)
+//  - maxTries 독자는 실패할 수 있어도 성공한 사본은 온전
+//  - writes() == 작성 횟수, 마지막 읽기 == 마지막 쓰기
+// ============================================================
+
+#include <unity.h>
+#include <stdint.h>
+#include <atomic>
+#include <thread>
+#include "seqlock.h"
+
+static const uint32_t WRITES = 1000000;
+static const size_t PAYLOAD_WORDS = 16;   // 64 B: 워드 복사 도중 끼어들 틈이 넉넉하게
+
+struct Payload {
+  uint32_t seq;
+  uint32_t w[PAYLOAD_WORDS - 1];
+};
+
+static uint32_t wordFor(uint32_t seq, size_t i){ return seq * 2654435761u + (uint32_t)i * 0x9E3779B9u; }
+
+static Payload make(uint32_t seq){
+  Payload p;
+  p.seq = seq;
+  for (size_t i = 0; i < PAYLOAD_WORDS - 1; ++i) p.w[i] = wordFor(seq, i);
+  return p;
+}
+
+static bool intact(const Payload& p){
+  for (size_t i = 0; i < PAYLOAD_WORDS - 1; ++i){
+    if (p.w[i] != wordFor(p.seq, i)) return false;
+  }
+  return true;
+}
+
+void setUp(void){}
+void tearDown(void){}
+
+static void test_single_thread(void){
+  static Seqlock<Payload> lock;
+  Payload p;
+  // 생성 직후: 0 으로 채운 본문, 쓰기 0 회
+  TEST_ASSERT_TRUE(lock.read(p, 1));
+  TEST_ASSERT_EQUAL_UINT32(0, p.seq);
+  TEST_ASSERT_EQUAL_UINT32(0, p.w[0]);
+  TEST_ASSERT_EQUAL_UINT32(0, lock.writes());
+
+  for (uint32_t s = 1; s <= 3; ++s) lock.write(make(s));
+  TEST_ASSERT_EQUAL_UINT32(3, lock.writes());
+  TEST_ASSERT_TRUE(lock.read(p, 1));
+  TEST_ASSERT_EQUAL_UINT32(3, p.seq);
+  TEST_ASSERT_TRUE(intact(p));
+}
+
+struct ReaderStats {
+  uint32_t reads = 0, failed = 0, torn = 0, backwards = 0, lastSeq = 0;
+};
+
+static void test_writer_and_readers(void){
+  static Seqlock<Payload> lock;
+  std::atomic<bool> done{false};
+
+  std::thread writer([&]{
+    for (uint32_t s = 1; s <= WRITES; ++s){
+      lock.write(make(s));
+      // 가끔 양보해 독자가 쓰기 한가운데와 쓰기 사이 모두에 걸리게
+      if ((s & 0xFF) == 0) std::this_thread::yield();
+    }
+    done.store(true, std::memory_order_release);
+  });
+
+  // maxTries 0 = 성공할 때까지, 1 = 한 번만 시도
+  auto reader = [&](ReaderStats& st, uint32_t maxTries){
+    Payload p;
+    while (true){
+      const bool last = done.load(std::memory_order_acquire);
+      if (!lock.read(p, maxTries)){
+        st.failed++;
+        continue;
+      }
+      st.reads++;
+      if (!intact(p)) st.torn++;
+      if (p.seq < st.lastSeq) st.backwards++;
+      st.lastSeq = p.seq;
+      if (last) break;
+    }
+  };
+
+  ReaderStats a, b;
+  std::thread r1([&]{ reader(a, 0); });
+  std::thread r2([&]{ reader(b, 1); });
+
+  writer.join();
+  r1.join();
+  r2.join();
+
+  TEST_ASSERT_EQUAL_UINT32(0, a.torn);
+  TEST_ASSERT_EQUAL_UINT32(0, b.torn);
+  TEST_ASSERT_EQUAL_UINT32(0, a.backwards);
+  TEST_ASSERT_EQUAL_UINT32(0, b.backwards);
+  TEST_ASSERT_EQUAL_UINT32(0, a.failed);
+  TEST_ASSERT_GREATER_THAN(0, a.reads);
+  TEST_ASSERT_GREATER_THAN(0, b.reads);
+
+  // 작성자가 끝난 뒤 읽은 마지막 사본 = 마지막 쓰기
+  TEST_ASSERT_EQUAL_UINT32(WRITES, lock.writes());
+  TEST_ASSERT_EQUAL_UINT32(WRITES, a.lastSeq);
+  TEST_ASSERT_EQUAL_UINT32(WRITES, b.lastSeq);
+}
+
+int main(int, char**){
+  UNITY_BEGIN();
+  RUN_TEST(test_single_thread);
+  RUN_TEST(test_writer_and_readers);
+  return UNITY_END();
+}
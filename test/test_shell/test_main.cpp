@@ -0,0 +1,260 @@
+// ============================================================
+// 명령 셸 테스트 (바이트 열 입력)
+// ------------------------------------------------------------
+// Shell 단독 (시험용 명령 표, feed 로 한 글자씩):
+//  - 인자 수 / 처리기 false → usage, 모르는 명령, 인자 초과
+//  - 줄 넘침 → 오류 한 번, 다음 줄은 정상. CRLF 는 한 번만 실행, 백스페이스
+//  - ShellOut 이 넘치면 cap - 1 에서 자르고 truncated
+//  - shellParseInt: int32 경계, 넘침(ERANGE) / 뒤 글자 / 빈 숫자는 거부
+// src/ 의 실제 명령 (setup + 가상 시계, halSerialInject → taskLogDrain → halSerialTap):
+//  - get / set 범위 검사, 숫자 넘침은 usage, 모르는 이름 / 명령
+//  - 긴 응답은 taskLogDrain 응답 버퍼(1536)에서 잘리고 끝에 잘림 표시
+// ============================================================
+
+#include <unity.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "hal.h"
+#include "shell.h"
+
+// ------------------ Shell 단독 ------------------
+
+static int gPingCalls = 0;
+
+static bool cmdPing(size_t argc, char* const* argv, ShellOut& out){
+  gPingCalls++;
+  out.print("pong");
+  for (size_t i = 1; i < argc; ++i) out.print(" %s", argv[i]);
+  out.print("\n");
+  return true;
+}
+
+// add <a> <b>: 숫자가 아니면 false → usage
+static bool cmdAdd(size_t, char* const* argv, ShellOut& out){
+  int32_t a, b;
+  if (!shellParseInt(argv[1], a) || !shellParseInt(argv[2], b)) return false;
+  out.print("%d\n", (int)(a + b));
+  return true;
+}
+
+static constexpr ShellCommand TEST_COMMANDS[] = {
+  { "ping", 0, 2, cmdPing, "ping [a] [b]" },
+  { "add",  2, 2, cmdAdd,  "add <a> <b>" },
+};
+static_assert(shellNamesUnique(TEST_COMMANDS), "TEST_COMMANDS has duplicate names");
+
+typedef Shell<16, 3> TestShell;
+
+// 한 글자씩 넣고 실행된 줄들의 응답을 이어 붙여 반환
+static std::string feed(TestShell& sh, const char* bytes){
+  static char buf[256];
+  ShellOut out(buf, sizeof(buf));
+  std::string all;
+  for (const char* p = bytes; *p; ++p){
+    if (sh.feed(*p, out)){
+      all.append(out.data(), out.size());
+      out.clear();
+    }
+  }
+  return all;
+}
+
+void setUp(void){}
+void tearDown(void){}
+
+static void test_usage_and_unknown(void){
+  static TestShell sh(TEST_COMMANDS);
+  gPingCalls = 0;
+  TEST_ASSERT_TRUE(feed(sh, "ping\n") == "pong\n");
+  TEST_ASSERT_TRUE(feed(sh, "  ping  x\ty \n") == "pong x y\n");
+  TEST_ASSERT_TRUE(feed(sh, "add 2 0x10\n") == "18\n");
+  TEST_ASSERT_EQUAL_UINT32(0, sh.errors());
+
+  // 인자 수 (처리기는 안 불림) / 처리기 false / 인자 초과 (MaxArgs 3)
+  TEST_ASSERT_TRUE(feed(sh, "add 1\n") == "usage: add <a> <b>\n");
+  TEST_ASSERT_TRUE(feed(sh, "ping a b c\n") == "usage: ping [a] [b]\n");
+  TEST_ASSERT_TRUE(feed(sh, "add 1 2x\n") == "usage: add <a> <b>\n");
+  TEST_ASSERT_TRUE(feed(sh, "ping 1 2 3 4 5\n") == "usage: ping [a] [b]\n");
+  TEST_ASSERT_EQUAL_INT(2, gPingCalls);
+
+  TEST_ASSERT_TRUE(feed(sh, "pong\n") == "error: unknown command 'pong' (try help)\n");
+  TEST_ASSERT_TRUE(feed(sh, "help\n") == "  ping [a] [b]\n  add <a> <b>\n");
+  TEST_ASSERT_EQUAL_UINT32(9, sh.executed());
+  TEST_ASSERT_EQUAL_UINT32(5, sh.errors());
+}
+
+static void test_line_editing_and_overflow(void){
+  static TestShell sh(TEST_COMMANDS);
+  // CRLF / 빈 줄은 한 번만, 백스페이스는 앞 글자를 지움
+  TEST_ASSERT_TRUE(feed(sh, "ping\r\n\r\n\n") == "pong\n");
+  TEST_ASSERT_TRUE(feed(sh, "pinx\bg\n") == "pong\n");
+  TEST_ASSERT_TRUE(feed(sh, "\b\b\x7Fping\n") == "pong\n");
+
+  // 15글자까지 (LineMax 16), 넘으면 줄 끝에서 오류 한 번, 그 줄은 실행 안 함
+  TEST_ASSERT_TRUE(feed(sh, "ping 1234567890\n") == "pong 1234567890\n");
+  TEST_ASSERT_TRUE(feed(sh, "ping 12345678901 ping\n") == "error: line too long (max 15)\n");
+  TEST_ASSERT_TRUE(feed(sh, "add 40 2\n") == "42\n");
+  TEST_ASSERT_EQUAL_UINT32(1, sh.errors());
+  TEST_ASSERT_EQUAL_UINT32(5, sh.executed());
+}
+
+static void test_shell_out_truncates(void){
+  char buf[8];
+  ShellOut out(buf, sizeof(buf));
+  out.print("abc");
+  TEST_ASSERT_FALSE(out.truncated());
+  out.print("%d", 12345);
+  TEST_ASSERT_TRUE(out.truncated());
+  TEST_ASSERT_EQUAL_UINT32(7, out.size());
+  TEST_ASSERT_TRUE(!strcmp(buf, "abc1234"));
+  out.print("more");   // 이미 가득: 그대로
+  TEST_ASSERT_EQUAL_UINT32(7, out.size());
+  out.clear();
+  TEST_ASSERT_FALSE(out.truncated());
+  TEST_ASSERT_EQUAL_UINT32(0, out.size());
+}
+
+static void test_parse_int(void){
+  int32_t v = 7;
+  TEST_ASSERT_TRUE(shellParseInt("2147483647", v));
+  TEST_ASSERT_EQUAL_INT32(INT32_MAX, v);
+  TEST_ASSERT_TRUE(shellParseInt("-2147483648", v));
+  TEST_ASSERT_EQUAL_INT32(INT32_MIN, v);
+  TEST_ASSERT_TRUE(shellParseInt("0x7fffffff", v));
+  TEST_ASSERT_EQUAL_INT32(INT32_MAX, v);
+  TEST_ASSERT_TRUE(shellParseInt("-0x10", v));
+  TEST_ASSERT_EQUAL_INT32(-16, v);
+
+  v = 7;
+  static const char* const BAD[] = {
+    "", "-", "0x", "12abc", "1 ", "2147483648", "-2147483649", "0x80000000",
+    "99999999999", "99999999999999999999999", "-99999999999999999999999",
+  };
+  for (const char* s : BAD){
+    if (shellParseInt(s, v)){
+      char msg[64];
+      snprintf(msg, sizeof(msg), "accepted '%s'", s);
+      TEST_FAIL_MESSAGE(msg);
+    }
+  }
+  TEST_ASSERT_FALSE(shellParseInt(nullptr, v));
+  TEST_ASSERT_EQUAL_INT32(7, v);   // 실패하면 안 건드림
+}
+
+// ------------------ src/ 명령 (taskLogDrain 경유) ------------------
+
+static std::mutex gTapLock;
+static std::vector<std::string> gReplies;   // 셸 응답 (로그 줄 "[" 제외)
+
+// 한 줄 보내고 응답 하나를 기다린다 (가상 시계 20ms 씩 = taskLogDrain 유휴 주기)
+static std::string command(const char* line){
+  size_t before;
+  {
+    std::lock_guard<std::mutex> g(gTapLock);
+    before = gReplies.size();
+  }
+  halSerialInject(line, strlen(line));
+  halSerialInject("\n", 1);
+  for (int i = 0; i < 10; ++i){
+    halClockAdvanceUs(20000);
+    TEST_ASSERT_TRUE(halSettle());
+    std::lock_guard<std::mutex> g(gTapLock);
+    if (gReplies.size() > before) return gReplies[before];
+  }
+  TEST_FAIL_MESSAGE(line);
+  return std::string();
+}
+
+static bool startsWith(const std::string& s, const char* prefix){
+  return s.compare(0, strlen(prefix), prefix) == 0;
+}
+
+static void test_get_set_ranges(void){
+  TEST_ASSERT_TRUE(command("get avg_window") == "avg_window=32\n");
+  TEST_ASSERT_TRUE(command("set timeout_ms 19") == "error: timeout_ms must be 20..5000\n");
+  TEST_ASSERT_TRUE(command("set timeout_ms 5001") == "error: timeout_ms must be 20..5000\n");
+  TEST_ASSERT_TRUE(command("set timeout_ms 5000") == "ok\n");
+  TEST_ASSERT_TRUE(command("get timeout_ms") == "timeout_ms=5000\n");
+  TEST_ASSERT_TRUE(command("set timeout_ms 20") == "ok\n");
+  TEST_ASSERT_TRUE(command("set hysteresis_q8 0") == "ok\n");
+  TEST_ASSERT_TRUE(command("set hysteresis_q8 -1") == "error: hysteresis_q8 must be 0..128\n");
+
+  // 넘치는 숫자 / 숫자 아님 → usage (INT32_MAX 로 잘려 받아들여지지 않음)
+  const std::string usage = "usage: set <name> <value> | set pattern <value> <color|off>\n";
+  TEST_ASSERT_TRUE(command("set blink_ms 99999999999") == usage);
+  TEST_ASSERT_TRUE(command("set blink_ms 300ms") == usage);
+  TEST_ASSERT_TRUE(command("set blink_ms") == usage);
+  TEST_ASSERT_TRUE(command("get blink_ms") == "blink_ms=200\n");
+
+  TEST_ASSERT_TRUE(command("set pattern 101 red") ==
+                   "error: value -100..100, color red|yellow|green|purple|blue|lime|orange|off\n");
+  TEST_ASSERT_TRUE(command("set pattern 5 pink") ==
+                   "error: value -100..100, color red|yellow|green|purple|blue|lime|orange|off\n");
+  TEST_ASSERT_TRUE(command("set pattern 4294967296 red") == usage);
+  TEST_ASSERT_TRUE(command("set nope 1") == "error: unknown parameter 'nope'\n");
+  TEST_ASSERT_TRUE(command("get nope") == "error: unknown parameter 'nope'\n");
+  TEST_ASSERT_TRUE(command("get a b") == "usage: get [name|pattern]\n");
+  TEST_ASSERT_TRUE(command("frob 1") == "error: unknown command 'frob' (try help)\n");
+  TEST_ASSERT_TRUE(command("rule del 99999999999") == "usage: " + std::string(
+    "rule [list|add <lo> <hi> <color> [dwell=ms] [rate=min:max] [prio=n] [period=ms]|del <i>|clear|save]\n"));
+}
+
+static void test_line_overflow_and_reply_size(void){
+  // Shell<96, 8>: 95글자 넘는 줄은 오류, 다음 줄은 정상
+  std::string longLine = "get ";
+  longLine.append(120, 'x');
+  TEST_ASSERT_TRUE(command(longLine.c_str()) == "error: line too long (max 95)\n");
+  TEST_ASSERT_TRUE(command("get avg_window") == "avg_window=32\n");
+
+  // 도움말은 버퍼 안에 다 들어간다
+  const std::string help = command("help");
+  TEST_ASSERT_TRUE(help.find("truncated") == std::string::npos);
+  TEST_ASSERT_TRUE(help.find("  rule [list|add") != std::string::npos);
+
+  // 201개 값 모두 패턴 → get pattern 은 약 2.4kB → 1536 에서 잘리고 표시
+  char line[48];
+  for (int v = -100; v <= 100; ++v){
+    snprintf(line, sizeof(line), "set pattern %d purple", v);
+    TEST_ASSERT_TRUE(command(line) == "ok\n");
+  }
+  const std::string reply = command("get pattern");
+  TEST_ASSERT_TRUE(startsWith(reply, "patterns: -100=purple -99=purple"));
+  TEST_ASSERT_LESS_OR_EQUAL(1536, reply.size());
+  TEST_ASSERT_GREATER_THAN(1400, reply.size());
+  const char* const NOTE = "\n...(truncated)\n";
+  TEST_ASSERT_TRUE(reply.size() > strlen(NOTE) &&
+                   reply.compare(reply.size() - strlen(NOTE), strlen(NOTE), NOTE) == 0);
+
+  for (int v = -100; v <= 100; ++v){
+    snprintf(line, sizeof(line), "set pattern %d off", v);
+    TEST_ASSERT_TRUE(command(line) == "ok\n");
+  }
+  TEST_ASSERT_TRUE(command("get pattern") == "patterns:\n");
+}
+
+int main(int, char**){
+#ifdef KV_STORE_DIR
+  remove(KV_STORE_DIR "/kv_cal.bin");
+  remove(KV_STORE_DIR "/kv_rules.bin");
+#endif
+  halSerialTap([](const uint8_t* p, size_t n){
+    if (!n || p[0] == '[') return;   // 로그 줄
+    std::lock_guard<std::mutex> g(gTapLock);
+    gReplies.emplace_back(reinterpret_cast<const char*>(p), n);
+  });
+  halClockManual(true);
+  setup();
+
+  UNITY_BEGIN();
+  RUN_TEST(test_usage_and_unknown);
+  RUN_TEST(test_line_editing_and_overflow);
+  RUN_TEST(test_shell_out_truncates);
+  RUN_TEST(test_parse_int);
+  RUN_TEST(test_get_set_ranges);
+  RUN_TEST(test_line_overflow_and_reply_size);
+  return UNITY_END();
+}
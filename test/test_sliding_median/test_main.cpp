@@ -0,0 +1,117 @@
+// ============================================================
+// SlidingMedian / Hampel 테스트
+// ------------------------------------------------------------
+//  - SlidingMedian<N>: 최근 N개(0 제외)를 매번 정렬한 기준과 같은가
+//    (N = 3, 4, 5, 8, 31 / 짝수 N 은 가운데 두 값 평균)
+//  - Hampel: 안정 신호 속 글리치 1개는 중앙값으로 바뀌고, 계단 변화는 통과
+// ============================================================
+
+#include <unity.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "sliding_median.h"
+
+static uint32_t gRng = 0xC0FFEEu;
+static uint32_t rnd(){
+  gRng ^= gRng << 13; gRng ^= gRng >> 17; gRng ^= gRng << 5;
+  return gRng;
+}
+
+void setUp(void){ gRng = 0xC0FFEEu; }
+void tearDown(void){}
+
+// 기준: 최근 N개 (0 은 입력 무시) 를 복사해 삽입 정렬
+template <size_t N>
+struct SortedMedian {
+  uint16_t buf[N] = {};
+  size_t count = 0, pos = 0;
+
+  uint16_t push(uint16_t v){
+    if (v){
+      buf[pos] = v;
+      pos = (pos + 1) % N;
+      if (count < N) count++;
+    }
+    if (!count) return 0;
+    uint16_t t[N];
+    for (size_t i = 0; i < count; ++i){
+      size_t j = i;
+      while (j > 0 && t[j - 1] > buf[i]){ t[j] = t[j - 1]; j--; }
+      t[j] = buf[i];
+    }
+    if (count & 1) return t[count / 2];
+    return (uint16_t)((t[count / 2 - 1] + t[count / 2]) / 2);
+  }
+};
+
+template <size_t N>
+static void checkAgainstSorted(uint32_t samples){
+  static SlidingMedian<N> median;
+  static SortedMedian<N> ref;
+  median.reset();
+  ref = SortedMedian<N>();
+  for (uint32_t i = 0; i < samples; ++i){
+    // 0 / 중복 값 / 넓은 범위가 섞이게
+    const uint32_t r = rnd();
+    uint16_t v;
+    if ((r & 15) == 0) v = 0;
+    else if ((r & 0x30) == 0) v = (uint16_t)(1500 + (r >> 16) % 4);
+    else v = (uint16_t)(800 + (r >> 16) % 1401);
+
+    const uint16_t want = ref.push(v);
+    const uint16_t got = median.push(v);
+    if (want != got){
+      char msg[96];
+      snprintf(msg, sizeof(msg), "N=%u sample %u: sorted %u, SlidingMedian %u", (unsigned)N, i, want, got);
+      TEST_FAIL_MESSAGE(msg);
+    }
+  }
+  TEST_ASSERT_EQUAL_UINT32(N, median.count());
+}
+
+static void test_median_matches_sorted_reference(void){
+  checkAgainstSorted<3>(200000);
+  checkAgainstSorted<4>(200000);
+  checkAgainstSorted<5>(200000);
+  checkAgainstSorted<8>(200000);
+  checkAgainstSorted<31>(200000);
+}
+
+static void test_median_fill_phase(void){
+  SlidingMedian<5> m;
+  TEST_ASSERT_EQUAL_UINT16(0, m.value());
+  TEST_ASSERT_EQUAL_UINT16(1500, m.push(1500));
+  TEST_ASSERT_EQUAL_UINT16(1250, m.push(1000));     // 짝수 개: 평균
+  TEST_ASSERT_EQUAL_UINT16(1500, m.push(2000));
+  TEST_ASSERT_EQUAL_UINT16(1500, m.push(0));        // 0 은 빈 칸 → 무시
+  TEST_ASSERT_EQUAL_UINT32(3, m.count());
+}
+
+static void test_hampel_replaces_glitch(void){
+  Hampel<7, 30, 3> h;
+  for (int i = 0; i < 50; ++i) h.push((uint16_t)(1500 + (i % 3) - 1));
+  const uint32_t before = h.rejects();
+  const uint16_t out = h.push(2100);                // 글리치 1개
+  TEST_ASSERT_EQUAL_UINT32(before + 1, h.rejects());
+  TEST_ASSERT_LESS_OR_EQUAL(1501, out);
+  TEST_ASSERT_GREATER_OR_EQUAL(1499, out);
+  TEST_ASSERT_EQUAL_UINT16(1500, h.push(1500));     // 다음 정상 샘플은 그대로
+}
+
+static void test_hampel_passes_step(void){
+  Hampel<7, 30, 3> h;
+  for (int i = 0; i < 50; ++i) h.push(1500);
+  // 계단: 처음 몇 개는 이상치로 보일 수 있지만 창 절반이 넘어가면 통과
+  uint16_t out = 0;
+  for (int i = 0; i < 7; ++i) out = h.push(1800);
+  TEST_ASSERT_EQUAL_UINT16(1800, out);
+}
+
+int main(int, char**){
+  UNITY_BEGIN();
+  RUN_TEST(test_median_matches_sorted_reference);
+  RUN_TEST(test_median_fill_phase);
+  RUN_TEST(test_hampel_replaces_glitch);
+  RUN_TEST(test_hampel_passes_step);
+  return UNITY_END();
+}
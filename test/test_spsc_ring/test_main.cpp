@@ -0,0 +1,84 @@
+// ============================================================
+// SpscRing 호스트 스트레스 테스트
+// ------------------------------------------------------------
+// 생산자 스레드(ISR 역할) 1 + 소비자 스레드(taskRcInput 역할) 1.
+//  - 받은 레코드는 순서대로 (건너뛸 수는 있어도 뒤바뀌거나 중복 없음)
+//  - 내용이 찢어지지 않음 (us 는 tUs 에서 유도)
+//  - 적재 성공 + overruns == 제공한 수, 적재 성공 == 받은 수
+// ============================================================
+
+#include <unity.h>
+#include <stdint.h>
+#include <atomic>
+#include <thread>
+#include "rc_capture.h"
+#include "spsc_ring.h"
+
+static const uint32_t OFFERED = 2000000;
+
+static uint16_t widthFor(uint32_t i){ return (uint16_t)(800 + (i * 7919u) % 1401); }
+
+void setUp(void){}
+void tearDown(void){}
+
+static void test_single_thread_fifo_and_overrun(void){
+  static SpscRing<PulseRecord, 64> ring;
+  for (uint32_t i = 0; i < 70; ++i) ring.push(PulseRecord{ i, widthFor(i) });
+  TEST_ASSERT_EQUAL_UINT32(64, ring.size());
+  TEST_ASSERT_EQUAL_UINT32(6, ring.overruns());
+
+  // 가득 찼을 때는 새 항목을 버린다 → 0..63 이 그대로
+  PulseRecord rec;
+  for (uint32_t i = 0; i < 64; ++i){
+    TEST_ASSERT_TRUE(ring.pop(rec));
+    TEST_ASSERT_EQUAL_UINT32(i, rec.tUs);
+  }
+  TEST_ASSERT_FALSE(ring.pop(rec));
+  TEST_ASSERT_TRUE(ring.empty());
+}
+
+static void test_producer_consumer_threads(void){
+  static SpscRing<PulseRecord, 64> ring;
+  std::atomic<bool> done{false};
+  uint32_t pushed = 0;
+
+  std::thread producer([&]{
+    for (uint32_t i = 0; i < OFFERED; ++i){
+      if (ring.push(PulseRecord{ i, widthFor(i) })) pushed++;
+      // 가끔 양보해 소비자가 따라잡는 구간 / 밀리는 구간이 모두 생기게
+      if ((i & 0x3FF) == 0) std::this_thread::yield();
+    }
+    done.store(true, std::memory_order_release);
+  });
+
+  uint32_t received = 0, outOfOrder = 0, torn = 0;
+  int64_t last = -1;
+  std::thread consumer([&]{
+    PulseRecord rec;
+    while (true){
+      if (!ring.pop(rec)){
+        if (done.load(std::memory_order_acquire) && ring.empty()) break;
+        continue;
+      }
+      if ((int64_t)rec.tUs <= last) outOfOrder++;
+      if (rec.us != widthFor(rec.tUs)) torn++;
+      last = rec.tUs;
+      received++;
+    }
+  });
+
+  producer.join();
+  consumer.join();
+
+  TEST_ASSERT_EQUAL_UINT32(0, outOfOrder);
+  TEST_ASSERT_EQUAL_UINT32(0, torn);
+  TEST_ASSERT_EQUAL_UINT32(pushed, received);
+  TEST_ASSERT_EQUAL_UINT32(OFFERED, pushed + ring.overruns());
+}
+
+int main(int, char**){
+  UNITY_BEGIN();
+  RUN_TEST(test_single_thread_fifo_and_overrun);
+  RUN_TEST(test_producer_consumer_threads);
+  return UNITY_END();
+}
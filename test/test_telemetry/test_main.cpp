@@ -0,0 +1,244 @@
+// ============================================================
+// 텔레메트리 테스트 (COBS / CRC / TelemetryTx / TelemetryDecoder)
+// ------------------------------------------------------------
+//  - CRC-16/CCITT-FALSE 표준 검사값, COBS 왕복 (0x00 연속, 254바이트 넘는 무0 구간)
+//  - 형식이 깨진 COBS 프레임은 0
+//  - TelemetryTx → 패킷 단위로 잘리는 쓰기 (send_nb 흉내: 64바이트, 사이사이 바쁨 0)
+//    → 임의 크기로 잘라 넣은 복호기: 모든 샘플이 순서대로, 오류 없음
+//  - 묶음 사이에만 텍스트가 끼면 프레임 손상 0 (taskLogDrain / taskTelemetry 송신권 정책)
+//  - 바이트 하나 뒤집힘 → CRC 오류 1 (또는 COBS 오류), 다음 프레임에서 재동기
+//  - 송신 측 자리 부족 → drops, 수신 측 seq 빈 번호 → lost
+// ============================================================
+
+#include <unity.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "telemetry.h"
+
+static uint32_t gRng = 0x7E1Eu;
+static uint32_t rnd(){
+  gRng ^= gRng << 13; gRng ^= gRng >> 17; gRng ^= gRng << 5;
+  return gRng;
+}
+
+static TelemetrySample sampleFor(uint32_t seq){
+  TelemetrySample s;
+  s.seq = seq;
+  s.tMicros = seq * 2000u + 17u;
+  s.rawUs = (uint16_t)(1000 + seq % 1001);
+  s.avgUs = (uint16_t)(1000 + (seq * 7) % 1001);
+  s.percent = (int16_t)((int32_t)(seq % 201) - 100);
+  s.flags = (uint16_t)(seq & 0x7);
+  return s;
+}
+
+static bool sameSample(const TelemetrySample& a, const TelemetrySample& b){
+  return memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+// 받은 샘플 + 복호기
+struct Receiver {
+  TelemetryDecoder dec;
+  std::vector<TelemetrySample> got;
+
+  void feed(const uint8_t* p, size_t n){
+    dec.feed(p, n, [this](const TelemetrySample& s){ got.push_back(s); });
+  }
+  // 1..40 바이트씩 잘라서
+  void feedChunked(const std::vector<uint8_t>& bytes){
+    for (size_t i = 0; i < bytes.size();){
+      const size_t n = std::min<size_t>(1 + rnd() % 40, bytes.size() - i);
+      feed(bytes.data() + i, n);
+      i += n;
+    }
+  }
+};
+
+// USBCDC::send_nb 흉내: 바쁘면 0, 아니면 최대 64바이트 한 패킷 (다음 호출은 바쁨)
+struct CdcSim {
+  std::vector<uint8_t> wire;
+  bool busy = false;
+
+  size_t write(const uint8_t* p, size_t n){
+    if (busy) return 0;
+    const size_t k = n < 64 ? n : 64;
+    wire.insert(wire.end(), p, p + k);
+    busy = true;
+    return k;
+  }
+  void tick(){ busy = false; }   // 1ms: 패킷 전송 완료
+};
+
+void setUp(void){ gRng = 0x7E1Eu; }
+void tearDown(void){}
+
+static void test_crc_and_cobs_round_trip(void){
+  // CRC-16/CCITT-FALSE 검사값
+  const uint8_t check[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+  TEST_ASSERT_EQUAL_UINT16(0x29B1, telemCrc16(check, sizeof(check)));
+  // 나눠서 계산해도 같음
+  TEST_ASSERT_EQUAL_UINT16(0x29B1, telemCrc16(check + 4, 5, telemCrc16(check, 4)));
+
+  // 고정 예: 00 → 01 01, 11 22 00 33 → 03 11 22 02 33
+  uint8_t out[600], back[600];
+  const uint8_t z[] = { 0x00 };
+  TEST_ASSERT_EQUAL_UINT32(2, cobsEncode(z, 1, out));
+  TEST_ASSERT_EQUAL_UINT8(1, out[0]);
+  TEST_ASSERT_EQUAL_UINT8(1, out[1]);
+  const uint8_t a[] = { 0x11, 0x22, 0x00, 0x33 };
+  const uint8_t aEnc[] = { 0x03, 0x11, 0x22, 0x02, 0x33 };
+  TEST_ASSERT_EQUAL_UINT32(sizeof(aEnc), cobsEncode(a, sizeof(a), out));
+  TEST_ASSERT_EQUAL_MEMORY(aEnc, out, sizeof(aEnc));
+
+  // 무작위 (0x00 비율 다양, 길이 0..520 → 254 경계 여러 번)
+  uint8_t in[520];
+  for (int round = 0; round < 2000; ++round){
+    const size_t n = rnd() % (sizeof(in) + 1);
+    const uint32_t zeroEvery = 1 + round % 300;
+    for (size_t i = 0; i < n; ++i) in[i] = (rnd() % zeroEvery) ? (uint8_t)(1 + rnd() % 255) : 0;
+    const size_t e = cobsEncode(in, n, out);
+    TEST_ASSERT_LESS_OR_EQUAL(n + n / 254 + 1, e);
+    for (size_t i = 0; i < e; ++i) TEST_ASSERT_TRUE(out[i] != 0);
+    if (!n) continue;   // 빈 입력은 복호 결과도 0 (형식 오류와 구분 안 함)
+    TEST_ASSERT_EQUAL_UINT32(n, cobsDecode(out, e, back, sizeof(back)));
+    TEST_ASSERT_EQUAL_MEMORY(in, back, n);
+  }
+}
+
+static void test_cobs_rejects_malformed(void){
+  uint8_t back[16];
+  const uint8_t zeroInside[] = { 0x03, 0x11, 0x00 };
+  TEST_ASSERT_EQUAL_UINT32(0, cobsDecode(zeroInside, sizeof(zeroInside), back, sizeof(back)));
+  const uint8_t shortRun[] = { 0x05, 0x11, 0x22 };   // 4바이트 예고, 2바이트뿐
+  TEST_ASSERT_EQUAL_UINT32(0, cobsDecode(shortRun, sizeof(shortRun), back, sizeof(back)));
+  const uint8_t tooLong[] = { 0x04, 1, 2, 3, 0x04, 4, 5, 6 };
+  TEST_ASSERT_EQUAL_UINT32(0, cobsDecode(tooLong, sizeof(tooLong), back, 5));
+}
+
+// 500 샘플/s 를 10ms 묶음으로, 송신은 1ms 마다 패킷 하나
+static void test_tx_decoder_round_trip(void){
+  static TelemetryTx<2048> tx;
+  CdcSim cdc;
+  uint32_t seq = 0;
+  for (uint32_t ms = 0; ms < 4000; ++ms){
+    if (ms % 2 == 0){ const TelemetrySample s = sampleFor(seq++); TEST_ASSERT_TRUE(tx.push(TELEM_SAMPLE, &s, sizeof(s))); }
+    if (ms % 10 == 0 || tx.sending()) tx.drain([&](const uint8_t* p, size_t n){ return cdc.write(p, n); });
+    cdc.tick();
+  }
+  while (tx.drain([&](const uint8_t* p, size_t n){ return cdc.write(p, n); })) cdc.tick();
+
+  TEST_ASSERT_EQUAL_UINT32(seq, tx.frames());
+  TEST_ASSERT_EQUAL_UINT32(0, tx.drops());
+  TEST_ASSERT_EQUAL_UINT32(cdc.wire.size(), tx.bytesSent());
+  TEST_ASSERT_EQUAL_UINT32(0, tx.pending());
+
+  Receiver rx;
+  rx.feedChunked(cdc.wire);
+  TEST_ASSERT_EQUAL_UINT32(seq, rx.got.size());
+  for (uint32_t i = 0; i < seq; ++i) TEST_ASSERT_TRUE(sameSample(sampleFor(i), rx.got[i]));
+  TEST_ASSERT_EQUAL_UINT32(0, rx.dec.crcErrors());
+  TEST_ASSERT_EQUAL_UINT32(0, rx.dec.badFrames());
+  TEST_ASSERT_EQUAL_UINT32(0, rx.dec.lost());
+}
+
+// drain 은 호출당 묶음 하나 → 그 사이에만 텍스트가 끼면 샘플 프레임은 하나도 안 깨진다
+static void test_text_between_batches(void){
+  static TelemetryTx<512> tx;
+  CdcSim cdc;
+  const char* const TEXT = "[12.345s] RC signal present\n";
+  uint32_t seq = 0, texts = 0;
+  for (uint32_t ms = 0; ms < 3000; ++ms){
+    if (ms % 2 == 0){ const TelemetrySample s = sampleFor(seq++); tx.push(TELEM_SAMPLE, &s, sizeof(s)); }
+    const bool more = tx.drain([&](const uint8_t* p, size_t n){ return cdc.write(p, n); });
+    cdc.tick();
+    // taskLogDrain: 송신권은 묶음 사이에서만
+    if (!tx.sending() && (more || ms % 7 == 0)){
+      cdc.wire.insert(cdc.wire.end(), TEXT, TEXT + strlen(TEXT));
+      texts++;
+    }
+  }
+  while (tx.drain([&](const uint8_t* p, size_t n){ return cdc.write(p, n); })) cdc.tick();
+  TEST_ASSERT_GREATER_THAN(100, texts);
+
+  Receiver rx;
+  rx.feedChunked(cdc.wire);
+  TEST_ASSERT_EQUAL_UINT32(0, tx.drops());
+  TEST_ASSERT_EQUAL_UINT32(seq, rx.got.size());
+  TEST_ASSERT_EQUAL_UINT32(0, rx.dec.crcErrors());
+  TEST_ASSERT_EQUAL_UINT32(0, rx.dec.lost());
+  // 텍스트는 프레임이 아닌 쓰레기로만 보인다 (묶음마다 앞 구분자가 끊어 줌)
+  TEST_ASSERT_LESS_OR_EQUAL(texts, rx.dec.badFrames());
+}
+
+// 바이트 하나를 뒤집으면 그 프레임만 버려지고 다음 프레임부터 다시 받는다
+static void test_corruption_and_resync(void){
+  uint8_t frame[TELEM_MAX_FRAME];
+  std::vector<uint8_t> wire;
+  std::vector<size_t> starts;
+  const uint32_t N = 400;
+  for (uint32_t i = 0; i < N; ++i){
+    const TelemetrySample s = sampleFor(i);
+    const size_t len = telemEncodeFrame(TELEM_SAMPLE, &s, sizeof(s), frame);
+    TEST_ASSERT_TRUE(len > 0 && len <= TELEM_MAX_FRAME);
+    starts.push_back(wire.size());
+    wire.insert(wire.end(), frame, frame + len);
+  }
+
+  // 프레임 하나 건너 하나: 구분자가 아닌 바이트를 0 이 아닌 다른 값으로
+  uint32_t corrupted = 0;
+  for (uint32_t i = 1; i < N; i += 2){
+    const size_t len = (i + 1 < N ? starts[i + 1] : wire.size()) - starts[i] - 1;
+    uint8_t& b = wire[starts[i] + rnd() % len];
+    b = (uint8_t)(b ^ (1u << (rnd() % 8)));
+    if (!b) b = 0x5A;
+    corrupted++;
+  }
+
+  Receiver rx;
+  // 시작 전 쓰레기 + 끊긴 프레임, 그리고 묶음 앞 구분자 (TelemetryTx 와 같이)
+  const uint8_t junk[] = { 'x', 'y', 0x00, 0x42, 0x00 };
+  rx.feed(junk, sizeof(junk));
+  rx.feedChunked(wire);
+
+  TEST_ASSERT_EQUAL_UINT32(N - corrupted, rx.got.size());
+  TEST_ASSERT_EQUAL_UINT32(corrupted + 2, rx.dec.crcErrors() + rx.dec.badFrames());
+  TEST_ASSERT_GREATER_THAN(corrupted / 2, rx.dec.crcErrors());
+  for (size_t k = 0; k < rx.got.size(); ++k) TEST_ASSERT_TRUE(sameSample(sampleFor((uint32_t)(2 * k)), rx.got[k]));
+  // 마지막 프레임(399)은 뒤에 받은 것이 없어 빈 번호로 안 보인다
+  TEST_ASSERT_EQUAL_UINT32(corrupted - 1, rx.dec.lost());
+}
+
+// 소비자가 안 가져가면 두 버퍼가 차서 버림 → 송신 drops == 수신 lost
+static void test_drops_counted_as_lost(void){
+  static TelemetryTx<256> tx;
+  CdcSim cdc;
+  uint32_t seq = 0;
+  for (int burst = 0; burst < 5; ++burst){
+    for (int i = 0; i < 40; ++i){ const TelemetrySample s = sampleFor(seq++); tx.push(TELEM_SAMPLE, &s, sizeof(s)); }
+    while (tx.drain([&](const uint8_t* p, size_t n){ return cdc.write(p, n); })) cdc.tick();
+    cdc.tick();
+  }
+  TEST_ASSERT_GREATER_THAN(0, tx.drops());
+  TEST_ASSERT_EQUAL_UINT32(seq, tx.frames() + tx.drops());
+
+  Receiver rx;
+  rx.feedChunked(cdc.wire);
+  TEST_ASSERT_EQUAL_UINT32(tx.frames(), rx.got.size());
+  // 마지막 묶음 뒤에 버린 것은 수신 측이 알 수 없다
+  const uint32_t tail = seq - 1 - rx.got.back().seq;
+  TEST_ASSERT_EQUAL_UINT32(tx.drops(), rx.dec.lost() + tail);
+  TEST_ASSERT_EQUAL_UINT32(0, rx.dec.crcErrors());
+}
+
+int main(int, char**){
+  UNITY_BEGIN();
+  RUN_TEST(test_crc_and_cobs_round_trip);
+  RUN_TEST(test_cobs_rejects_malformed);
+  RUN_TEST(test_tx_decoder_round_trip);
+  RUN_TEST(test_text_between_batches);
+  RUN_TEST(test_corruption_and_resync);
+  RUN_TEST(test_drops_counted_as_lost);
+  return UNITY_END();
+}
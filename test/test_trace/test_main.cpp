@@ -0,0 +1,210 @@
+// ============================================================
+// 에지 트레이스 왕복 테스트 (TraceWriter → traceDecodeChunk)
+// ------------------------------------------------------------
+//  - 무작위 에지 열 (1µs ~ 수 초 간격, micros 순환 포함) 을 청크로 나눠 써도
+//    복호 결과가 시각 / 레벨 모두 같고, 헤더(seq / 시작 시각 / 보정값) 보존
+//  - hasRoom(1) 이면 add 는 실패하지 않고 데이터는 TRACE_CHUNK_DATA 를 넘지 않음
+//  - 2^31µs 넘는 공백은 잘림
+//  - "#T <hex>" 줄 → traceParseHexLine → 같은 청크
+//  - 깨진 청크(매직 / 길이 / 잘린 varint)는 false
+// ============================================================
+
+#include <unity.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "trace.h"
+
+static uint32_t gRng = 0x7ACEu;
+static uint32_t rnd(){
+  gRng ^= gRng << 13; gRng ^= gRng >> 17; gRng ^= gRng << 5;
+  return gRng;
+}
+
+void setUp(void){ gRng = 0x7ACEu; }
+void tearDown(void){}
+
+struct Edge { uint32_t tUs; bool high; };
+
+static const size_t EDGES = 20000;
+static Edge gIn[EDGES];
+static Edge gOut[EDGES];
+static size_t gOutCount;
+
+static void collect(uint32_t tUs, bool high){
+  if (gOutCount < EDGES) gOut[gOutCount++] = Edge{ tUs, high };
+}
+
+static bool decode(const TraceChunk& c, TraceChunkHeader& h){
+  return traceDecodeChunk(reinterpret_cast<const uint8_t*>(&c), c.wireSize(), h, collect);
+}
+
+static void test_round_trip_across_chunks(void){
+  // micros 순환 직전에서 시작
+  uint32_t t = 0xFFFFFFFFu - 5000000u;
+  for (size_t i = 0; i < EDGES; ++i){
+    const uint32_t r = rnd();
+    uint32_t dt;
+    if ((r & 7) == 0) dt = 1 + (r >> 8) % 60;            // 런트 / 글리치
+    else if ((r & 0x3F) == 9) dt = (r >> 8) % 5000000u;  // 수 초 공백
+    else dt = 800 + (r >> 8) % 19200;                    // RC 프레임 안
+    t += dt;
+    gIn[i] = Edge{ t, (i & 1) == 0 };
+  }
+
+  static TraceWriter w;
+  gOutCount = 0;
+  size_t i = 0;
+  uint32_t seq = 0, chunks = 0;
+  while (i < EDGES){
+    const uint16_t calMin = (uint16_t)(900 + seq), calMax = (uint16_t)(2100 - seq);
+    const uint32_t startUs = gIn[i].tUs;
+    w.begin(seq, startUs, calMin, calMax);
+    while (i < EDGES && w.hasRoom(1)){
+      TEST_ASSERT_TRUE(w.add(gIn[i].tUs, gIn[i].high));
+      i++;
+    }
+    TEST_ASSERT_FALSE(w.empty());
+    TEST_ASSERT_LESS_OR_EQUAL(TRACE_CHUNK_DATA, w.chunk().h.bytes);
+
+    TraceChunkHeader h;
+    TEST_ASSERT_TRUE(decode(w.chunk(), h));
+    TEST_ASSERT_EQUAL_UINT32(seq, h.seq);
+    TEST_ASSERT_EQUAL_UINT32(startUs, h.startUs);
+    TEST_ASSERT_EQUAL_UINT16(calMin, h.calMin);
+    TEST_ASSERT_EQUAL_UINT16(calMax, h.calMax);
+    seq++;
+    chunks++;
+  }
+  TEST_ASSERT_GREATER_THAN(50, chunks);
+
+  TEST_ASSERT_EQUAL_UINT32(EDGES, gOutCount);
+  for (size_t k = 0; k < EDGES; ++k){
+    if (gIn[k].tUs != gOut[k].tUs || gIn[k].high != gOut[k].high){
+      char msg[96];
+      snprintf(msg, sizeof(msg), "edge %u: wrote %u/%d, read %u/%d", (unsigned)k,
+               gIn[k].tUs, gIn[k].high, gOut[k].tUs, gOut[k].high);
+      TEST_FAIL_MESSAGE(msg);
+    }
+  }
+}
+
+static void test_full_chunk_refuses_add(void){
+  static TraceWriter w;
+  w.begin(0, 0, 1000, 2000);
+  uint32_t t = 0;
+  size_t n = 0;
+  // 최악 길이 varint (5바이트) 만 넣어도 hasRoom 이 지켜진다
+  while (w.hasRoom(1)){
+    t += 0x40000000u;
+    TEST_ASSERT_TRUE(w.add(t, true));
+    n++;
+  }
+  TEST_ASSERT_EQUAL_UINT32(TRACE_CHUNK_DATA / 5, n);
+  TEST_ASSERT_FALSE(w.add(t + 1, false));
+  TEST_ASSERT_EQUAL_UINT16(n * 5, w.chunk().h.bytes);
+}
+
+static void test_long_gap_is_clamped(void){
+  static TraceWriter w;
+  w.begin(3, 100, 1000, 2000);
+  TEST_ASSERT_TRUE(w.add(200, true));
+  TEST_ASSERT_TRUE(w.add(200 + 0x90000000u, false));   // 2^31µs (약 35분) 초과
+  TEST_ASSERT_TRUE(w.add(200 + 0x90000000u + 1500, true));
+
+  TraceChunkHeader h;
+  gOutCount = 0;
+  TEST_ASSERT_TRUE(decode(w.chunk(), h));
+  TEST_ASSERT_EQUAL_UINT32(3, gOutCount);
+  TEST_ASSERT_EQUAL_UINT32(200, gOut[0].tUs);
+  TEST_ASSERT_EQUAL_UINT32(200 + 0x7FFFFFFFu, gOut[1].tUs);
+  // 이후 델타는 실제 직전 시각 기준 → 간격은 그대로
+  TEST_ASSERT_EQUAL_UINT32(1500, gOut[2].tUs - gOut[1].tUs);
+}
+
+// traceFormatLine 과 같은 형식
+static size_t formatLine(const TraceChunk& c, char* out){
+  static const char HEX_DIGITS[] = "0123456789abcdef";
+  const uint8_t* p = reinterpret_cast<const uint8_t*>(&c);
+  size_t n = 0;
+  out[n++] = '#'; out[n++] = 'T'; out[n++] = ' ';
+  for (size_t i = 0; i < c.wireSize(); ++i){
+    out[n++] = HEX_DIGITS[p[i] >> 4];
+    out[n++] = HEX_DIGITS[p[i] & 0x0F];
+  }
+  out[n++] = '\n';
+  out[n] = 0;
+  return n;
+}
+
+static void test_hex_line_round_trip(void){
+  static TraceWriter w;
+  w.begin(7, 123456, 1010, 1990);
+  uint32_t t = 123456;
+  for (int i = 0; i < 40; ++i){
+    t += (i & 1) ? 18500 : 1500;
+    w.add(t, (i & 1) == 0);
+  }
+
+  static char line[3 + 2 * sizeof(TraceChunk) + 2];
+  formatLine(w.chunk(), line);
+  static uint8_t buf[sizeof(TraceChunk)];
+  const size_t n = traceParseHexLine(line, buf, sizeof(buf));
+  TEST_ASSERT_EQUAL_UINT32(w.chunk().wireSize(), n);
+  TEST_ASSERT_EQUAL_MEMORY(&w.chunk(), buf, n);
+
+  TraceChunkHeader h;
+  gOutCount = 0;
+  TEST_ASSERT_TRUE(traceDecodeChunk(buf, n, h, collect));
+  TEST_ASSERT_EQUAL_UINT32(40, gOutCount);
+  TEST_ASSERT_EQUAL_UINT32(t, gOut[39].tUs);
+  TEST_ASSERT_FALSE(gOut[39].high);
+
+  // 대문자 16진도 허용, 트레이스 줄이 아니면 0
+  for (char* p = line + 3; *p; ++p) if (*p >= 'a' && *p <= 'f') *p = (char)(*p - 'a' + 'A');
+  TEST_ASSERT_EQUAL_UINT32(n, traceParseHexLine(line, buf, sizeof(buf)));
+  TEST_ASSERT_EQUAL_UINT32(0, traceParseHexLine("[1.000s] RC signal present", buf, sizeof(buf)));
+  TEST_ASSERT_EQUAL_UINT32(2, traceParseHexLine("#T 52430x", buf, sizeof(buf)));
+}
+
+static void test_corrupt_chunks_rejected(void){
+  static TraceWriter w;
+  w.begin(1, 0, 1000, 2000);
+  w.add(100, true);
+  w.add(100 + 0x200000, false);   // 4바이트 varint
+  static TraceChunk c;
+  c = w.chunk();
+  const uint8_t* raw = reinterpret_cast<const uint8_t*>(&c);
+  TraceChunkHeader h;
+  gOutCount = 0;
+
+  TEST_ASSERT_TRUE(traceDecodeChunk(raw, c.wireSize(), h, collect));
+  TEST_ASSERT_FALSE(traceDecodeChunk(raw, sizeof(TraceChunkHeader) - 1, h, collect));
+  TEST_ASSERT_FALSE(traceDecodeChunk(raw, c.wireSize() - 1, h, collect));   // 데이터 잘림
+
+  static TraceChunk bad;
+  bad = c;
+  bad.h.magic ^= 1;
+  TEST_ASSERT_FALSE(traceDecodeChunk(reinterpret_cast<const uint8_t*>(&bad), bad.wireSize(), h, collect));
+  bad = c;
+  bad.h.version++;
+  TEST_ASSERT_FALSE(traceDecodeChunk(reinterpret_cast<const uint8_t*>(&bad), bad.wireSize(), h, collect));
+  bad = c;
+  bad.h.bytes = TRACE_CHUNK_DATA + 1;
+  TEST_ASSERT_FALSE(traceDecodeChunk(reinterpret_cast<const uint8_t*>(&bad), sizeof(bad), h, collect));
+
+  // 마지막 varint 가 계속 비트로 끝남 (청크 길이가 varint 중간에서 끊김)
+  bad = c;
+  bad.h.bytes--;
+  TEST_ASSERT_FALSE(traceDecodeChunk(reinterpret_cast<const uint8_t*>(&bad), bad.wireSize(), h, collect));
+}
+
+int main(int, char**){
+  UNITY_BEGIN();
+  RUN_TEST(test_round_trip_across_chunks);
+  RUN_TEST(test_full_chunk_refuses_add);
+  RUN_TEST(test_long_gap_is_clamped);
+  RUN_TEST(test_hex_line_round_trip);
+  RUN_TEST(test_corrupt_chunks_rejected);
+  return UNITY_END();
+}